@@ -20,6 +20,7 @@
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
+#include "ArduinoJson/Flash/FlashDeserializer.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
 #include "ArduinoJson/Array/ElementProxy.hpp"
@@ -30,19 +31,31 @@
 #include "ArduinoJson/Variant/VariantAsImpl.hpp"
 #include "ArduinoJson/Variant/VariantImpl.hpp"
 
+#include "ArduinoJson/Json/JsonCapacity.hpp"
 #include "ArduinoJson/Json/JsonDeserializer.hpp"
+#include "ArduinoJson/Json/JsonFeeder.hpp"
+#include "ArduinoJson/Json/JsonLinesReader.hpp"
+#include "ArduinoJson/Json/JsonLinesWriter.hpp"
 #include "ArduinoJson/Json/JsonSerializer.hpp"
+#include "ArduinoJson/Json/JsonSniffer.hpp"
+#include "ArduinoJson/Json/JsonStructDeserializer.hpp"
+#include "ArduinoJson/Json/JsonStructSerializer.hpp"
 #include "ArduinoJson/Json/PrettyJsonSerializer.hpp"
+#include "ArduinoJson/Json/PrettyJsonStructSerializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackDeserializer.hpp"
 #include "ArduinoJson/MsgPack/MsgPackSerializer.hpp"
+#include "ArduinoJson/MsgPack/MsgPackStructSerializer.hpp"
+#include "ArduinoJson/MsgPack/MsgPackWriter.hpp"
 
 #include "ArduinoJson/compatibility.hpp"
 
 namespace ArduinoJson {
 typedef ARDUINOJSON_NAMESPACE::ArrayConstRef JsonArrayConst;
 typedef ARDUINOJSON_NAMESPACE::ArrayRef JsonArray;
+typedef ARDUINOJSON_NAMESPACE::CapacityReport JsonCapacityReport;
 typedef ARDUINOJSON_NAMESPACE::Float JsonFloat;
 typedef ARDUINOJSON_NAMESPACE::Integer JsonInteger;
+typedef ARDUINOJSON_NAMESPACE::KeyLiteral JsonKey;
 typedef ARDUINOJSON_NAMESPACE::ObjectConstRef JsonObjectConst;
 typedef ARDUINOJSON_NAMESPACE::ObjectRef JsonObject;
 typedef ARDUINOJSON_NAMESPACE::Pair JsonPair;
@@ -57,13 +70,24 @@ using ARDUINOJSON_NAMESPACE::DeserializationError;
 using ARDUINOJSON_NAMESPACE::deserializeJson;
 using ARDUINOJSON_NAMESPACE::deserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::DynamicJsonDocument;
+using ARDUINOJSON_NAMESPACE::FlashDocument;
+using ARDUINOJSON_NAMESPACE::FlashVariant;
 using ARDUINOJSON_NAMESPACE::JsonDocument;
+using ARDUINOJSON_NAMESPACE::JsonFeeder;
+using ARDUINOJSON_NAMESPACE::JsonLinesReader;
+using ARDUINOJSON_NAMESPACE::JsonLinesWriter;
 using ARDUINOJSON_NAMESPACE::measureJson;
+using ARDUINOJSON_NAMESPACE::measureJsonCapacity;
+using ARDUINOJSON_NAMESPACE::measureMsgPack;
+using ARDUINOJSON_NAMESPACE::MsgPackWriter;
 using ARDUINOJSON_NAMESPACE::serialized;
 using ARDUINOJSON_NAMESPACE::serializeJson;
 using ARDUINOJSON_NAMESPACE::serializeJsonPretty;
 using ARDUINOJSON_NAMESPACE::serializeMsgPack;
+using ARDUINOJSON_NAMESPACE::sniffJson;
+using ARDUINOJSON_NAMESPACE::StaticFlashDocument;
 using ARDUINOJSON_NAMESPACE::StaticJsonDocument;
+using ARDUINOJSON_NAMESPACE::StaticJsonFeeder;
 
 namespace DeserializationOption {
 using ARDUINOJSON_NAMESPACE::Filter;
@@ -0,0 +1,212 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/StructBinding.hpp>
+#include <ArduinoJson/Numbers/Float.hpp>
+#include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Integer members are accessed with memcpy() because int32_t and long may be
+// distinct types of the same size.
+template <typename T>
+inline void fieldStore(void *field, T value) {
+  memcpy(field, &value, sizeof(T));
+}
+
+template <typename T>
+inline T fieldLoad(const void *field) {
+  T value;
+  memcpy(&value, field, sizeof(T));
+  return value;
+}
+
+template <typename TNumber>
+inline void fieldSetInteger(void *field, uint8_t type, const TNumber &num) {
+  bool isUnsigned = (type & FIELD_IS_UNSIGNED) != 0;
+  switch (type & FIELD_SIZE_MASK) {
+    case 1:
+      if (isUnsigned)
+        fieldStore(field, num.template as<uint8_t>());
+      else
+        fieldStore(field, num.template as<int8_t>());
+      break;
+    case 2:
+      if (isUnsigned)
+        fieldStore(field, num.template as<uint16_t>());
+      else
+        fieldStore(field, num.template as<int16_t>());
+      break;
+    case 4:
+      if (isUnsigned)
+        fieldStore(field, num.template as<uint32_t>());
+      else
+        fieldStore(field, num.template as<int32_t>());
+      break;
+    case 8:
+      if (isUnsigned)
+        fieldStore(field, num.template as<uint64_t>());
+      else
+        fieldStore(field, num.template as<int64_t>());
+      break;
+  }
+}
+
+template <typename T, typename TNumber>
+inline T convertParsedFloat(const TNumber &num) {
+  switch (num.type()) {
+    case VALUE_IS_NEGATIVE_INTEGER:
+      return -static_cast<T>(num.uintValue);
+    case VALUE_IS_POSITIVE_INTEGER:
+      return static_cast<T>(num.uintValue);
+    case VALUE_IS_FLOAT:
+      return static_cast<T>(num.floatValue);
+    default:
+      return 0;
+  }
+}
+
+// Stores a number in a scalar member, converting it like VariantRef::as<T>()
+// Returns false if the member cannot receive a number.
+template <typename TNumber>
+inline bool fieldSetNumber(void *field, uint8_t type, const TNumber &num) {
+  switch (type) {
+    case FIELD_IS_BOOLEAN:
+      fieldStore(field, convertParsedFloat<Float>(num) != 0);
+      return true;
+    case FIELD_IS_FLOAT:
+      fieldStore(field, convertParsedFloat<float>(num));
+      return true;
+    case FIELD_IS_DOUBLE:
+      fieldStore(field, convertParsedFloat<double>(num));
+      return true;
+    case FIELD_IS_STRING:
+    case FIELD_IS_STRUCT:
+      return false;
+    default:
+      fieldSetInteger(field, type, num);
+      return true;
+  }
+}
+
+inline bool fieldSetBoolean(void *field, uint8_t type, bool value) {
+  return fieldSetNumber(field, type, ParsedNumber<Float, UInt>(value, false));
+}
+
+inline size_t fieldGetCount(const void *field, uint8_t type) {
+  int64_t n;
+  switch (type & (FIELD_IS_UNSIGNED | FIELD_SIZE_MASK)) {
+    case 1:
+      n = fieldLoad<int8_t>(field);
+      break;
+    case 2:
+      n = fieldLoad<int16_t>(field);
+      break;
+    case 4:
+      n = fieldLoad<int32_t>(field);
+      break;
+    case 8:
+      n = fieldLoad<int64_t>(field);
+      break;
+    case FIELD_IS_UNSIGNED | 1:
+      return fieldLoad<uint8_t>(field);
+    case FIELD_IS_UNSIGNED | 2:
+      return fieldLoad<uint16_t>(field);
+    case FIELD_IS_UNSIGNED | 4:
+      return fieldLoad<uint32_t>(field);
+    default:
+      return size_t(fieldLoad<uint64_t>(field));
+  }
+  return n > 0 ? size_t(n) : 0;
+}
+
+// Stores the number of elements of an array, or the largest value of the
+// count member if it doesn't fit
+inline void fieldSetCount(void *field, uint8_t type, size_t count) {
+  uint8_t bits = uint8_t(8 * (type & FIELD_SIZE_MASK));
+  if (!(type & FIELD_IS_UNSIGNED))
+    bits--;
+  if (bits < 8 * sizeof(size_t) && (count >> bits) != 0)
+    count = (size_t(1) << bits) - 1;
+  fieldSetInteger(field, type, ParsedNumber<Float, UInt>(UInt(count), false));
+}
+
+// Number of elements to serialize from an array member
+inline size_t fieldArraySize(const FieldBinding &field, const void *object) {
+  if (!field.hasCount())
+    return field.capacity;
+  size_t n = fieldGetCount(
+      static_cast<const char *>(object) + field.countOffset, field.countType);
+  return n < field.capacity ? n : field.capacity;
+}
+
+// Calls the visitor method matching one element of a member.
+// Struct elements are forwarded to TVisitor::visitStruct().
+template <typename TVisitor>
+inline void fieldAccept(const FieldBinding &field, const void *value,
+                        TVisitor &visitor) {
+  switch (field.type) {
+    case FIELD_IS_BOOLEAN:
+      visitor.visitBoolean(fieldLoad<bool>(value));
+      return;
+    case FIELD_IS_FLOAT:
+      visitor.visitFloat(Float(fieldLoad<float>(value)));
+      return;
+    case FIELD_IS_DOUBLE:
+      visitor.visitFloat(Float(fieldLoad<double>(value)));
+      return;
+    case FIELD_IS_STRING:
+      visitor.visitString(static_cast<const char *>(value));
+      return;
+    case FIELD_IS_STRUCT:
+      visitor.visitStruct(field.nestedBinding(), value);
+      return;
+  }
+
+  if (field.type & FIELD_IS_UNSIGNED) {
+    uint64_t n;
+    switch (field.type & FIELD_SIZE_MASK) {
+      case 1:
+        n = fieldLoad<uint8_t>(value);
+        break;
+      case 2:
+        n = fieldLoad<uint16_t>(value);
+        break;
+      case 4:
+        n = fieldLoad<uint32_t>(value);
+        break;
+      default:
+        n = fieldLoad<uint64_t>(value);
+        break;
+    }
+    visitor.visitPositiveInteger(UInt(n));
+  } else {
+    int64_t n;
+    switch (field.type & FIELD_SIZE_MASK) {
+      case 1:
+        n = fieldLoad<int8_t>(value);
+        break;
+      case 2:
+        n = fieldLoad<int16_t>(value);
+        break;
+      case 4:
+        n = fieldLoad<int32_t>(value);
+        break;
+      default:
+        n = fieldLoad<int64_t>(value);
+        break;
+    }
+    if (n < 0)
+      visitor.visitNegativeInteger(UInt(~uint64_t(n) + 1));
+    else
+      visitor.visitPositiveInteger(UInt(n));
+  }
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,56 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Builds a string in a char array owned by the caller.
+// Characters that don't fit are counted but dropped.
+class FixedStringBuilder {
+ public:
+  FixedStringBuilder(char *buffer, size_t capacity)
+      : _buffer(buffer), _capacity(capacity), _size(0) {}
+
+  void append(char c) {
+    if (_size < _capacity)
+      _buffer[_size] = c;
+    _size++;
+  }
+
+  void append(const char *s, size_t n) {
+    if (_size < _capacity) {
+      size_t room = _capacity - _size;
+      memcpy(_buffer + _size, s, n < room ? n : room);
+    }
+    _size += n;
+  }
+
+  // Terminates the string; returns false if it was truncated
+  bool complete() {
+    if (_size < _capacity) {
+      _buffer[_size] = 0;
+      return true;
+    }
+    if (_capacity > 0)
+      _buffer[_capacity - 1] = 0;
+    return false;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  char *_buffer;
+  size_t _capacity;
+  size_t _size;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,238 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // offsetof
+#include <string.h>  // memcmp
+
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+enum {
+  FIELD_IS_BOOLEAN = 0x01,
+  FIELD_IS_FLOAT = 0x02,
+  FIELD_IS_DOUBLE = 0x03,
+  FIELD_IS_STRING = 0x04,
+  FIELD_IS_STRUCT = 0x05,
+
+  // integers are encoded as FIELD_IS_INTEGER | [FIELD_IS_UNSIGNED] | size
+  FIELD_IS_INTEGER = 0x10,
+  FIELD_IS_UNSIGNED = 0x20,
+  FIELD_SIZE_MASK = 0x0F
+};
+
+struct StructBinding;
+typedef const StructBinding &(*StructBindingGetter)();
+
+// Describes one member of a bound struct.
+// Array members are described by their element (type, size, nested) and the
+// number of elements they can hold (capacity).
+struct FieldBinding {
+  const char *name;
+  StructBindingGetter nested;  // only for FIELD_IS_STRUCT
+  uint16_t offset;
+  uint16_t size;        // size of one element, including the terminator
+  uint16_t capacity;    // number of elements, 0 if not an array
+  uint16_t countOffset;  // member receiving the length of the JSON array
+  uint8_t nameLength;
+  uint8_t type;
+  uint8_t countType;  // 0 if the array has no count member
+
+  bool isArray() const {
+    return capacity > 0;
+  }
+
+  bool hasCount() const {
+    return countType != 0;
+  }
+
+  bool matches(const char *key, size_t length) const {
+    return length == nameLength && memcmp(name, key, length) == 0;
+  }
+
+  const StructBinding &nestedBinding() const {
+    return nested();
+  }
+};
+
+struct StructBinding {
+  const FieldBinding *fields;
+  uint8_t count;
+
+  const FieldBinding *find(const char *key, size_t length) const {
+    for (uint8_t i = 0; i < count; i++) {
+      if (fields[i].matches(key, length))
+        return &fields[i];
+    }
+    return 0;
+  }
+};
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+// Found by ADL in the namespace of T (see JSON_BINDING)
+template <typename T>
+const StructBinding &structBindingOf() {
+  return jsonBindingOf(static_cast<const T *>(0));
+}
+
+template <typename T>
+struct IsBoundStruct {
+ protected:  // <- to avoid GCC's "all member functions in class are private"
+  typedef char Yes[1];
+  typedef char No[2];
+
+  template <typename U>
+  static Yes &probe(typename remove_reference<decltype(
+                        jsonBindingOf(static_cast<const U *>(0)))>::type *);
+  template <typename>
+  static No &probe(...);
+
+ public:
+  static const bool value = sizeof(probe<T>(0)) == sizeof(Yes);
+};
+
+template <typename T, typename Enable = void>
+struct FieldTraits;  // no definition: this member type cannot be bound
+
+template <typename T>
+struct FieldTraits<T, typename enable_if<is_integral<T>::value>::type> {
+  static constexpr uint8_t type() {
+    return uint8_t(FIELD_IS_INTEGER |
+                   (is_signed<T>::value ? 0 : FIELD_IS_UNSIGNED) | sizeof(T));
+  }
+  static constexpr size_t capacity() {
+    return 0;
+  }
+  static constexpr size_t size() {
+    return sizeof(T);
+  }
+  static constexpr StructBindingGetter nested() {
+    return 0;
+  }
+};
+
+template <typename T, uint8_t TYPE>
+struct ScalarFieldTraits {
+  static constexpr uint8_t type() {
+    return TYPE;
+  }
+  static constexpr size_t capacity() {
+    return 0;
+  }
+  static constexpr size_t size() {
+    return sizeof(T);
+  }
+  static constexpr StructBindingGetter nested() {
+    return 0;
+  }
+};
+
+template <>
+struct FieldTraits<bool> : ScalarFieldTraits<bool, FIELD_IS_BOOLEAN> {};
+
+template <>
+struct FieldTraits<float> : ScalarFieldTraits<float, FIELD_IS_FLOAT> {};
+
+template <>
+struct FieldTraits<double> : ScalarFieldTraits<double, FIELD_IS_DOUBLE> {};
+
+template <size_t N>
+struct FieldTraits<char[N]> : ScalarFieldTraits<char[N], FIELD_IS_STRING> {};
+
+template <typename T>
+struct FieldTraits<T, typename enable_if<is_class<T>::value>::type>
+    : ScalarFieldTraits<T, FIELD_IS_STRUCT> {
+  static constexpr StructBindingGetter nested() {
+    return &structBindingOf<T>;
+  }
+};
+
+template <typename T, size_t N>
+struct FieldTraits<T[N]> {
+  static constexpr uint8_t type() {
+    return FieldTraits<T>::type();
+  }
+  static constexpr size_t capacity() {
+    return N;
+  }
+  static constexpr size_t size() {
+    return sizeof(T);
+  }
+  static constexpr StructBindingGetter nested() {
+    return FieldTraits<T>::nested();
+  }
+};
+
+template <typename TMember>
+constexpr FieldBinding makeFieldBinding(const char *name, size_t nameLength,
+                                        size_t offset) {
+  static_assert(FieldTraits<TMember>::capacity() <= 0xFFFF &&
+                    FieldTraits<TMember>::size() <= 0xFFFF,
+                "member is too large to be bound");
+  return FieldBinding{name,
+                      FieldTraits<TMember>::nested(),
+                      uint16_t(offset),
+                      uint16_t(FieldTraits<TMember>::size()),
+                      uint16_t(FieldTraits<TMember>::capacity()),
+                      0,
+                      uint8_t(nameLength),
+                      FieldTraits<TMember>::type(),
+                      0};
+}
+
+template <typename TMember, typename TCount>
+constexpr FieldBinding makeFieldBinding(const char *name, size_t nameLength,
+                                        size_t offset, size_t countOffset) {
+  static_assert(FieldTraits<TMember>::capacity() > 0,
+                "only array members can have a count");
+  static_assert(is_integral<TCount>::value, "the count must be an integer");
+  return FieldBinding{name,
+                      FieldTraits<TMember>::nested(),
+                      uint16_t(offset),
+                      uint16_t(FieldTraits<TMember>::size()),
+                      uint16_t(FieldTraits<TMember>::capacity()),
+                      uint16_t(countOffset),
+                      uint8_t(nameLength),
+                      FieldTraits<TMember>::type(),
+                      FieldTraits<TCount>::type()};
+}
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+// Binds a member to the key of the same name
+#define JSON_FIELD(TStruct, member) JSON_FIELD_AS(TStruct, member, #member)
+
+// Binds a member to an arbitrary key
+#define JSON_FIELD_AS(TStruct, member, key)                     \
+  ARDUINOJSON_NAMESPACE::makeFieldBinding<decltype(TStruct::member)>( \
+      key, sizeof(key) - 1, offsetof(TStruct, member))
+
+// Binds an array member and the member that receives its number of elements.
+// The count is the length of the JSON array, which may exceed the capacity.
+#define JSON_ARRAY_FIELD(TStruct, member, count)                          \
+  ARDUINOJSON_NAMESPACE::makeFieldBinding<decltype(TStruct::member),      \
+                                          decltype(TStruct::count)>(      \
+      #member, sizeof(#member) - 1, offsetof(TStruct, member),            \
+      offsetof(TStruct, count))
+
+// Declares the fields of a struct; must appear in the struct's namespace.
+// JSON_BINDING(Wind, JSON_FIELD(Wind, speed), JSON_FIELD(Wind, deg))
+#define JSON_BINDING(TStruct, ...)                                           \
+  inline const ARDUINOJSON_NAMESPACE::StructBinding &jsonBindingOf(          \
+      const TStruct *) {                                                     \
+    static constexpr ARDUINOJSON_NAMESPACE::FieldBinding fields[] = {        \
+        __VA_ARGS__};                                                        \
+    static constexpr ARDUINOJSON_NAMESPACE::StructBinding binding = {        \
+        fields, sizeof(fields) / sizeof(fields[0])};                         \
+    return binding;                                                          \
+  }
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
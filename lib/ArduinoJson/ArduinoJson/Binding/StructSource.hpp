@@ -0,0 +1,30 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/StructBinding.hpp>
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Lets serialize() and measure() visit a bound struct
+template <typename TStruct>
+class StructSource {
+ public:
+  explicit StructSource(const TStruct &object) : _object(&object) {}
+
+  template <typename TVisitor>
+  void accept(TVisitor &visitor) const {
+    visitor.visitStruct(structBindingOf<TStruct>(), _object);
+  }
+
+ private:
+  const TStruct *_object;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Variant/SlotPointer.hpp>
 
 #include <stddef.h>  // size_t
 
@@ -15,9 +16,15 @@ class MemoryPool;
 class VariantData;
 class VariantSlot;
 
+// The slots form a linked list, in which each slot links to the next one.
+// The collection is "packed" when the slots are contiguous, that is when the
+// slot at index i is at _head - i. Packed collections are indexed and counted
+// in O(1).
+// Since the collection must remain a POD of two pointers, this state is
+// stored in the flags of the enclosing VariantData.
 class CollectionData {
-  VariantSlot *_head;
-  VariantSlot *_tail;
+  SlotPointer<VariantSlot> _head;
+  SlotPointer<VariantSlot> _tail;
 
  public:
   // Must be a POD!
@@ -69,15 +76,32 @@ class CollectionData {
   VariantSlot *addSlot(MemoryPool *);
   void removeSlot(VariantSlot *slot);
 
+  // Updates _head and _tail after a slot moved; the caller updates the
+  // previous slot
+  void slotMoved(VariantSlot *from, VariantSlot *to);
+
   bool copyFrom(const CollectionData &src, MemoryPool *pool);
 
   VariantSlot *head() const {
-    return _head;
+    return _head.get();
   }
 
-  void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance);
+  // This collection moved by selfDistance, the strings by stringDistance, and
+  // the slots by variantDistance
+  void movePointers(ptrdiff_t selfDistance, ptrdiff_t stringDistance,
+                    ptrdiff_t variantDistance);
+
+  bool isPacked() const;
+
+  // Makes the slots contiguous.
+  // CAUTION: only valid for the collection that was allocated last, i.e. all
+  // the slots between the pool's last variant and _head must belong to it or
+  // to its descendants. Requires one free slot per element, as a scratch area.
+  bool pack(MemoryPool *pool);
 
  private:
+  void setFragmented();
+
   VariantSlot *getSlot(size_t index) const;
 
   template <typename TAdaptedString>
@@ -14,13 +14,15 @@ inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
   if (!slot)
     return 0;
 
-  if (_tail) {
-    _tail->setNextNotNull(slot);
-    _tail = slot;
+  VariantSlot* tail = _tail.get();
+  if (tail) {
+    if (slot != tail - 1)
+      setFragmented();
+    tail->setNextNotNull(slot);
   } else {
-    _head = slot;
-    _tail = slot;
+    _head.set(slot);
   }
+  _tail.set(slot);
 
   slot->clear();
   return slot;
@@ -42,8 +44,8 @@ inline VariantData* CollectionData::addMember(TAdaptedString key,
 }
 
 inline void CollectionData::clear() {
-  _head = 0;
-  _tail = 0;
+  _head.set(0);
+  _tail.set(0);
 }
 
 template <typename TAdaptedString>
@@ -54,7 +56,7 @@ inline bool CollectionData::containsKey(const TAdaptedString& key) const {
 inline bool CollectionData::copyFrom(const CollectionData& src,
                                      MemoryPool* pool) {
   clear();
-  for (VariantSlot* s = src._head; s; s = s->next()) {
+  for (VariantSlot* s = src.head(); s; s = s->next()) {
     VariantData* var;
     if (s->key() != 0) {
       if (s->ownsKey())
@@ -74,7 +76,7 @@ inline bool CollectionData::copyFrom(const CollectionData& src,
 
 inline bool CollectionData::equalsObject(const CollectionData& other) const {
   size_t count = 0;
-  for (VariantSlot* slot = _head; slot; slot = slot->next()) {
+  for (VariantSlot* slot = head(); slot; slot = slot->next()) {
     VariantData* v1 = slot->data();
     VariantData* v2 = other.getMember(adaptString(slot->key()));
     if (!variantEquals(v1, v2))
@@ -85,8 +87,8 @@ inline bool CollectionData::equalsObject(const CollectionData& other) const {
 }
 
 inline bool CollectionData::equalsArray(const CollectionData& other) const {
-  VariantSlot* s1 = _head;
-  VariantSlot* s2 = other._head;
+  VariantSlot* s1 = head();
+  VariantSlot* s2 = other.head();
   for (;;) {
     if (s1 == s2)
       return true;
@@ -101,21 +103,38 @@ inline bool CollectionData::equalsArray(const CollectionData& other) const {
 
 template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
-  VariantSlot* slot = _head;
+  VariantSlot* slot = head();
+#if ARDUINOJSON_HASH_KEYS
+  KeyHash hash = key.hash();
+  while (slot) {
+    // most of the other keys have another hash
+    if (slot->keyHash() == hash && key.equals(slot->key()))
+      break;
+    slot = slot->next();
+  }
+#else
   while (slot) {
     if (key.equals(slot->key()))
       break;
     slot = slot->next();
   }
+#endif
   return slot;
 }
 
 inline VariantSlot* CollectionData::getSlot(size_t index) const {
-  return _head->next(index);
+  VariantSlot* head = _head.get();
+  if (!head)
+    return 0;
+  if (isPacked())
+    return index <= size_t(head - _tail.get()) ? head - index : 0;
+  return head->next(index);
 }
 
 inline VariantSlot* CollectionData::getPreviousSlot(VariantSlot* target) const {
-  VariantSlot* current = _head;
+  if (isPacked())
+    return target != head() ? target + 1 : 0;
+  VariantSlot* current = head();
   while (current) {
     VariantSlot* next = current->next();
     if (next == target)
@@ -153,10 +172,18 @@ inline VariantData* CollectionData::getElement(size_t index) const {
 
 inline VariantData* CollectionData::getOrAddElement(size_t index,
                                                     MemoryPool* pool) {
-  VariantSlot* slot = _head;
-  while (slot && index > 0) {
-    slot = slot->next();
-    index--;
+  VariantSlot* slot = head();
+  if (isPacked()) {
+    size_t count = slot ? size_t(slot - _tail.get()) + 1 : 0;
+    if (index < count)
+      return (slot - index)->data();
+    index -= count;
+    slot = 0;
+  } else {
+    while (slot && index > 0) {
+      slot = slot->next();
+      index--;
+    }
   }
   if (!slot)
     index++;
@@ -170,14 +197,23 @@ inline VariantData* CollectionData::getOrAddElement(size_t index,
 inline void CollectionData::removeSlot(VariantSlot* slot) {
   if (!slot)
     return;
+  if (slot != head() && slot != _tail.get())
+    setFragmented();
   VariantSlot* prev = getPreviousSlot(slot);
   VariantSlot* next = slot->next();
   if (prev)
     prev->setNext(next);
   else
-    _head = next;
+    _head.set(next);
   if (!next)
-    _tail = prev;
+    _tail.set(prev);
+}
+
+inline void CollectionData::slotMoved(VariantSlot* from, VariantSlot* to) {
+  if (_head.get() == from)
+    _head.set(to);
+  if (_tail.get() == from)
+    _tail.set(to);
 }
 
 inline void CollectionData::removeElement(size_t index) {
@@ -186,7 +222,7 @@ inline void CollectionData::removeElement(size_t index) {
 
 inline size_t CollectionData::memoryUsage() const {
   size_t total = 0;
-  for (VariantSlot* s = _head; s; s = s->next()) {
+  for (VariantSlot* s = head(); s; s = s->next()) {
     total += sizeof(VariantSlot) + s->data()->memoryUsage();
     if (s->ownsKey())
       total += strlen(s->key()) + 1;
@@ -196,7 +232,7 @@ inline size_t CollectionData::memoryUsage() const {
 
 inline size_t CollectionData::nesting() const {
   size_t maxChildNesting = 0;
-  for (VariantSlot* s = _head; s; s = s->next()) {
+  for (VariantSlot* s = head(); s; s = s->next()) {
     size_t childNesting = s->data()->nesting();
     if (childNesting > maxChildNesting)
       maxChildNesting = childNesting;
@@ -205,24 +241,79 @@ inline size_t CollectionData::nesting() const {
 }
 
 inline size_t CollectionData::size() const {
-  return slotSize(_head);
+  VariantSlot* head = _head.get();
+  if (head && isPacked())
+    return size_t(head - _tail.get()) + 1;
+  return slotSize(head);
 }
 
-template <typename T>
-inline void movePointer(T*& p, ptrdiff_t offset) {
-  if (!p)
-    return;
-  p = reinterpret_cast<T*>(
-      reinterpret_cast<void*>(reinterpret_cast<char*>(p) + offset));
-  ARDUINOJSON_ASSERT(isAligned(p));
+inline void CollectionData::movePointers(ptrdiff_t selfDistance,
+                                         ptrdiff_t stringDistance,
+                                         ptrdiff_t variantDistance) {
+  _head.move(selfDistance, variantDistance);
+  _tail.move(selfDistance, variantDistance);
+  for (VariantSlot* slot = head(); slot; slot = slot->next())
+    slot->movePointers(variantDistance, stringDistance, variantDistance);
 }
 
-inline void CollectionData::movePointers(ptrdiff_t stringDistance,
-                                         ptrdiff_t variantDistance) {
-  movePointer(_head, variantDistance);
-  movePointer(_tail, variantDistance);
-  for (VariantSlot* slot = _head; slot; slot = slot->next())
-    slot->movePointers(stringDistance, variantDistance);
+inline bool CollectionData::isPacked() const {
+  return !reinterpret_cast<const VariantData*>(this)->isFragmented();
+}
+
+inline void CollectionData::setFragmented() {
+  reinterpret_cast<VariantData*>(this)->setFragmented(true);
+}
+
+// Before:  e0 [S0] e1 [S1] e2 [S2]  (S = slots of the element's descendants)
+// After:   e0 e1 e2 [S0] [S1] [S2]
+// Each block S moves as a whole, so only the pointers to it need updating.
+inline bool CollectionData::pack(MemoryPool* pool) {
+  if (isPacked())
+    return true;
+
+  VariantSlot* head = _head.get();
+  ARDUINOJSON_ASSERT(pool->lastVariant() <= _tail.get());
+
+  size_t count = 0;
+  for (VariantSlot* s = head; s; s = s->next()) count++;
+
+  VariantSlot* elements = pool->scratchVariants(count);
+  if (!elements)
+    return false;
+
+  // 1. Save the elements; their _next tells the size of the following block
+  size_t i = 0;
+  for (VariantSlot* s = head; s; s = s->next()) elements[i++] = *s;
+
+  // 2. Move the blocks down, starting from the bottom one, which stays put
+  VariantSlot* blockEnd = pool->lastVariant();
+  VariantSlot* element = _tail.get();
+  for (i = count; i-- > 0;) {
+    size_t blockSize = size_t(element - blockEnd);
+    size_t shift = count - 1 - i;
+    memmove(blockEnd - shift, blockEnd, blockSize * sizeof(VariantSlot));
+    blockEnd = element + 1;
+    if (i > 0)
+      element -= elements[i - 1].nextDistance();
+  }
+
+  // 3. Put the elements on top, and update their pointers
+  element = head;
+  for (i = 0; i < count; i++) {
+    VariantSlot* slot = head - i;
+    *slot = elements[i];
+    slot->setNext(i + 1 < count ? slot - 1 : 0);
+    ptrdiff_t shift = ptrdiff_t(count - 1 - i);
+    ptrdiff_t distance = (slot - element) * ptrdiff_t(sizeof(VariantSlot));
+    if (shift || distance)
+      slot->movePointers(distance, 0,
+                         -shift * ptrdiff_t(sizeof(VariantSlot)));
+    element += elements[i].nextDistance();
+  }
+  _tail.set(head - (count - 1));
+
+  reinterpret_cast<VariantData*>(this)->setFragmented(false);
+  return true;
 }
 
 }  // namespace ARDUINOJSON_NAMESPACE
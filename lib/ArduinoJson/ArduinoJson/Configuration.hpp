@@ -8,10 +8,12 @@
 #define ARDUINOJSON_HAS_LONG_LONG 1
 #define ARDUINOJSON_HAS_NULLPTR 1
 #define ARDUINOJSON_HAS_RVALUE_REFERENCES 1
+#define ARDUINOJSON_HAS_CONSTEXPR 1
 #else
 #define ARDUINOJSON_HAS_LONG_LONG 0
 #define ARDUINOJSON_HAS_NULLPTR 0
 #define ARDUINOJSON_HAS_RVALUE_REFERENCES 0
+#define ARDUINOJSON_HAS_CONSTEXPR 0
 #endif
 
 #if defined(_MSC_VER) && !ARDUINOJSON_HAS_LONG_LONG
@@ -167,6 +169,12 @@
 #define ARDUINOJSON_DECODE_UNICODE 0
 #endif
 
+// Reject the strings that are not valid UTF-8 with
+// DeserializationError::InvalidUtf8
+#ifndef ARDUINOJSON_VALIDATE_UTF8
+#define ARDUINOJSON_VALIDATE_UTF8 0
+#endif
+
 // Ignore comments in input
 #ifndef ARDUINOJSON_ENABLE_COMMENTS
 #define ARDUINOJSON_ENABLE_COMMENTS 0
@@ -211,6 +219,60 @@
 #endif
 #endif
 
+// Escape and unescape the strings with lookup tables (224 bytes of flash)
+// instead of scanning the list of escape sequences
+#ifndef ARDUINOJSON_ESCAPE_TABLES
+#if defined(__AVR)
+#define ARDUINOJSON_ESCAPE_TABLES 0
+#else
+#define ARDUINOJSON_ESCAPE_TABLES 1
+#endif
+#endif
+
+// Make the slots of deserialized arrays and objects contiguous, so that they
+// can be indexed in O(1)
+#ifndef ARDUINOJSON_PACK_COLLECTIONS
+#define ARDUINOJSON_PACK_COLLECTIONS 1
+#endif
+
+// Store the pointers of the variants as 16-bit (32-bit on computers) offsets,
+// which shrinks the slots from 16 to 12 bytes on ESP8266, and from 32 to 16
+// bytes on computers. In this mode, all strings are copied in the pool, and
+// the capacity of a pool is limited to 32KB on MCUs.
+#ifndef ARDUINOJSON_COMPACT_SLOTS
+#define ARDUINOJSON_COMPACT_SLOTS 0
+#endif
+
+// Store an 8-bit hash of the key in each slot, so that the lookups skip most
+// of the keys that don't match without comparing them. On 16- and 32-bit
+// MCUs, the hash takes the padding after the flags, so the slots keep their
+// size; on 8-bit MCUs, they take one more byte.
+#ifndef ARDUINOJSON_HASH_KEYS
+#define ARDUINOJSON_HASH_KEYS 0
+#endif
+
+// Deserialize the nested arrays and objects of JSON documents in a loop,
+// with a stack of ARDUINOJSON_DEFAULT_NESTING_LIMIT frames (up to 12 bytes
+// each on ESP8266), so that the call stack doesn't grow with the nesting.
+// A larger NestingLimit takes one more such stack every
+// ARDUINOJSON_DEFAULT_NESTING_LIMIT levels.
+#ifndef ARDUINOJSON_ITERATIVE_DESERIALIZER
+#define ARDUINOJSON_ITERATIVE_DESERIALIZER 0
+#endif
+
+// Write the shortest decimal that reads back as the same float, with Grisu2
+// (checked with decimalToFloat() near the boundaries, where Grisu2 can miss
+// it), instead of rounding to 9 decimal places (6 for floats)
+#ifndef ARDUINOJSON_SHORTEST_FLOATS
+#define ARDUINOJSON_SHORTEST_FLOATS 0
+#endif
+
+// Parse the floats to the nearest value, with integer arithmetic, instead of
+// multiplying the mantissa by powers of ten, which can be a few bits off
+#ifndef ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS
+#define ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS 1
+#endif
+
 #ifndef ARDUINOJSON_TAB
 #define ARDUINOJSON_TAB "  "
 #endif
@@ -219,6 +281,25 @@
 #define ARDUINOJSON_STRING_BUFFER_SIZE 32
 #endif
 
+// Size of the stack buffer that gathers the bytes written to an std::ostream,
+// or to a buffered Print, so that serializeJson() calls write() once per block
+#ifndef ARDUINOJSON_WRITE_BUFFER_SIZE
+#define ARDUINOJSON_WRITE_BUFFER_SIZE 64
+#endif
+
+// Buffers the bytes written to every Print. It only pays off when write() has
+// a cost per call, like a WiFiClient; when it doesn't, the copy makes
+// serializeJson() slower. To buffer one class only, specialize
+// IsBufferedDestination for it instead.
+#ifndef ARDUINOJSON_BUFFER_PRINT
+#define ARDUINOJSON_BUFFER_PRINT 0
+#endif
+
+// Longest key that can be matched against the fields of a bound struct
+#ifndef ARDUINOJSON_BINDING_KEY_SIZE
+#define ARDUINOJSON_BINDING_KEY_SIZE 32
+#endif
+
 #ifndef ARDUINOJSON_DEBUG
 #ifdef __PLATFORMIO_BUILD_DEBUG__
 #define ARDUINOJSON_DEBUG 1
@@ -24,7 +24,8 @@ class DeserializationError {
     InvalidInput,
     NoMemory,
     NotSupported,
-    TooDeep
+    TooDeep,
+    InvalidUtf8
   };
 
   DeserializationError() {}
@@ -90,6 +91,8 @@ class DeserializationError {
         return "IncompleteInput";
       case NotSupported:
         return "NotSupported";
+      case InvalidUtf8:
+        return "InvalidUtf8";
       default:
         return "???";
     }
@@ -10,6 +10,8 @@ namespace ARDUINOJSON_NAMESPACE {
 
 class Filter {
  public:
+  // A filter that allows nothing
+  Filter() {}
   explicit Filter(VariantConstRef v) : _variant(v) {}
 
   bool allow() const {
@@ -14,4 +14,12 @@ struct Reader<TSource,
       : BoundedReader<const char*>(s.c_str(), s.length()) {}
 };
 
+// The string is in RAM too
+template <typename TSource>
+struct IsRamReader<
+    Reader<TSource,
+           typename enable_if<is_base_of< ::String, TSource>::value>::type> > {
+  static const bool value = true;
+};
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -8,6 +8,7 @@ namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TIterator>
 class IteratorReader {
+ protected:
   TIterator _ptr, _end;
 
  public:
@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/type_traits.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename T>
@@ -18,6 +20,25 @@ struct IsCharOrVoid {
 template <typename T>
 struct IsCharOrVoid<const T> : IsCharOrVoid<T> {};
 
+// Skips the ASCII characters other than the quote, the backslash, and NUL,
+// a word at a time
+inline const char* skipPlainChars(const char* p, const char* end, char quote) {
+  const size_t ones = size_t(-1) / 0xFF;
+  const size_t quotes = ones * static_cast<unsigned char>(quote);
+  const size_t backslashes = ones * '\\';
+  while (size_t(end - p) >= sizeof(size_t)) {
+    size_t word;
+    memcpy(&word, p, sizeof(word));
+    // if all bytes are ASCII, a subtraction borrows only from a zero byte
+    size_t q = word ^ quotes;
+    size_t b = word ^ backslashes;
+    if ((word | (word - ones) | (q - ones) | (b - ones)) & (ones * 0x80))
+      break;
+    p += sizeof(word);
+  }
+  return p;
+}
+
 template <typename TSource>
 struct Reader<TSource*,
               typename enable_if<IsCharOrVoid<TSource>::value>::type> {
@@ -35,6 +56,26 @@ struct Reader<TSource*,
     for (size_t i = 0; i < length; i++) buffer[i] = *_ptr++;
     return length;
   }
+
+  // Skips the next n bytes and returns their address
+  const char* readSpan(size_t n) {
+    const char* span = _ptr;
+    _ptr += n;
+    return span;
+  }
+
+  // Skips the bytes up to the next quote, backslash, or NUL, or up to the
+  // first one the validator rejects, and returns their address
+  template <typename TValidator>
+  const char* readStringRun(char quote, TValidator& validator, size_t& n) {
+    const char* run = _ptr;
+    TValidator v = validator;  // in registers
+    while (*_ptr != quote && *_ptr != '\\' && *_ptr != '\0' && v.append(*_ptr))
+      _ptr++;
+    validator = v;
+    n = size_t(_ptr - run);
+    return run;
+  }
 };
 
 template <typename TSource>
@@ -45,6 +86,55 @@ struct BoundedReader<TSource*,
   explicit BoundedReader(const void* ptr, size_t len)
       : IteratorReader<const char*>(reinterpret_cast<const char*>(ptr),
                                     reinterpret_cast<const char*>(ptr) + len) {}
+
+  // Skips the next n bytes and returns their address, or null if the input
+  // is shorter
+  const char* readSpan(size_t n) {
+    if (n > size_t(_end - _ptr))
+      return 0;
+    const char* span = _ptr;
+    _ptr += n;
+    return span;
+  }
+
+  // Skips the bytes up to the next quote, backslash, NUL, or the end of the
+  // input, or up to the first one the validator rejects, and returns their
+  // address
+  template <typename TValidator>
+  const char* readStringRun(char quote, TValidator& validator, size_t& n) {
+    const char* run = _ptr;
+    TValidator v = validator;  // in registers
+    for (;;) {
+      if (v.complete())
+        _ptr = skipPlainChars(_ptr, _end, quote);
+      // then a word, one byte at a time
+      const char* limit =
+          size_t(_end - _ptr) > sizeof(size_t) ? _ptr + sizeof(size_t) : _end;
+      while (_ptr < limit && *_ptr != quote && *_ptr != '\\' && *_ptr != '\0' &&
+             v.append(*_ptr))
+        _ptr++;
+      if (_ptr < limit || _ptr == _end)
+        break;
+    }
+    validator = v;
+    n = size_t(_ptr - run);
+    return run;
+  }
+};
+
+// The readers of a buffer in RAM can skip bytes with readSpan() and
+// readStringRun()
+template <typename TReader>
+struct IsRamReader : false_type {};
+
+template <typename TSource>
+struct IsRamReader<Reader<TSource*, void> > {
+  static const bool value = IsCharOrVoid<TSource>::value;
+};
+
+template <typename TSource>
+struct IsRamReader<BoundedReader<TSource*, void> > {
+  static const bool value = IsCharOrVoid<TSource>::value;
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -14,8 +14,14 @@ struct Reader<TSource, typename enable_if<
  public:
   explicit Reader(std::istream& stream) : _stream(&stream) {}
 
+  // Reads the stream buffer, as the sentry of get() costs more than the
+  // character
   int read() {
-    return _stream->get();
+    std::streambuf* buffer = _stream->rdbuf();
+    int c = buffer ? buffer->sbumpc() : std::char_traits<char>::eof();
+    if (c == std::char_traits<char>::eof())
+      _stream->setstate(std::ios::eofbit | std::ios::failbit);  // like get()
+    return c;
   }
 
   size_t readBytes(char* buffer, size_t length) {
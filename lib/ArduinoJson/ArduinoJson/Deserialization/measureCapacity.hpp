@@ -0,0 +1,89 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Document/DynamicJsonDocument.hpp>
+#include <ArduinoJson/StringStorage/StringCopier.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Memory needed to deserialize an input in a JsonDocument
+struct CapacityReport {
+  DeserializationError error;
+  size_t variants;   // number of variant slots
+  size_t strings;    // bytes taken by the strings
+  size_t padding;    // bytes lost to the alignment of the variants
+  size_t transient;  // bytes needed during the parsing only (skipped keys)
+
+  // Gets the smallest capacity that deserializes the input
+  size_t capacity() const {
+    return variants * sizeof(VariantSlot) + strings + padding + transient;
+  }
+};
+
+// Deserializes a copy of the strings, so that the input can be parsed again
+template <template <typename, typename> class TDeserializer, typename TString,
+          typename TFilter>
+DeserializationError deserializeCopy(JsonDocument &doc, const TString &input,
+                                     NestingLimit nestingLimit,
+                                     TFilter filter) {
+  Reader<TString> reader(input);
+  doc.clear();
+  return makeDeserializer<TDeserializer>(doc.memoryPool(), reader,
+                                         StringCopier(&doc.memoryPool()))
+      .parse(doc.data(), filter, nestingLimit);
+}
+
+// Deserializes the input once in a large document to measure the variants and
+// the strings, then searches the smallest capacity that works, which is larger
+// when a key is dropped by the filter after the last allocation.
+// CAUTION: allocates several documents on the heap; meant for computers.
+template <template <typename, typename> class TDeserializer, typename TString,
+          typename TFilter>
+CapacityReport measureCapacity(const TString &input, NestingLimit nestingLimit,
+                               TFilter filter) {
+  CapacityReport report = CapacityReport();
+
+  size_t capacity = 1024;
+  for (;;) {
+    DynamicJsonDocument doc(capacity);
+    if (doc.capacity() < capacity) {
+      report.error = DeserializationError::NoMemory;
+      return report;
+    }
+    report.error =
+        deserializeCopy<TDeserializer>(doc, input, nestingLimit, filter);
+    if (report.error != DeserializationError::NoMemory) {
+      const MemoryPool &pool = doc.memoryPool();
+      report.variants = pool.variantsSize() / sizeof(VariantSlot);
+      report.strings = pool.stringsSize();
+      break;
+    }
+    capacity *= 2;
+  }
+  if (report.error)
+    return report;
+
+  report.padding = addPadding(report.strings) - report.strings;
+
+  // find the smallest capacity that works, between the final usage and the
+  // capacity of the first document that worked
+  size_t step = addPadding(1);
+  size_t low = report.capacity();
+  size_t high = capacity;
+  while (low < high) {
+    size_t middle = low + (high - low) / (2 * step) * step;
+    DynamicJsonDocument doc(middle);
+    if (deserializeCopy<TDeserializer>(doc, input, nestingLimit, filter))
+      low = middle + step;
+    else
+      high = middle;
+  }
+  report.transient = low - report.capacity();
+  return report;
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
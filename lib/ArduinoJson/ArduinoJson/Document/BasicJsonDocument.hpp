@@ -109,22 +109,27 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
       return;
 
     void* old_ptr = _pool.buffer();
-    void* new_ptr = this->reallocate(old_ptr, _pool.capacity());
+    void* new_ptr = this->reallocate(
+        old_ptr, _pool.capacity() + MemoryPool::overhead);
 
     ptrdiff_t ptr_offset =
         static_cast<char*>(new_ptr) - static_cast<char*>(old_ptr);
+    ptrdiff_t variant_offset = ptr_offset - bytes_reclaimed;
+
+#if ARDUINOJSON_COMPACT_SLOTS
+    // the root is stored after the variants
+    ptrdiff_t root_offset = variant_offset;
+#else
+    ptrdiff_t root_offset = 0;
+#endif
 
     _pool.movePointers(ptr_offset);
-    _data.movePointers(ptr_offset, ptr_offset - bytes_reclaimed);
+    data().movePointers(root_offset, ptr_offset, variant_offset);
   }
 
+  // Always succeeds now that the pool is compacted in place
   bool garbageCollect() {
-    // make a temporary clone and move assign
-    BasicJsonDocument tmp(*this);
-    if (!tmp.capacity())
-      return false;
-    tmp.set(*this);
-    moveAssignFrom(tmp);
+    compactPool();
     return true;
   }
 
@@ -133,7 +138,9 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
  private:
   MemoryPool allocPool(size_t requiredSize) {
     size_t capa = addPadding(requiredSize);
-    return MemoryPool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+    return MemoryPool(
+        reinterpret_cast<char*>(this->allocate(capa + MemoryPool::overhead)),
+        capa);
   }
 
   void reallocPoolIfTooSmall(size_t requiredSize) {
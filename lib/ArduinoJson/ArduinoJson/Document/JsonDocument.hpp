@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Array/ElementProxy.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Memory/PoolCompactor.hpp>
 #include <ArduinoJson/Object/MemberProxy.hpp>
 #include <ArduinoJson/Object/ObjectRef.hpp>
 #include <ArduinoJson/Variant/VariantRef.hpp>
@@ -32,7 +33,7 @@ class JsonDocument : public Visitable {
 
   void clear() {
     _pool.clear();
-    _data.setNull();
+    data().setNull();
   }
 
   template <typename T>
@@ -49,7 +50,7 @@ class JsonDocument : public Visitable {
   }
 
   size_t nesting() const {
-    return _data.nesting();
+    return data().nesting();
   }
 
   size_t capacity() const {
@@ -57,7 +58,13 @@ class JsonDocument : public Visitable {
   }
 
   size_t size() const {
-    return _data.size();
+    return data().size();
+  }
+
+  // Removes the unreachable strings and variants in place, like
+  // garbageCollect(), and returns the number of bytes recovered
+  size_t compactPool() {
+    return PoolCompactor(&_pool, &data()).compact();
   }
 
   bool set(const JsonDocument& src) {
@@ -82,9 +89,18 @@ class JsonDocument : public Visitable {
   }
 
   VariantData& data() {
+#if ARDUINOJSON_COMPACT_SLOTS
+    // the root is stored in the pool, unless there is no pool
+    if (VariantData* root = _pool.root())
+      return *root;
+#endif
     return _data;
   }
 
+  const VariantData& data() const {
+    return const_cast<JsonDocument*>(this)->data();
+  }
+
   ArrayRef createNestedArray() {
     return addElement().to<ArrayRef>();
   }
@@ -185,15 +201,15 @@ class JsonDocument : public Visitable {
   }
 
   FORCE_INLINE VariantRef getElement(size_t index) {
-    return VariantRef(&_pool, _data.getElement(index));
+    return VariantRef(&_pool, data().getElement(index));
   }
 
   FORCE_INLINE VariantConstRef getElement(size_t index) const {
-    return VariantConstRef(_data.getElement(index));
+    return VariantConstRef(data().getElement(index));
   }
 
   FORCE_INLINE VariantRef getOrAddElement(size_t index) {
-    return VariantRef(&_pool, _data.getOrAddElement(index, &_pool));
+    return VariantRef(&_pool, data().getOrAddElement(index, &_pool));
   }
 
   // JsonVariantConst getMember(char*) const
@@ -201,7 +217,7 @@ class JsonDocument : public Visitable {
   // JsonVariantConst getMember(const __FlashStringHelper*) const
   template <typename TChar>
   FORCE_INLINE VariantConstRef getMember(TChar* key) const {
-    return VariantConstRef(_data.getMember(adaptString(key)));
+    return VariantConstRef(data().getMember(adaptString(key)));
   }
 
   // JsonVariantConst getMember(const std::string&) const
@@ -210,7 +226,7 @@ class JsonDocument : public Visitable {
   FORCE_INLINE
       typename enable_if<IsString<TString>::value, VariantConstRef>::type
       getMember(const TString& key) const {
-    return VariantConstRef(_data.getMember(adaptString(key)));
+    return VariantConstRef(data().getMember(adaptString(key)));
   }
 
   // JsonVariant getMember(char*)
@@ -218,7 +234,7 @@ class JsonDocument : public Visitable {
   // JsonVariant getMember(const __FlashStringHelper*)
   template <typename TChar>
   FORCE_INLINE VariantRef getMember(TChar* key) {
-    return VariantRef(&_pool, _data.getMember(adaptString(key)));
+    return VariantRef(&_pool, data().getMember(adaptString(key)));
   }
 
   // JsonVariant getMember(const std::string&)
@@ -226,7 +242,7 @@ class JsonDocument : public Visitable {
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value, VariantRef>::type
   getMember(const TString& key) {
-    return VariantRef(&_pool, _data.getMember(adaptString(key)));
+    return VariantRef(&_pool, data().getMember(adaptString(key)));
   }
 
   // getOrAddMember(char*)
@@ -234,18 +250,18 @@ class JsonDocument : public Visitable {
   // getOrAddMember(const __FlashStringHelper*)
   template <typename TChar>
   FORCE_INLINE VariantRef getOrAddMember(TChar* key) {
-    return VariantRef(&_pool, _data.getOrAddMember(adaptString(key), &_pool));
+    return VariantRef(&_pool, data().getOrAddMember(adaptString(key), &_pool));
   }
 
   // getOrAddMember(const std::string&)
   // getOrAddMember(const String&)
   template <typename TString>
   FORCE_INLINE VariantRef getOrAddMember(const TString& key) {
-    return VariantRef(&_pool, _data.getOrAddMember(adaptString(key), &_pool));
+    return VariantRef(&_pool, data().getOrAddMember(adaptString(key), &_pool));
   }
 
   FORCE_INLINE VariantRef addElement() {
-    return VariantRef(&_pool, _data.addElement(&_pool));
+    return VariantRef(&_pool, data().addElement(&_pool));
   }
 
   template <typename TValue>
@@ -262,7 +278,7 @@ class JsonDocument : public Visitable {
   }
 
   FORCE_INLINE void remove(size_t index) {
-    _data.remove(index);
+    data().remove(index);
   }
   // remove(char*)
   // remove(const char*)
@@ -270,18 +286,18 @@ class JsonDocument : public Visitable {
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar*>::value>::type remove(
       TChar* key) {
-    _data.remove(adaptString(key));
+    data().remove(adaptString(key));
   }
   // remove(const std::string&)
   // remove(const String&)
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString& key) {
-    _data.remove(adaptString(key));
+    data().remove(adaptString(key));
   }
 
   FORCE_INLINE operator VariantConstRef() const {
-    return VariantConstRef(&_data);
+    return VariantConstRef(&data());
   }
 
   bool operator==(VariantConstRef rhs) const {
@@ -294,15 +310,15 @@ class JsonDocument : public Visitable {
 
  protected:
   JsonDocument() : _pool(0, 0) {
-    _data.setNull();
+    data().setNull();
   }
 
   JsonDocument(MemoryPool pool) : _pool(pool) {
-    _data.setNull();
+    data().setNull();
   }
 
   JsonDocument(char* buf, size_t capa) : _pool(buf, capa) {
-    _data.setNull();
+    data().setNull();
   }
 
   void replacePool(MemoryPool pool) {
@@ -310,11 +326,11 @@ class JsonDocument : public Visitable {
   }
 
   VariantRef getVariant() {
-    return VariantRef(&_pool, &_data);
+    return VariantRef(&_pool, &data());
   }
 
   VariantConstRef getVariant() const {
-    return VariantConstRef(&_data);
+    return VariantConstRef(&data());
   }
 
   MemoryPool _pool;
@@ -45,12 +45,11 @@ class StaticJsonDocument : public JsonDocument {
   }
 
   void garbageCollect() {
-    StaticJsonDocument tmp(*this);
-    set(tmp);
+    compactPool();
   }
 
  private:
-  char _buffer[_capacity];
+  char _buffer[_capacity + MemoryPool::overhead];
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,280 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Flash/FlashDocument.hpp>
+#include <ArduinoJson/Json/JsonTokenizer.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Builds the nodes of a FlashDocument, reading the JSON document with
+// readStaticByte(). It checks the syntax like JsonDeserializer, except that:
+// - the comments are not supported,
+// - \u escape sequences are not supported (NotSupported),
+// - the document can't exceed 64KB (NotSupported),
+// - the duplicate keys are kept, and the lookups find the first one.
+class FlashDeserializer {
+ public:
+  FlashDeserializer(FlashDocument &doc, const char *input)
+      : _doc(&doc), _blob(input), _ptr(input) {}
+
+  DeserializationError parse(NestingLimit nestingLimit) {
+    _doc->clear();
+    _doc->_blob = _blob;
+    DeserializationError err = parseVariant(nestingLimit);
+    if (err)
+      _doc->clear();
+    return err;
+  }
+
+ private:
+  char current() const {
+    return readStaticByte(_ptr);
+  }
+
+  void move() {
+    _ptr++;
+  }
+
+  bool eat(char charToSkip) {
+    if (current() != charToSkip)
+      return false;
+    move();
+    return true;
+  }
+
+  void skipSpaces() {
+    for (;;) {
+      switch (current()) {
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          move();
+          continue;
+        default:
+          return;
+      }
+    }
+  }
+
+  // Returns the index of the new node, or -1 if there is no room
+  int addNode(uint8_t type, const char *start) {
+    if (_doc->_count >= _doc->_capacity)
+      return -1;
+    FlashNode &node = _doc->_nodes[_doc->_count];
+    node.type = type;
+    node.offset = uint16_t(start - _blob);
+    node.extent = 0;
+    return int(_doc->_count++);
+  }
+
+  DeserializationError setExtent(int index, size_t extent) {
+    if (size_t(_ptr - _blob) > 0xFFFF || extent > 0xFFFF)
+      return DeserializationError::NotSupported;
+    _doc->_nodes[index].extent = uint16_t(extent);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError parseVariant(NestingLimit nestingLimit) {
+    skipSpaces();
+    switch (current()) {
+      case '[':
+        return parseArray(nestingLimit);
+
+      case '{':
+        return parseObject(nestingLimit);
+
+      case '\"':
+      case '\'':
+        return parseString();
+
+      default:
+        return parseNumericValue();
+    }
+  }
+
+  DeserializationError parseArray(NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    int index = addNode(FLASH_ARRAY, _ptr);
+    if (index < 0)
+      return DeserializationError::NoMemory;
+    move();  // [
+
+    skipSpaces();
+    if (!eat(']')) {
+      for (;;) {
+        DeserializationError err = parseVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+        skipSpaces();
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return current() ? DeserializationError::InvalidInput
+                           : DeserializationError::IncompleteInput;
+      }
+    }
+    return setExtent(index, _doc->_count - size_t(index));
+  }
+
+  DeserializationError parseObject(NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    int index = addNode(FLASH_OBJECT, _ptr);
+    if (index < 0)
+      return DeserializationError::NoMemory;
+    move();  // {
+
+    skipSpaces();
+    if (!eat('}')) {
+      for (;;) {
+        skipSpaces();
+        if (!current())
+          return DeserializationError::IncompleteInput;
+        DeserializationError err = parseKey();
+        if (err)
+          return err;
+        skipSpaces();
+        if (!eat(':'))
+          return current() ? DeserializationError::InvalidInput
+                           : DeserializationError::IncompleteInput;
+        err = parseVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+        skipSpaces();
+        if (eat('}'))
+          break;
+        if (!eat(','))
+          return current() ? DeserializationError::InvalidInput
+                           : DeserializationError::IncompleteInput;
+      }
+    }
+    return setExtent(index, _doc->_count - size_t(index));
+  }
+
+  // Like JsonDeserializer, the keys may be without quotes
+  DeserializationError parseKey() {
+    if (current() == '\"' || current() == '\'')
+      return parseString();
+    if (!canBeInNonQuotedString(current()))
+      return DeserializationError::InvalidInput;
+    const char *start = _ptr;
+    do {
+      move();
+    } while (canBeInNonQuotedString(current()));
+    int index = addNode(FLASH_STRING, start);
+    if (index < 0)
+      return DeserializationError::NoMemory;
+    return setExtent(index, size_t(_ptr - start));
+  }
+
+  DeserializationError parseString() {
+    char stopChar = current();
+    move();
+    const char *start = _ptr;
+    uint8_t type = FLASH_STRING;
+    for (;;) {
+      char c = current();
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      move();
+      if (c == stopChar)
+        break;
+      if (c == '\\') {
+        c = current();
+        if (c == '\0')
+          return DeserializationError::IncompleteInput;
+        if (c == 'u')
+          return DeserializationError::NotSupported;
+        if (!EscapeSequence::unescapeChar(c))
+          return DeserializationError::InvalidInput;
+        move();
+        type = FLASH_ESCAPED_STRING;
+      }
+    }
+    int index = addNode(type, start);
+    if (index < 0)
+      return DeserializationError::NoMemory;
+    return setExtent(index, size_t(_ptr - 1 - start));
+  }
+
+  // The same errors as JsonTokenizer: IncompleteInput for a keyword cut by the
+  // end of the input
+  DeserializationError parseNumericValue() {
+    const char *start = _ptr;
+    uint8_t type = FLASH_NUMBER;
+    DeserializationError err;
+    switch (current()) {
+      case 't':
+        type = FLASH_BOOLEAN;
+        err = skipKeyword("true");
+        break;
+      case 'f':
+        type = FLASH_BOOLEAN;
+        err = skipKeyword("false");
+        break;
+      case 'n':
+        type = FLASH_NULL;
+        err = skipKeyword("null");
+        break;
+      case '\0':
+        return DeserializationError::IncompleteInput;
+      default: {
+        StaticStringLatch latch(_ptr);
+        ParsedNumber<Float, UInt> num;
+        err = scanNumberToken(latch, num);
+        _ptr = latch.ptr();
+        break;
+      }
+    }
+    if (err)
+      return err;
+    int index = addNode(type, start);
+    if (index < 0)
+      return DeserializationError::NoMemory;
+    return setExtent(index, size_t(_ptr - start));
+  }
+
+  // Skips true, false, or null; see KeywordMatcher
+  DeserializationError skipKeyword(const char *keyword) {
+    KeywordMatcher matcher(keyword);
+    while (canBeInNonQuotedString(current())) {
+      matcher.append(current());
+      move();
+    }
+    return matcher.complete(current() == '\0');
+  }
+
+  FlashDocument *_doc;
+  const char *_blob;
+  const char *_ptr;
+};
+
+// deserializeJson(FlashDocument&, const char*, NestingLimit)
+// CAUTION: the input is read with pgm_read_byte() when PROGMEM is available,
+// so it must be in flash (declare it with PROGMEM).
+inline DeserializationError deserializeJson(
+    FlashDocument &doc, const char *input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return FlashDeserializer(doc, input).parse(nestingLimit);
+}
+
+#if ARDUINOJSON_ENABLE_PROGMEM
+// deserializeJson(FlashDocument&, const __FlashStringHelper*, NestingLimit)
+inline DeserializationError deserializeJson(
+    FlashDocument &doc, const __FlashStringHelper *input,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return FlashDeserializer(doc, reinterpret_cast<const char *>(input))
+      .parse(nestingLimit);
+}
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
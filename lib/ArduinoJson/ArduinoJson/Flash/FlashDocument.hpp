@@ -0,0 +1,336 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Numbers/Float.hpp>
+#include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/mpl/max.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/KeyLiteral.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, uint16_t
+#include <string.h>  // strlen
+
+namespace ARDUINOJSON_NAMESPACE {
+
+enum {
+  FLASH_NULL,
+  FLASH_BOOLEAN,
+  FLASH_NUMBER,
+  FLASH_STRING,
+  FLASH_ESCAPED_STRING,  // has escape sequences
+  FLASH_ARRAY,
+  FLASH_OBJECT
+};
+
+// A value or a key of a JSON document in flash.
+// The containers are followed by their values (by their keys and values for
+// the objects), so a document is a flat array of nodes in RAM, and the bytes
+// remain in flash.
+struct FlashNode {
+  uint16_t offset;  // of the value in the document, after the quote
+  uint16_t extent;  // length of a scalar, number of nodes of a container
+  uint8_t type;
+
+  const FlashNode *next() const {
+    return this + (type >= FLASH_ARRAY ? extent : 1);
+  }
+};
+
+// Reads a null-terminated string in flash, like StringLatch
+class StaticStringLatch {
+ public:
+  explicit StaticStringLatch(const char *s) : _ptr(s) {}
+
+  char current() const {
+    return readStaticByte(_ptr);
+  }
+
+  void clear() {
+    _ptr++;
+  }
+
+  const char *ptr() const {
+    return _ptr;
+  }
+
+ private:
+  const char *_ptr;
+};
+
+// Reads the characters of a string in flash, without its escape sequences
+class FlashStringReader {
+ public:
+  FlashStringReader(const char *blob, const FlashNode *node)
+      : _ptr(blob + node->offset),
+        _end(_ptr + node->extent),
+        _escaped(node->type == FLASH_ESCAPED_STRING) {}
+
+  // Returns 0 at the end
+  int read() {
+    if (_ptr == _end)
+      return 0;
+    char c = readStaticByte(_ptr++);
+    if (_escaped && c == '\\')
+      c = EscapeSequence::unescapeChar(readStaticByte(_ptr++));
+    return static_cast<unsigned char>(c);
+  }
+
+ private:
+  const char *_ptr;
+  const char *_end;
+  bool _escaped;
+};
+
+// A read-only value of a FlashDocument
+class FlashVariant {
+ public:
+  FlashVariant() : _blob(0), _node(0) {}
+  FlashVariant(const char *blob, const FlashNode *node)
+      : _blob(blob), _node(node) {}
+
+  bool isNull() const {
+    return type() == FLASH_NULL;
+  }
+
+  bool isBoolean() const {
+    return type() == FLASH_BOOLEAN;
+  }
+
+  bool isNumber() const {
+    return type() == FLASH_NUMBER;
+  }
+
+  bool isString() const {
+    return type() == FLASH_STRING || type() == FLASH_ESCAPED_STRING;
+  }
+
+  bool isArray() const {
+    return type() == FLASH_ARRAY;
+  }
+
+  bool isObject() const {
+    return type() == FLASH_OBJECT;
+  }
+
+  // Booleans and numbers, converted like JsonVariant::as<T>()
+  template <typename T>
+  typename enable_if<is_integral<T>::value || is_floating_point<T>::value,
+                     T>::type
+  as() const {
+    switch (type()) {
+      case FLASH_BOOLEAN:
+        return T(asBoolean());
+      case FLASH_NUMBER:
+        return parseNumber().template as<T>();
+      default:
+        return 0;
+    }
+  }
+
+  template <typename T>
+  typename enable_if<is_same<T, bool>::value, T>::type as() const {
+    switch (type()) {
+      case FLASH_BOOLEAN:
+        return asBoolean();
+      case FLASH_NUMBER:
+        return parseNumber().template as<Float>() != 0;
+      case FLASH_NULL:
+        return false;
+      default:  // strings and containers, like VariantData::asBoolean()
+        return true;
+    }
+  }
+
+  // Number of elements of an array, or of members of an object
+  size_t size() const {
+    size_t n = 0;
+    for (const FlashNode *child = begin(); child != end();
+         child = child->next())
+      n++;
+    return isObject() ? n / 2 : n;
+  }
+
+  FlashVariant operator[](size_t index) const {
+    if (!isArray())
+      return FlashVariant();
+    const FlashNode *child = begin();
+    for (; child != end(); child = child->next()) {
+      if (index-- == 0)
+        return FlashVariant(_blob, child);
+    }
+    return FlashVariant();
+  }
+
+  // operator[](char*) const
+  // operator[](const char*) const
+  template <typename TChar>
+  typename enable_if<is_same<typename remove_const<TChar>::type, char>::value,
+                     FlashVariant>::type
+  operator[](TChar *key) const {
+    return key ? getMember(key, strlen(key)) : FlashVariant();
+  }
+
+  FlashVariant operator[](const KeyLiteral &key) const {
+    return getMember(key.c_str(), key.size());
+  }
+
+  // Copies the string without its escape sequences, and returns its length;
+  // like strlcpy(), it truncates to size - 1 characters
+  size_t copyString(char *buffer, size_t size) const {
+    if (!isString())
+      return 0;
+    FlashStringReader reader(_blob, _node);
+    size_t n = 0;
+    for (int c = reader.read(); c; c = reader.read()) {
+      if (n + 1 < size)
+        buffer[n] = char(c);
+      n++;
+    }
+    if (size)
+      buffer[n < size ? n : size - 1] = 0;
+    return n;
+  }
+
+  bool equals(const char *s) const {
+    return s && isString() && equals(_node, s, strlen(s));
+  }
+
+ private:
+  uint8_t type() const {
+    return _node ? _node->type : uint8_t(FLASH_NULL);
+  }
+
+  bool asBoolean() const {
+    return readStaticByte(_blob + _node->offset) == 't';
+  }
+
+  ParsedNumber<Float, UInt> parseNumber() const {
+    StaticStringLatch latch(_blob + _node->offset);
+    return scanNumber<Float, UInt>(latch);
+  }
+
+  const FlashNode *begin() const {
+    return _node + 1;
+  }
+
+  const FlashNode *end() const {
+    return type() >= FLASH_ARRAY ? _node + _node->extent : begin();
+  }
+
+  FlashVariant getMember(const char *key, size_t length) const {
+    if (!isObject())
+      return FlashVariant();
+    const FlashNode *child = begin();
+    while (child != end()) {
+      const FlashNode *value = child + 1;
+      if (equals(child, key, length))
+        return FlashVariant(_blob, value);
+      child = value->next();
+    }
+    return FlashVariant();
+  }
+
+  bool equals(const FlashNode *node, const char *s, size_t length) const {
+    // without escape sequences, the lengths must match
+    if (node->type == FLASH_STRING && node->extent != length)
+      return false;
+    FlashStringReader reader(_blob, node);
+    for (size_t i = 0; i < length; i++) {
+      if (reader.read() != static_cast<unsigned char>(s[i]))
+        return false;
+    }
+    return reader.read() == 0;
+  }
+
+  const char *_blob;
+  const FlashNode *_node;
+};
+
+// A read-only JSON document that stays in flash: deserializeJson() only
+// builds the nodes, in RAM; the strings and the numbers are read from flash
+// each time they're accessed. The FlashVariants point to the nodes, so they
+// must not outlive the document.
+// Outside of the AVR and the ESP8266, "flash" is any constant data.
+class FlashDocument {
+ public:
+  FlashVariant root() const {
+    return _count ? FlashVariant(_blob, _nodes) : FlashVariant();
+  }
+
+  FlashVariant operator[](size_t index) const {
+    return root()[index];
+  }
+
+  // operator[](char*) const
+  // operator[](const char*) const
+  template <typename TChar>
+  typename enable_if<is_same<typename remove_const<TChar>::type, char>::value,
+                     FlashVariant>::type
+  operator[](TChar *key) const {
+    return root()[key];
+  }
+
+  FlashVariant operator[](const KeyLiteral &key) const {
+    return root()[key];
+  }
+
+  bool isNull() const {
+    return root().isNull();
+  }
+
+  size_t size() const {
+    return root().size();
+  }
+
+  // Bytes of RAM taken by the nodes
+  size_t memoryUsage() const {
+    return _count * sizeof(FlashNode);
+  }
+
+  size_t capacity() const {
+    return _capacity * sizeof(FlashNode);
+  }
+
+  void clear() {
+    _blob = 0;
+    _count = 0;
+  }
+
+ protected:
+  FlashDocument(FlashNode *nodes, size_t capacity)
+      : _blob(0), _nodes(nodes), _capacity(capacity), _count(0) {}
+
+ private:
+  FlashDocument(const FlashDocument &);             // cannot be copied
+  FlashDocument &operator=(const FlashDocument &);  // cannot be assigned
+
+  friend class FlashDeserializer;
+
+  const char *_blob;
+  FlashNode *_nodes;
+  size_t _capacity;  // in nodes
+  size_t _count;
+};
+
+// Each key and each value takes one FlashNode (6 bytes)
+template <size_t desiredCapacity>
+class StaticFlashDocument : public FlashDocument {
+  static const size_t _capacity =
+      (Max<1, desiredCapacity>::value + sizeof(FlashNode) - 1) /
+      sizeof(FlashNode);
+
+ public:
+  StaticFlashDocument() : FlashDocument(_buffer, _capacity) {}
+
+ private:
+  FlashNode _buffer[_capacity];
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -5,11 +5,44 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/pgmspace_generic.hpp>
+
+#include <stdint.h>
 
 namespace ARDUINOJSON_NAMESPACE {
 
 class EscapeSequence {
  public:
+#if ARDUINOJSON_ESCAPE_TABLES
+  static char escapeChar(char c) {
+    // the characters from 0x60 never need to be escaped
+    static const char table[] ARDUINOJSON_PROGMEM = {
+        0, 0, 0,   0, 0, 0, 0, 0, 'b', 't', 'n', 0, 'f',  'r', 0, 0,  // 0x00
+        0, 0, 0,   0, 0, 0, 0, 0, 0,   0,   0,   0, 0,    0,   0, 0,  // 0x10
+        0, 0, '"', 0, 0, 0, 0, 0, 0,   0,   0,   0, 0,    0,   0, 0,  // 0x20
+        0, 0, 0,   0, 0, 0, 0, 0, 0,   0,   0,   0, 0,    0,   0, 0,  // 0x30
+        0, 0, 0,   0, 0, 0, 0, 0, 0,   0,   0,   0, 0,    0,   0, 0,  // 0x40
+        0, 0, 0,   0, 0, 0, 0, 0, 0,   0,   0,   0, '\\', 0,   0, 0,  // 0x50
+    };
+    uint8_t i = static_cast<uint8_t>(c);
+    return i < sizeof(table) ? readStaticByte(table + i) : 0;
+  }
+
+  static char unescapeChar(char c) {
+    static const char table[] ARDUINOJSON_PROGMEM = {
+        0, 0, 0,    0, 0,    0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    0,   // 0x00
+        0, 0, 0,    0, 0,    0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    0,   // 0x10
+        0, 0, '"',  0, 0,    0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    '/', // 0x20
+        0, 0, 0,    0, 0,    0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    0,   // 0x30
+        0, 0, 0,    0, 0,    0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    0,   // 0x40
+        0, 0, 0,    0, 0,    0, 0,    0, 0, 0, 0, 0, '\\', 0, 0,    0,   // 0x50
+        0, 0, '\b', 0, 0,    0, '\f', 0, 0, 0, 0, 0, 0,    0, '\n', 0,   // 0x60
+        0, 0, '\r', 0, '\t', 0, 0,    0, 0, 0, 0, 0, 0,    0, 0,    0,   // 0x70
+    };
+    uint8_t i = static_cast<uint8_t>(c);
+    return i < sizeof(table) ? readStaticByte(table + i) : 0;
+  }
+#else
   // Optimized for code size on a 8-bit AVR
   static char escapeChar(char c) {
     const char *p = escapeTable(true);
@@ -35,5 +68,6 @@ class EscapeSequence {
   static const char *escapeTable(bool excludeSolidus) {
     return &"//\"\"\\\\b\bf\fn\nr\rt\t"[excludeSolidus ? 2 : 0];
   }
+#endif
 };
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,49 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/measureCapacity.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// measureJsonCapacity(const std::string&, ...)
+// measureJsonCapacity(const String&, ...)
+template <typename TInput>
+CapacityReport measureJsonCapacity(const TInput &input,
+                                   NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit,
+                                           AllowAllFilter());
+}
+template <typename TInput>
+CapacityReport measureJsonCapacity(const TInput &input, Filter filter,
+                                   NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit, filter);
+}
+template <typename TInput>
+CapacityReport measureJsonCapacity(const TInput &input,
+                                   NestingLimit nestingLimit, Filter filter) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit, filter);
+}
+
+// measureJsonCapacity(const char*, ...)
+template <typename TChar>
+CapacityReport measureJsonCapacity(TChar *input,
+                                   NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit,
+                                           AllowAllFilter());
+}
+template <typename TChar>
+CapacityReport measureJsonCapacity(TChar *input, Filter filter,
+                                   NestingLimit nestingLimit = NestingLimit()) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit, filter);
+}
+template <typename TChar>
+CapacityReport measureJsonCapacity(TChar *input, NestingLimit nestingLimit,
+                                   Filter filter) {
+  return measureCapacity<JsonDeserializer>(input, nestingLimit, filter);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
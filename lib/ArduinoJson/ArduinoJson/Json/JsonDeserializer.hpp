@@ -5,41 +5,52 @@
 #pragma once
 
 #include <ArduinoJson/Deserialization/deserialize.hpp>
-#include <ArduinoJson/Json/EscapeSequence.hpp>
-#include <ArduinoJson/Json/Latch.hpp>
-#include <ArduinoJson/Json/Utf16.hpp>
-#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Json/JsonTokenizer.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
-#include <ArduinoJson/Numbers/parseNumber.hpp>
-#include <ArduinoJson/Polyfills/assert.hpp>
-#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Polyfills/mpl/max.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TReader, typename TStringStorage>
-class JsonDeserializer {
+class JsonDeserializer : JsonTokenizer<TReader> {
+  typedef JsonTokenizer<TReader> base;
   typedef typename remove_reference<TStringStorage>::type::StringBuilder
       StringBuilder;
 
+  using base::_latch;
+  using base::current;
+  using base::eat;
+  using base::move;
+  using base::readNonQuotedString;
+  using base::readNumber;
+  using base::readQuotedString;
+  using base::skipArray;
+  using base::skipKeyword;
+  using base::skipNumericValue;
+  using base::skipObject;
+  using base::skipSpacesAndComments;
+  using base::skipString;
+  using base::skipVariant;
+
   struct StringOrError {
     DeserializationError err;
     const char *value;
 
-    StringOrError(DeserializationError e) : err(e) {}
-    StringOrError(DeserializationError::Code c) : err(c) {}
+    StringOrError(DeserializationError e) : err(e), value(0) {}
+    StringOrError(DeserializationError::Code c) : err(c), value(0) {}
     StringOrError(const char *s) : err(DeserializationError::Ok), value(s) {}
   };
 
  public:
   JsonDeserializer(MemoryPool &pool, TReader reader,
                    TStringStorage stringStorage)
-      : _pool(&pool), _stringStorage(stringStorage), _latch(reader) {}
+      : base(reader), _pool(&pool), _stringStorage(stringStorage) {}
 
   template <typename TFilter>
   DeserializationError parse(VariantData &variant, TFilter filter,
                              NestingLimit nestingLimit) {
-    DeserializationError err = parseVariant(variant, filter, nestingLimit);
+    DeserializationError err = parseDocument(variant, filter, nestingLimit);
 
     if (!err && _latch.last() != 0 && !variant.isEnclosed()) {
       // We don't detect trailing characters earlier, so we need to check now
@@ -49,24 +60,218 @@ class JsonDeserializer {
     return err;
   }
 
+  // Parses the next document of a sequence, and the spaces up to the end of
+  // its line, so that the next call starts on the next line.
+  // After an error, skips the rest of the line.
+  template <typename TFilter>
+  DeserializationError parseLine(VariantData &variant, TFilter filter,
+                                 NestingLimit nestingLimit) {
+    DeserializationError err = parseDocument(variant, filter, nestingLimit);
+    if (!err)
+      err = skipLineEnd();
+    if (err)
+      skipLine();
+    return err;
+  }
+
+  // Skips the blank lines (and the comments) before the next document, and
+  // tells if there is none
+  bool atEnd() {
+    skipSpacesAndComments();  // IncompleteInput at the end
+    return current() == 0;
+  }
+
  private:
   JsonDeserializer &operator=(const JsonDeserializer &);  // non-copiable
 
-  char current() {
-    return _latch.current();
+  template <typename TFilter>
+  DeserializationError parseDocument(VariantData &variant, TFilter filter,
+                                     NestingLimit nestingLimit) {
+#if ARDUINOJSON_ITERATIVE_DESERIALIZER
+    return parseIteratively(&variant, filter, nestingLimit);
+#else
+    return parseVariant(variant, filter, nestingLimit);
+#endif
   }
 
-  void move() {
-    _latch.clear();
+#if ARDUINOJSON_ITERATIVE_DESERIALIZER
+  // An array or an object being parsed
+  template <typename TFilter>
+  struct Frame {
+    CollectionData *collection;  // null if skipped
+    TFilter filter;
+    bool isObject;
+    bool hasDuplicateKeys;
+  };
+
+  // Same as parseVariant(), but the open arrays and objects are in a stack of
+  // frames instead of the call stack.
+  // The stack holds ARDUINOJSON_DEFAULT_NESTING_LIMIT frames. Under a larger
+  // NestingLimit, the collection that doesn't fit is parsed by a nested call,
+  // with a stack of its own, so the call stack grows by one stack every
+  // ARDUINOJSON_DEFAULT_NESTING_LIMIT levels.
+  // Inlining beginMember() and parseScalar() keeps variant and valueFilter in
+  // registers, and the speed of the recursive version.
+  template <typename TFilter>
+  DeserializationError parseIteratively(VariantData *root, TFilter filter,
+                                        NestingLimit nestingLimit) {
+    Frame<TFilter> stack[Max<1, ARDUINOJSON_DEFAULT_NESTING_LIMIT>::value];
+    const uint8_t stackSize = sizeof(stack) / sizeof(*stack);
+    uint8_t maxDepth = 0;
+    for (; !nestingLimit.reached(); nestingLimit = nestingLimit.decrement())
+      maxDepth++;
+    uint8_t depth = 0;
+
+    VariantData *variant = root;  // null to skip the value
+    TFilter valueFilter = filter;
+
+    for (;;) {
+      // 1 - Parse a value, or open a collection
+      DeserializationError err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      char c = current();
+      if (c == '[' || c == '{') {
+        if (depth == maxDepth)
+          return DeserializationError::TooDeep;
+
+        if (depth == stackSize) {
+          err = parseIteratively(variant, valueFilter,
+                                 NestingLimit(uint8_t(maxDepth - depth)));
+          if (err)
+            return err;
+        } else {
+          bool isObject = c == '{';
+          CollectionData *collection = 0;
+          if (variant && isObject && valueFilter.allowObject())
+            collection = &variant->toObject();
+          if (variant && !isObject && valueFilter.allowArray())
+            collection = &variant->toArray();
+          move();
+
+          Frame<TFilter> &frame = stack[depth++];
+          frame.collection = collection;
+          frame.filter = valueFilter;
+          frame.isObject = isObject;
+          frame.hasDuplicateKeys = false;
+
+          err = skipSpacesAndComments();
+          if (err)
+            return err;
+
+          if (!eat(frame.isObject ? '}' : ']')) {
+            err = beginMember(frame, variant, valueFilter);
+            if (err)
+              return err;
+            continue;
+          }
+          depth--;  // empty
+        }
+      } else {
+        err = parseScalar(variant, valueFilter);
+        if (err)
+          return err;
+      }
+
+      // 2 - Close the collections that end here
+      for (;;) {
+        if (!depth)
+          return DeserializationError::Ok;
+
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        Frame<TFilter> &frame = stack[depth - 1];
+        if (!eat(frame.isObject ? '}' : ']'))
+          break;
+        if (frame.collection && !frame.hasDuplicateKeys)
+          packCollection(*frame.collection);
+        depth--;
+      }
+
+      // 3 - More values?
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+      err = beginMember(stack[depth - 1], variant, valueFilter);
+      if (err)
+        return err;
+    }
   }
 
-  bool eat(char charToSkip) {
-    if (current() != charToSkip)
-      return false;
-    move();
-    return true;
+  // Adds the next element or member to the collection, after parsing its key
+  template <typename TFilter>
+  FORCE_INLINE DeserializationError beginMember(Frame<TFilter> &frame,
+                                                VariantData *&variant,
+                                                TFilter &filter) {
+    variant = 0;
+
+    if (!frame.isObject) {
+      filter = frame.filter[0UL];
+      if (frame.collection && filter.allow()) {
+        variant = frame.collection->addElement(_pool);
+        if (!variant)
+          return DeserializationError::NoMemory;
+      }
+      return DeserializationError::Ok;
+    }
+
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    const char *key = 0;
+    if (frame.collection) {
+      StringOrError result = parseKey();
+      err = result.err;
+      key = result.value;
+    } else {
+      err = isQuote(current()) ? skipString() : skipNumericValue();
+    }
+    if (err)
+      return err;
+
+    err = skipSpacesAndComments();
+    if (err)
+      return err;
+    if (!eat(':'))
+      return DeserializationError::InvalidInput;
+
+    if (!key)
+      return DeserializationError::Ok;
+
+    filter = frame.filter[key];
+    if (!filter.allow()) {
+      _stringStorage.reclaim(key);
+      return DeserializationError::Ok;
+    }
+
+    variant = frame.collection->getMember(adaptString(key));
+    if (variant) {
+      frame.hasDuplicateKeys = true;  // see parseObject()
+      return DeserializationError::Ok;
+    }
+
+    VariantSlot *slot = frame.collection->addSlot(_pool);
+    if (!slot)
+      return DeserializationError::NoMemory;
+    slot->setOwnedKey(make_not_null(key));
+    variant = slot->data();
+    return DeserializationError::Ok;
   }
 
+  template <typename TFilter>
+  FORCE_INLINE DeserializationError parseScalar(VariantData *variant,
+                                                TFilter filter) {
+    bool allowed = variant && filter.allowValue();
+    if (isQuote(current()))
+      return allowed ? parseStringValue(*variant) : skipString();
+    else
+      return allowed ? parseNumericValue(*variant) : skipNumericValue();
+  }
+#endif
+
   template <typename TFilter>
   DeserializationError parseVariant(VariantData &variant, TFilter filter,
                                     NestingLimit nestingLimit) {
@@ -102,27 +307,6 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError skipVariant(NestingLimit nestingLimit) {
-    DeserializationError err = skipSpacesAndComments();
-    if (err)
-      return err;
-
-    switch (current()) {
-      case '[':
-        return skipArray(nestingLimit);
-
-      case '{':
-        return skipObject(nestingLimit);
-
-      case '\"':
-      case '\'':
-        return skipString();
-
-      default:
-        return skipNumericValue();
-    }
-  }
-
   template <typename TFilter>
   DeserializationError parseArray(CollectionData &array, TFilter filter,
                                   NestingLimit nestingLimit) {
@@ -169,38 +353,19 @@ class JsonDeserializer {
 
       // 3 - More values?
       if (eat(']'))
-        return DeserializationError::Ok;
+        return packCollection(array);
       if (!eat(','))
         return DeserializationError::InvalidInput;
     }
   }
 
-  DeserializationError skipArray(NestingLimit nestingLimit) {
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
-
-    // Skip opening braket
-    ARDUINOJSON_ASSERT(current() == '[');
-    move();
-
-    // Read each value
-    for (;;) {
-      // 1 - Skip value
-      DeserializationError err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
-
-      // 2 - Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // 3 - More values?
-      if (eat(']'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
-    }
+  DeserializationError packCollection(CollectionData &collection) {
+#if ARDUINOJSON_PACK_COLLECTIONS
+    collection.pack(_pool);
+#else
+    (void)collection;
+#endif
+    return DeserializationError::Ok;
   }
 
   template <typename TFilter>
@@ -222,6 +387,10 @@ class JsonDeserializer {
     if (eat('}'))
       return DeserializationError::Ok;
 
+    // A duplicate key puts the new value's slots after other members,
+    // which breaks the layout expected by CollectionData::pack()
+    bool hasDuplicateKeys = false;
+
     // Read each key value pair
     for (;;) {
       // Parse key
@@ -250,6 +419,8 @@ class JsonDeserializer {
           slot->setOwnedKey(make_not_null(key.value));
 
           variant = slot->data();
+        } else {
+          hasDuplicateKeys = true;
         }
 
         // Parse value
@@ -270,7 +441,8 @@ class JsonDeserializer {
 
       // More keys/values?
       if (eat('}'))
-        return DeserializationError::Ok;
+        return hasDuplicateKeys ? DeserializationError::Ok
+                                : packCollection(object);
       if (!eat(','))
         return DeserializationError::InvalidInput;
 
@@ -281,57 +453,6 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError skipObject(NestingLimit nestingLimit) {
-    if (nestingLimit.reached())
-      return DeserializationError::TooDeep;
-
-    // Skip opening brace
-    ARDUINOJSON_ASSERT(current() == '{');
-    move();
-
-    // Skip spaces
-    DeserializationError err = skipSpacesAndComments();
-    if (err)
-      return err;
-
-    // Empty object?
-    if (eat('}'))
-      return DeserializationError::Ok;
-
-    // Read each key value pair
-    for (;;) {
-      // Skip key
-      err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // Colon
-      if (!eat(':'))
-        return DeserializationError::InvalidInput;
-
-      // Skip value
-      err = skipVariant(nestingLimit.decrement());
-      if (err)
-        return err;
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err)
-        return err;
-
-      // More keys/values?
-      if (eat('}'))
-        return DeserializationError::Ok;
-      if (!eat(','))
-        return DeserializationError::InvalidInput;
-    }
-  }
-
   StringOrError parseKey() {
     if (isQuote(current())) {
       return parseQuotedString();
@@ -350,49 +471,9 @@ class JsonDeserializer {
 
   StringOrError parseQuotedString() {
     StringBuilder builder = _stringStorage.startString();
-#if ARDUINOJSON_DECODE_UNICODE
-    Utf16::Codepoint codepoint;
-#endif
-    const char stopChar = current();
-
-    move();
-    for (;;) {
-      char c = current();
-      move();
-      if (c == stopChar)
-        break;
-
-      if (c == '\0')
-        return DeserializationError::IncompleteInput;
-
-      if (c == '\\') {
-        c = current();
-        if (c == '\0')
-          return DeserializationError::IncompleteInput;
-        if (c == 'u') {
-#if ARDUINOJSON_DECODE_UNICODE
-          move();
-          uint16_t codeunit;
-          DeserializationError err = parseHex4(codeunit);
-          if (err)
-            return err;
-          if (codepoint.append(codeunit))
-            Utf8::encodeCodepoint(codepoint.value(), builder);
-          continue;
-#else
-          return DeserializationError::NotSupported;
-#endif
-        }
-        // replace char
-        c = EscapeSequence::unescapeChar(c);
-        if (c == '\0')
-          return DeserializationError::InvalidInput;
-        move();
-      }
-
-      builder.append(c);
-    }
-
+    DeserializationError err = readQuotedString(builder);
+    if (err)
+      return err;
     const char *result = builder.complete();
     if (!result)
       return DeserializationError::NoMemory;
@@ -401,205 +482,72 @@ class JsonDeserializer {
 
   StringOrError parseNonQuotedString() {
     StringBuilder builder = _stringStorage.startString();
-
-    char c = current();
-    ARDUINOJSON_ASSERT(c);
-
-    if (canBeInNonQuotedString(c)) {  // no quotes
-      do {
-        move();
-        builder.append(c);
-        c = current();
-      } while (canBeInNonQuotedString(c));
-    } else {
-      return DeserializationError::InvalidInput;
-    }
-
+    DeserializationError err = readNonQuotedString(builder);
+    if (err)
+      return err;
     const char *result = builder.complete();
     if (!result)
       return DeserializationError::NoMemory;
     return result;
   }
 
-  DeserializationError skipString() {
-    const char stopChar = current();
-
-    move();
-    for (;;) {
-      char c = current();
-      move();
-      if (c == stopChar)
-        break;
-      if (c == '\0')
-        return DeserializationError::IncompleteInput;
-      if (c == '\\') {
-        if (current() != '\0')
-          move();
-      }
-    }
-
-    return DeserializationError::Ok;
-  }
-
   DeserializationError parseNumericValue(VariantData &result) {
-    char buffer[64];
-    uint8_t n = 0;
-
-    char c = current();
-    while (canBeInNonQuotedString(c) && n < 63) {
-      move();
-      buffer[n++] = c;
-      c = current();
-    }
-    buffer[n] = 0;
-
-    c = buffer[0];
-    if (c == 't') {  // true
-      result.setBoolean(true);
-      return n == 4 ? DeserializationError::Ok
-                    : DeserializationError::IncompleteInput;
-    }
-    if (c == 'f') {  // false
-      result.setBoolean(false);
-      return n == 5 ? DeserializationError::Ok
-                    : DeserializationError::IncompleteInput;
-    }
-    if (c == 'n') {  // null
-      // the variant is already null
-      return n == 4 ? DeserializationError::Ok
-                    : DeserializationError::IncompleteInput;
-    }
-
-    ParsedNumber<Float, UInt> num = parseNumber<Float, UInt>(buffer);
-
-    switch (num.type()) {
-      case VALUE_IS_NEGATIVE_INTEGER:
-        result.setNegativeInteger(num.uintValue);
-        return DeserializationError::Ok;
-
-      case VALUE_IS_POSITIVE_INTEGER:
-        result.setPositiveInteger(num.uintValue);
-        return DeserializationError::Ok;
-
-      case VALUE_IS_FLOAT:
-        result.setFloat(num.floatValue);
-        return DeserializationError::Ok;
-    }
-
-    return DeserializationError::InvalidInput;
-  }
-
-  DeserializationError skipNumericValue() {
-    char c = current();
-    while (canBeInNonQuotedString(c)) {
-      move();
-      c = current();
+    switch (current()) {
+      case 't':  // true
+        result.setBoolean(true);
+        return skipKeyword("true");
+      case 'f':  // false
+        result.setBoolean(false);
+        return skipKeyword("false");
+      case 'n':  // null
+        // the variant is already null
+        return skipKeyword("null");
     }
-    return DeserializationError::Ok;
-  }
 
-  DeserializationError parseHex4(uint16_t &result) {
-    result = 0;
-    for (uint8_t i = 0; i < 4; ++i) {
-      char digit = current();
-      if (!digit)
-        return DeserializationError::IncompleteInput;
-      uint8_t value = decodeHex(digit);
-      if (value > 0x0F)
-        return DeserializationError::InvalidInput;
-      result = uint16_t((result << 4) | value);
-      move();
-    }
+    ParsedNumber<Float, UInt> num;
+    DeserializationError err = readNumber(num);
+    if (err)
+      return err;
+    result.setNumber(num);
     return DeserializationError::Ok;
   }
 
-  static inline bool isBetween(char c, char min, char max) {
-    return min <= c && c <= max;
-  }
-
-  static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z') || c == '+' || c == '-' || c == '.';
-  }
-
-  static inline bool isQuote(char c) {
-    return c == '\'' || c == '\"';
-  }
-
-  static inline uint8_t decodeHex(char c) {
-    if (c < 'A')
-      return uint8_t(c - '0');
-    c = char(c & ~0x20);  // uppercase
-    return uint8_t(c - 'A' + 10);
-  }
-
-  DeserializationError skipSpacesAndComments() {
+  // The value must be the last one of its line
+  DeserializationError skipLineEnd() {
     for (;;) {
       switch (current()) {
-        // end of string
         case '\0':
-          return DeserializationError::IncompleteInput;
+          return DeserializationError::Ok;
+
+        case '\n':
+          move();
+          return DeserializationError::Ok;
 
-        // spaces
         case ' ':
         case '\t':
         case '\r':
-        case '\n':
           move();
           continue;
 
-#if ARDUINOJSON_ENABLE_COMMENTS
-        // comments
-        case '/':
-          move();  // skip '/'
-          switch (current()) {
-            // block comment
-            case '*': {
-              move();  // skip '*'
-              bool wasStar = false;
-              for (;;) {
-                char c = current();
-                if (c == '\0')
-                  return DeserializationError::IncompleteInput;
-                if (c == '/' && wasStar) {
-                  move();
-                  break;
-                }
-                wasStar = c == '*';
-                move();
-              }
-              break;
-            }
-
-            // trailing comment
-            case '/':
-              // no need to skip "//"
-              for (;;) {
-                move();
-                char c = current();
-                if (c == '\0')
-                  return DeserializationError::IncompleteInput;
-                if (c == '\n')
-                  break;
-              }
-              break;
-
-            // not a comment, just a '/'
-            default:
-              return DeserializationError::InvalidInput;
-          }
-          break;
-#endif
-
         default:
-          return DeserializationError::Ok;
+          return DeserializationError::InvalidInput;
       }
     }
   }
 
+  void skipLine() {
+    for (;;) {
+      char c = current();
+      if (c == '\0')
+        return;
+      move();
+      if (c == '\n')
+        return;
+    }
+  }
+
   MemoryPool *_pool;
   TStringStorage _stringStorage;
-  Latch<TReader> _latch;
 };
 
 // deserializeJson(JsonDocument&, const std::string&, ...)
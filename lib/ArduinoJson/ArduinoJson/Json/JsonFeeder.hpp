@@ -0,0 +1,442 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonTokenizer.hpp>
+#include <ArduinoJson/Memory/StringBuilder.hpp>
+#include <ArduinoJson/Polyfills/mpl/max.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Deserializes a JSON document that arrives in chunks, like the TCP segments
+// of an HTTP answer: feed() parses the bytes it's given and returns, it never
+// waits for the next ones.
+// Instead of recursing like JsonDeserializer, it keeps the open arrays and
+// objects in a stack (see StaticJsonFeeder), so it can stop after any byte
+// and resume with the next chunk. It doesn't support filters.
+// CAUTION: while a string is parsed, it takes all the free space of the pool,
+// so don't modify the document before feed() returns Done.
+class JsonFeeder {
+ public:
+  enum Status { NeedMoreData, Done, Failed };
+
+  // Parses the bytes of the next chunk; once the value is complete, it
+  // returns Done and ignores the remaining bytes, like a NUL.
+  // As with deserializeJson(), a number at the root must end the input: it
+  // completes on finish() or a NUL, and any other byte fails with
+  // InvalidInput.
+  Status feed(const char *data, size_t length) {
+    const char *end = data + length;
+    while (data < end && _state < STATE_DONE) {
+      if ((_state == STATE_STRING && _decoder.acceptsRun()) ||
+          _state == STATE_TOKEN) {
+        data = readRun(data, end);
+        if (data == end)
+          break;
+      }
+      if (consume(*data))
+        data++;
+    }
+    return status();
+  }
+
+  // Tells that the input ended: completes a number or a keyword, otherwise
+  // fails with IncompleteInput.
+  Status finish() {
+    if (_state == STATE_TOKEN && !_comment)
+      endToken(true);
+    if (_state < STATE_DONE)
+      fail(_comment == COMMENT_SLASH ? DeserializationError::InvalidInput
+                                     : DeserializationError::IncompleteInput);
+    return status();
+  }
+
+  Status status() const {
+    switch (_state) {
+      case STATE_DONE:
+        return Done;
+      case STATE_FAILED:
+        return Failed;
+      default:
+        return NeedMoreData;
+    }
+  }
+
+  DeserializationError error() const {
+    return _error;
+  }
+
+ protected:
+  struct Frame {
+    CollectionData *collection;
+    bool isObject;
+    bool hasDuplicateKeys;
+  };
+
+  JsonFeeder(JsonDocument &doc, Frame *stack, uint8_t maxDepth)
+      : _pool(&doc.memoryPool()),
+        _stack(stack),
+        _maxDepth(maxDepth),
+        _depth(0),
+        _state(STATE_VALUE),
+        _comment(COMMENT_NONE),
+        _error(DeserializationError::Ok) {
+    doc.clear();
+    _root = &doc.data();
+    _variant = _root;
+  }
+
+ private:
+  JsonFeeder(const JsonFeeder &);             // cannot be copied
+  JsonFeeder &operator=(const JsonFeeder &);  // cannot be assigned
+
+  enum {
+    STATE_VALUE,          // before a value
+    STATE_FIRST_ELEMENT,  // after '[': a value or ']'
+    STATE_FIRST_KEY,      // after '{': a key or '}'
+    STATE_KEY,            // after ',' in an object
+    STATE_COLON,
+    STATE_AFTER_VALUE,  // ',' or the closing bracket
+    STATE_STRING,
+    STATE_TOKEN,  // a number, true, false, null, or a non-quoted key
+    STATE_DONE,
+    STATE_FAILED
+  };
+
+  enum {
+    COMMENT_NONE,
+    COMMENT_SLASH,  // after the first '/'
+    COMMENT_BLOCK,
+    COMMENT_BLOCK_STAR,  // after a '*' in a block comment
+    COMMENT_LINE
+  };
+
+  // Returns false if c must be consumed again, in the new state
+  bool consume(char c) {
+    if (c == '\0') {
+      finish();
+      return true;
+    }
+
+    switch (_state) {
+      case STATE_STRING:
+        return consumeString(c);
+
+      case STATE_TOKEN:
+        if (canBeInNonQuotedString(c)) {
+          _string.append(c);
+          return true;
+        }
+        endToken(false);
+        if (_state == STATE_DONE && _root->isFloat())
+          return fail(DeserializationError::InvalidInput);  // see feed()
+        return false;
+    }
+
+    if (skipSpaceOrComment(c))
+      return true;
+
+    switch (_state) {
+      case STATE_FIRST_ELEMENT:
+        if (c == ']')
+          return endCollection(c);
+        return beginValue(c);
+
+      case STATE_FIRST_KEY:
+        if (c == '}')
+          return endCollection(c);
+        return beginKey(c);
+
+      case STATE_KEY:
+        return beginKey(c);
+
+      case STATE_COLON:
+        if (c != ':')
+          return fail(DeserializationError::InvalidInput);
+        _state = STATE_VALUE;
+        return true;
+
+      case STATE_AFTER_VALUE:
+        if (c == ',') {
+          _state = _stack[_depth - 1].isObject ? STATE_KEY : STATE_VALUE;
+          return true;
+        }
+        if (c == ']' || c == '}')
+          return endCollection(c);
+        return fail(DeserializationError::InvalidInput);
+
+      default:  // STATE_VALUE
+        return beginValue(c);
+    }
+  }
+
+  bool skipSpaceOrComment(char c) {
+    switch (_comment) {
+      case COMMENT_NONE:
+        switch (c) {
+          case ' ':
+          case '\t':
+          case '\r':
+          case '\n':
+            return true;
+#if ARDUINOJSON_ENABLE_COMMENTS
+          case '/':
+            _comment = COMMENT_SLASH;
+            return true;
+#endif
+          default:
+            return false;
+        }
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+      case COMMENT_SLASH:
+        if (c == '*')
+          _comment = COMMENT_BLOCK;
+        else if (c == '/')
+          _comment = COMMENT_LINE;
+        else
+          fail(DeserializationError::InvalidInput);  // not a comment
+        return true;
+
+      case COMMENT_BLOCK:
+        if (c == '*')
+          _comment = COMMENT_BLOCK_STAR;
+        return true;
+
+      case COMMENT_BLOCK_STAR:
+        if (c == '/')
+          _comment = COMMENT_NONE;
+        else if (c != '*')
+          _comment = COMMENT_BLOCK;
+        return true;
+
+      case COMMENT_LINE:
+        if (c == '\n')
+          _comment = COMMENT_NONE;
+        return true;
+#endif
+
+      default:
+        return false;
+    }
+  }
+
+  bool beginValue(char c) {
+    if (c != '[' && c != '{' && !isQuote(c) && !canBeInNonQuotedString(c))
+      return fail(DeserializationError::InvalidInput);
+
+    VariantData *variant = addValue();
+    if (!variant)
+      return fail(DeserializationError::NoMemory);
+
+    switch (c) {
+      case '[':
+      case '{': {
+        if (_depth == _maxDepth)
+          return fail(DeserializationError::TooDeep);
+        Frame &frame = _stack[_depth++];
+        frame.isObject = c == '{';
+        frame.collection =
+            frame.isObject ? &variant->toObject() : &variant->toArray();
+        frame.hasDuplicateKeys = false;
+        _state = frame.isObject ? STATE_FIRST_KEY : STATE_FIRST_ELEMENT;
+        return true;
+      }
+
+      case '\"':
+      case '\'':
+        _variant = variant;
+        beginString(c);
+        return true;
+
+      default:
+        _variant = variant;
+        _string = StringBuilder(_pool);
+        _state = STATE_TOKEN;
+        return false;
+    }
+  }
+
+  // Returns the variant of the root, of a new element, or of the member
+  // named _key
+  VariantData *addValue() {
+    if (!_depth)
+      return _root;
+    Frame &frame = _stack[_depth - 1];
+    if (!frame.isObject)
+      return frame.collection->addElement(_pool);
+
+    VariantData *variant = frame.collection->getMember(adaptString(_key));
+    if (variant) {
+      // see JsonDeserializer::parseObject()
+      frame.hasDuplicateKeys = true;
+      return variant;
+    }
+    VariantSlot *slot = frame.collection->addSlot(_pool);
+    if (!slot)
+      return 0;
+    slot->setOwnedKey(make_not_null(_key));
+    return slot->data();
+  }
+
+  bool beginKey(char c) {
+    _variant = 0;  // the string is a key
+    if (isQuote(c)) {
+      beginString(c);
+      return true;
+    }
+    if (!canBeInNonQuotedString(c))
+      return fail(DeserializationError::InvalidInput);
+    _string = StringBuilder(_pool);
+    _state = STATE_TOKEN;
+    return false;
+  }
+
+  bool endCollection(char c) {
+    Frame &frame = _stack[_depth - 1];
+    if (frame.isObject != (c == '}'))
+      return fail(DeserializationError::InvalidInput);
+#if ARDUINOJSON_PACK_COLLECTIONS
+    if (!frame.hasDuplicateKeys)
+      frame.collection->pack(_pool);
+#endif
+    _depth--;
+    endValue();
+    return true;
+  }
+
+  void endValue() {
+    _state = _depth ? STATE_AFTER_VALUE : STATE_DONE;
+  }
+
+  void beginString(char quote) {
+    _decoder = JsonStringDecoder(quote);
+    _string = StringBuilder(_pool);
+    _state = STATE_STRING;
+  }
+
+  // Appends the characters of the string that need no unescaping, or the
+  // characters of the token, and returns the next one
+  const char *readRun(const char *data, const char *end) {
+    const char *run = data;
+    if (_state == STATE_STRING) {
+      BoundedReader<const char *> reader(data, size_t(end - data));
+      size_t n;
+      reader.readStringRun(_decoder.quote(), _decoder.validator(), n);
+      data += n;
+    } else {
+      while (data < end && canBeInNonQuotedString(*data)) data++;
+    }
+    if (data != run)
+      _string.append(run, size_t(data - run));
+    return data;
+  }
+
+  bool consumeString(char c) {
+    DeserializationError err = _decoder.append(c, _string);
+    if (err)
+      return fail(err);
+    return _decoder.ended() ? endString() : true;
+  }
+
+  bool endString() {
+    const char *s = _string.complete();
+    if (!s)
+      return fail(DeserializationError::NoMemory);
+    if (_variant) {
+      _variant->setOwnedString(make_not_null(s));
+      endValue();
+    } else {
+      _key = s;
+      _state = STATE_COLON;
+    }
+    return true;
+  }
+
+  void endToken(bool inputEnded) {
+    const char *token = _string.complete();
+    if (!token) {
+      fail(DeserializationError::NoMemory);
+      return;
+    }
+    if (!_variant) {
+      _key = token;
+      _state = STATE_COLON;
+      return;
+    }
+    DeserializationError err = parseToken(token, *_variant, inputEnded);
+    _pool->reclaimLastString(token);
+    if (err)
+      fail(err);
+    else
+      endValue();
+  }
+
+  static DeserializationError parseToken(const char *token,
+                                         VariantData &result,
+                                         bool inputEnded) {
+    switch (token[0]) {
+      case 't':
+        result.setBoolean(true);
+        return checkKeyword(token, "true", inputEnded);
+      case 'f':
+        result.setBoolean(false);
+        return checkKeyword(token, "false", inputEnded);
+      case 'n':  // the variant is already null
+        return checkKeyword(token, "null", inputEnded);
+    }
+
+    Latch<Reader<const char *> > latch((Reader<const char *>(token)));
+    ParsedNumber<Float, UInt> num;
+    DeserializationError err = scanNumberToken(latch, num);
+    if (err)
+      return err;
+    result.setNumber(num);
+    return DeserializationError::Ok;
+  }
+
+  // Like JsonTokenizer::skipKeyword()
+  static DeserializationError checkKeyword(const char *token,
+                                           const char *keyword,
+                                           bool inputEnded) {
+    KeywordMatcher matcher(keyword);
+    for (; *token; token++) matcher.append(*token);
+    return matcher.complete(inputEnded);
+  }
+
+  bool fail(DeserializationError err) {
+    _error = err;
+    _state = STATE_FAILED;
+    return true;
+  }
+
+  MemoryPool *_pool;
+  VariantData *_root;
+  Frame *_stack;
+  uint8_t _maxDepth;
+  uint8_t _depth;
+  uint8_t _state;
+  uint8_t _comment;
+  VariantData *_variant;  // receives the value, null while reading a key
+  const char *_key;       // the key of the next member
+  StringBuilder _string;
+  JsonStringDecoder _decoder;
+  DeserializationError _error;
+};
+
+// A JsonFeeder for up to maxDepth nested arrays and objects, like the
+// NestingLimit of deserializeJson(); each level takes one Frame.
+template <uint8_t maxDepth = ARDUINOJSON_DEFAULT_NESTING_LIMIT>
+class StaticJsonFeeder : public JsonFeeder {
+ public:
+  explicit StaticJsonFeeder(JsonDocument &doc)
+      : JsonFeeder(doc, _frames, maxDepth) {}
+
+ private:
+  Frame _frames[Max<1, maxDepth>::value];
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
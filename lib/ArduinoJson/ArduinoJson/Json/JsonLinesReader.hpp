@@ -0,0 +1,77 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/Filter.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Document/JsonDocument.hpp>
+#include <ArduinoJson/Json/JsonDeserializer.hpp>
+#include <ArduinoJson/StringStorage/StringStorage.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Reads a sequence of JSON documents, one per line (JSON Lines, or NDJSON),
+// into the same JsonDocument:
+//
+//   JsonLinesReader<std::istream> lines(doc, file);
+//   while (!lines.atEnd()) {
+//     DeserializationError err = lines.read();
+//     ...
+//   }
+//
+// The deserializer lives as long as the reader, so the input is read in a
+// single pass, and the character after a number isn't lost. The blank lines
+// are skipped. A document may span several lines, like a pretty-printed one,
+// but it must end its line. After an error, read() skips the rest of the
+// line, so that the next documents can still be read.
+// TInput is any input of deserializeJson(), except a char* with a size.
+template <typename TInput>
+class JsonLinesReader {
+  typedef JsonDeserializer<Reader<TInput>,
+                           typename StringStorage<TInput>::type>
+      deserializer_type;
+
+ public:
+  // Streams: std::istream, Stream...
+  JsonLinesReader(JsonDocument &doc, TInput &input)
+      : _doc(&doc),
+        _deserializer(doc.memoryPool(), Reader<TInput>(input),
+                      makeStringStorage(doc.memoryPool(), input)) {}
+
+  // Strings: std::string, String, const char*, char*...
+  JsonLinesReader(JsonDocument &doc, const TInput &input)
+      : _doc(&doc),
+        _deserializer(doc.memoryPool(), Reader<TInput>(input),
+                      makeStringStorage(doc.memoryPool(), input)) {}
+
+  // Skips the blank lines, and tells if there is no document left
+  bool atEnd() {
+    return _deserializer.atEnd();
+  }
+
+  // Replaces the content of the document with the next one
+  DeserializationError read(NestingLimit nestingLimit = NestingLimit()) {
+    _doc->clear();
+    return _deserializer.parseLine(_doc->data(), AllowAllFilter(),
+                                   nestingLimit);
+  }
+
+  DeserializationError read(Filter filter,
+                            NestingLimit nestingLimit = NestingLimit()) {
+    _doc->clear();
+    return _deserializer.parseLine(_doc->data(), filter, nestingLimit);
+  }
+
+ private:
+  JsonLinesReader(const JsonLinesReader &);             // cannot be copied
+  JsonLinesReader &operator=(const JsonLinesReader &);  // cannot be assigned
+
+  JsonDocument *_doc;
+  deserializer_type _deserializer;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
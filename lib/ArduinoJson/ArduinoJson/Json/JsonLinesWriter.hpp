@@ -0,0 +1,94 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Json/JsonSerializer.hpp>
+#include <ArduinoJson/Json/JsonStructSerializer.hpp>
+#include <ArduinoJson/Misc/Visitable.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Serialization/Writers/BufferingWriter.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Writes a sequence of JSON documents, one per line (JSON Lines, or NDJSON),
+// that JsonLinesReader reads back.
+// The buffer of a std::ostream, or of a buffered Print, is kept from one
+// document to the next, so that the short documents of a log are sent in
+// blocks.
+// serializeJson() escapes the line breaks of the strings, so each document
+// takes one line, unless a serialized() value contains one.
+template <typename TDestination>
+class JsonLinesWriter {
+  typedef Writer<TDestination> direct_writer_type;
+  typedef typename conditional<IsBufferedDestination<TDestination>::value,
+                               BufferingWriter<direct_writer_type>,
+                               direct_writer_type>::type writer_type;
+
+  template <typename TWriter>
+  struct serializer {
+#if ARDUINOJSON_HAS_CONSTEXPR
+    typedef JsonStructSerializer<TWriter> type;
+#else
+    typedef JsonSerializer<TWriter> type;
+#endif
+  };
+
+ public:
+  explicit JsonLinesWriter(TDestination &destination)
+      : _writer((direct_writer_type(destination))), _serializer(_writer) {}
+
+  ~JsonLinesWriter() {
+    flush();
+  }
+
+  // JsonDocument, JsonVariantConst, JsonObjectConst...
+  template <typename T>
+  typename enable_if<IsVisitable<T>::value>::type write(const T &value) {
+    emit(value);
+  }
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+  template <typename T>
+  typename enable_if<IsBoundStruct<T>::value>::type write(const T &object) {
+    emit(StructSource<T>(object));
+  }
+#endif
+
+  // Returns the number of bytes written, including those still in the buffer
+  // of a buffered destination
+  size_t bytesWritten() const {
+    return _serializer.bytesWritten();
+  }
+
+  // Sends the bytes still in the buffer of a buffered destination; the
+  // destructor does it too
+  void flush() {
+    flushWriter(_writer);
+  }
+
+ private:
+  JsonLinesWriter(const JsonLinesWriter &);             // cannot be copied
+  JsonLinesWriter &operator=(const JsonLinesWriter &);  // cannot be assigned
+
+  template <typename TWriter, size_t N>
+  static void flushWriter(BufferingWriter<TWriter, N> &writer) {
+    writer.flush();
+  }
+
+  template <typename TWriter>
+  static void flushWriter(TWriter &) {}
+
+  template <typename TSource>
+  void emit(const TSource &source) {
+    source.accept(_serializer);
+    _serializer.visitRawJson("\n", 1);  // counted in bytesWritten()
+  }
+
+  writer_type _writer;
+  typename serializer<writer_type &>::type _serializer;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
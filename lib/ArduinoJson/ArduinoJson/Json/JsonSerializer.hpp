@@ -62,8 +62,13 @@ class JsonSerializer {
     _formatter.writeString(value);
   }
 
+  // The bin and ext values of deserializeMsgPack() are raw values too, but
+  // binary: they are written as null
   void visitRawJson(const char *data, size_t n) {
-    _formatter.writeRaw(data, n);
+    if (n && isMsgPackBinary(uint8_t(data[0])))
+      _formatter.writeRaw("null");
+    else
+      _formatter.writeRaw(data, n);
   }
 
   void visitNegativeInteger(UInt value) {
@@ -87,6 +92,11 @@ class JsonSerializer {
   }
 
  protected:
+  // The header codes of bin and ext; a JSON value never starts with them
+  static bool isMsgPackBinary(uint8_t code) {
+    return (code >= 0xc4 && code <= 0xc9) || (code >= 0xd4 && code <= 0xd8);
+  }
+
   void write(char c) {
     _formatter.writeRaw(c);
   }
@@ -100,17 +110,20 @@ class JsonSerializer {
 };
 
 template <typename TSource, typename TDestination>
-size_t serializeJson(const TSource &source, TDestination &destination) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type serializeJson(
+    const TSource &source, TDestination &destination) {
   return serialize<JsonSerializer>(source, destination);
 }
 
 template <typename TSource>
-size_t serializeJson(const TSource &source, void *buffer, size_t bufferSize) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type serializeJson(
+    const TSource &source, void *buffer, size_t bufferSize) {
   return serialize<JsonSerializer>(source, buffer, bufferSize);
 }
 
 template <typename TSource>
-size_t measureJson(const TSource &source) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type measureJson(
+    const TSource &source) {
   return measure<JsonSerializer>(source);
 }
 
@@ -0,0 +1,256 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+inline bool isJsonSpace(int c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Checks the first character of a value
+inline DeserializationError sniffFirstChar(int c) {
+  if (c <= 0)
+    return DeserializationError::IncompleteInput;
+  switch (c) {
+    case '[':
+    case '{':
+    case '\"':
+    case '\'':
+    case '-':
+    case '+':
+    case '.':
+    case 't':  // true
+    case 'f':  // false
+    case 'n':  // null
+#if ARDUINOJSON_ENABLE_NAN
+    case 'N':
+#endif
+#if ARDUINOJSON_ENABLE_INFINITY
+    case 'I':
+#endif
+#if ARDUINOJSON_ENABLE_COMMENTS
+    case '/':  // can't look further in a stream
+#endif
+      return DeserializationError::Ok;
+  }
+  if (c >= '0' && c <= '9')
+    return DeserializationError::Ok;
+  return DeserializationError::InvalidInput;
+}
+
+// Tells quickly if an input can be JSON, before deserializeJson() clears the
+// document and starts allocating in it: an HTML page from a captive portal
+// fails on its first byte.
+// It checks that the input starts with a value, and that the brackets and the
+// quotes of this value are balanced. It doesn't check the scalars, the
+// commas, nor the colons, so deserializeJson() can still fail.
+template <typename TReader>
+class JsonSniffer {
+ public:
+  JsonSniffer(TReader reader) : _reader(reader) {}
+
+  DeserializationError sniff(NestingLimit nestingLimit) {
+    int c = skipSpacesAndComments(read());
+    if (c == '[' || c == '{')
+      return skipBrackets(c, nestingLimit);
+    if (c == '\"' || c == '\'')
+      return skipString(char(c));
+    if (c == '/')
+      return DeserializationError::InvalidInput;
+    return sniffFirstChar(c);
+  }
+
+ private:
+  int read() {
+    return _reader.read();
+  }
+
+  // Returns the first character after the spaces and the comments
+  int skipSpacesAndComments(int c) {
+    for (;;) {
+      if (isJsonSpace(c)) {
+        c = read();
+        continue;
+      }
+#if ARDUINOJSON_ENABLE_COMMENTS
+      if (c == '/') {
+        c = read();
+        if (c == '*') {
+          // skip until the end of the block comment
+          for (bool star = false;;) {
+            c = read();
+            if (c <= 0 || (star && c == '/'))
+              break;
+            star = c == '*';
+          }
+        } else if (c == '/') {
+          // skip until the end of the line
+          do c = read();
+          while (c > 0 && c != '\n');
+        } else {
+          return '/';  // not a comment
+        }
+        if (c <= 0)
+          return 0;
+        c = read();
+        continue;
+      }
+#endif
+      return c;
+    }
+  }
+
+  // Reads until the bracket that closes the first one, keeping one bit per
+  // level: 1 for an object, 0 for an array
+  DeserializationError skipBrackets(int c, NestingLimit nestingLimit) {
+    uint8_t objects[32] = {0};  // the 255 levels of a NestingLimit
+    uint8_t depth = 0;
+    uint8_t maxDepth = 0;
+    for (; !nestingLimit.reached(); nestingLimit = nestingLimit.decrement())
+      maxDepth++;
+    for (;;) {
+      c = skipSpacesAndComments(c);
+      switch (c) {
+        case '[':
+        case '{':
+          if (depth == maxDepth)
+            return DeserializationError::TooDeep;
+          if (c == '{')
+            objects[depth / 8] |= uint8_t(1 << (depth % 8));
+          else
+            objects[depth / 8] &= uint8_t(~(1 << (depth % 8)));
+          depth++;
+          break;
+
+        case ']':
+        case '}': {
+          if (depth == 0)
+            return DeserializationError::InvalidInput;
+          depth--;
+          bool isObject = (objects[depth / 8] >> (depth % 8)) & 1;
+          if (isObject != (c == '}'))
+            return DeserializationError::InvalidInput;
+          if (depth == 0)
+            return DeserializationError::Ok;
+          break;
+        }
+
+        case '\"':
+        case '\'': {
+          DeserializationError err = skipString(char(c));
+          if (err)
+            return err;
+          break;
+        }
+
+        case '/':  // not a comment
+          return DeserializationError::InvalidInput;
+
+        default:
+          if (c <= 0)
+            return DeserializationError::IncompleteInput;
+          break;
+      }
+      c = read();
+    }
+  }
+
+  DeserializationError skipString(char quote) {
+    for (;;) {
+      skipStringRun(quote,
+                    integral_constant<bool, IsRamReader<TReader>::value>());
+      int c = read();
+      if (c == quote)
+        return DeserializationError::Ok;
+      if (c <= 0)
+        return DeserializationError::IncompleteInput;
+      if (c == '\\' && read() <= 0)
+        return DeserializationError::IncompleteInput;
+    }
+  }
+
+  void skipStringRun(char quote, true_type) {
+    Utf8::NoValidator validator;
+    size_t n;
+    _reader.readStringRun(quote, validator, n);
+  }
+
+  void skipStringRun(char, false_type) {}
+
+  TReader _reader;
+};
+
+// sniffJson() returns InvalidInput, TooDeep, or IncompleteInput when
+// deserializeJson() is sure to fail, and Ok otherwise. How far it looks
+// depends on the input:
+// - strings and char buffers: the whole first value, so unbalanced brackets
+//   and quotes are caught;
+// - streams: only the first character of the value (see below), so a body
+//   that starts right but is cut or unbalanced still gives Ok, and fails
+//   later in deserializeJson().
+
+// sniffJson(const std::string&, NestingLimit)
+// sniffJson(const String&, NestingLimit)
+template <typename TString>
+typename enable_if<!is_array<TString>::value, DeserializationError>::type
+sniffJson(const TString &input, NestingLimit nestingLimit = NestingLimit()) {
+  return JsonSniffer<Reader<TString> >(Reader<TString>(input))
+      .sniff(nestingLimit);
+}
+
+// sniffJson(char*, NestingLimit)
+// sniffJson(const char*, NestingLimit)
+template <typename TChar>
+DeserializationError sniffJson(TChar *input,
+                               NestingLimit nestingLimit = NestingLimit()) {
+  return JsonSniffer<Reader<TChar *> >(Reader<TChar *>(input))
+      .sniff(nestingLimit);
+}
+
+// sniffJson(char*, size_t, NestingLimit)
+// sniffJson(const char*, size_t, NestingLimit)
+template <typename TChar>
+DeserializationError sniffJson(TChar *input, size_t inputSize,
+                               NestingLimit nestingLimit = NestingLimit()) {
+  return JsonSniffer<BoundedReader<TChar *> >(
+             BoundedReader<TChar *>(input, inputSize))
+      .sniff(nestingLimit);
+}
+
+// A stream can't go back, so sniffJson() only peeks at the first character of
+// the value, after consuming the spaces before it; the comments are not
+// skipped, '/' is accepted when ARDUINOJSON_ENABLE_COMMENTS is set.
+#if ARDUINOJSON_ENABLE_STD_STREAM
+// sniffJson(std::istream&)
+template <typename TStream>
+typename enable_if<is_base_of<std::istream, TStream>::value,
+                   DeserializationError>::type
+sniffJson(TStream &input) {
+  while (isJsonSpace(input.peek())) input.get();
+  return sniffFirstChar(input.peek());
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_ARDUINO_STREAM
+// sniffJson(Stream&)
+// CAUTION: only sees the bytes already received, and fails with
+// IncompleteInput if there is none yet.
+template <typename TStream>
+typename enable_if<is_base_of<Stream, TStream>::value,
+                   DeserializationError>::type
+sniffJson(TStream &input) {
+  while (isJsonSpace(input.peek())) input.read();
+  return sniffFirstChar(input.peek());
+}
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
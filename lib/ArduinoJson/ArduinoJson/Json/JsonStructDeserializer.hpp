@@ -0,0 +1,297 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/FieldFunctions.hpp>
+#include <ArduinoJson/Binding/FixedStringBuilder.hpp>
+#include <ArduinoJson/Binding/StructBinding.hpp>
+#include <ArduinoJson/Json/JsonTokenizer.hpp>
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Parses a JSON object directly into a bound struct, without a JsonDocument.
+// Unknown keys are skipped, and values of the wrong type leave the member
+// untouched. An array member keeps the first elements, up to its capacity,
+// and its count member tells how many the JSON array had, so it can exceed
+// the capacity; a string longer than its member gives NoMemory.
+template <typename TReader>
+class JsonStructDeserializer : JsonTokenizer<TReader> {
+  typedef JsonTokenizer<TReader> base;
+
+  using base::current;
+  using base::eat;
+  using base::move;
+  using base::readNonQuotedString;
+  using base::readNumber;
+  using base::readQuotedString;
+  using base::skipArray;
+  using base::skipKeyword;
+  using base::skipObject;
+  using base::skipSpacesAndComments;
+  using base::skipString;
+  using base::skipVariant;
+
+ public:
+  JsonStructDeserializer(TReader reader) : base(reader) {}
+
+  DeserializationError parse(const StructBinding &binding, void *object,
+                             NestingLimit nestingLimit) {
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (current() != '{')
+      return DeserializationError::InvalidInput;
+
+    return parseStruct(binding, static_cast<char *>(object), nestingLimit);
+  }
+
+ private:
+  DeserializationError parseStruct(const StructBinding &binding, char *object,
+                                   NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Parse key
+      char key[ARDUINOJSON_BINDING_KEY_SIZE];
+      FixedStringBuilder keyBuilder(key, sizeof(key));
+      err = parseKey(keyBuilder);
+      if (err)
+        return err;
+      const FieldBinding *field =
+          keyBuilder.complete() ? binding.find(key, keyBuilder.size()) : 0;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      // Parse or skip value
+      if (field)
+        err = parseField(*field, object, nestingLimit.decrement());
+      else
+        err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+    }
+  }
+
+  DeserializationError parseField(const FieldBinding &field, char *object,
+                                  NestingLimit nestingLimit) {
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    if (!field.isArray())
+      return parseElement(field, object + field.offset, nestingLimit);
+
+    if (current() != '[')
+      return skipVariant(nestingLimit);
+
+    return parseArray(field, object, nestingLimit);
+  }
+
+  DeserializationError parseArray(const FieldBinding &field, char *object,
+                                  NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Skip spaces
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    size_t count = 0;
+
+    // Read each value
+    if (!eat(']')) {
+      for (;;) {
+        // 1 - Parse value, or skip it if the member is full
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+        if (count < field.capacity)
+          err = parseElement(field, object + field.offset + count * field.size,
+                             nestingLimit.decrement());
+        else
+          err = skipVariant(nestingLimit.decrement());
+        count++;
+        if (err)
+          return err;
+
+        // 2 - Skip spaces
+        err = skipSpacesAndComments();
+        if (err)
+          return err;
+
+        // 3 - More values?
+        if (eat(']'))
+          break;
+        if (!eat(','))
+          return DeserializationError::InvalidInput;
+      }
+    }
+
+    if (field.hasCount())
+      fieldSetCount(object + field.countOffset, field.countType, count);
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError parseElement(const FieldBinding &field, char *value,
+                                    NestingLimit nestingLimit) {
+    switch (current()) {
+      case '[':
+        return skipArray(nestingLimit);
+
+      case '{':
+        if (field.type == FIELD_IS_STRUCT)
+          return parseStruct(field.nestedBinding(), value, nestingLimit);
+        else
+          return skipObject(nestingLimit);
+
+      case '\"':
+      case '\'':
+        if (field.type == FIELD_IS_STRING)
+          return parseStringValue(value, field.size);
+        else
+          return skipString();
+
+      default:
+        return parseNumericValue(field.type, value);
+    }
+  }
+
+  DeserializationError parseStringValue(char *value, size_t capacity) {
+    FixedStringBuilder builder(value, capacity);
+    DeserializationError err = readQuotedString(builder);
+    if (err)
+      return err;
+    if (!builder.complete())
+      return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError parseKey(FixedStringBuilder &builder) {
+    if (isQuote(current())) {
+      return readQuotedString(builder);
+    } else {
+      return readNonQuotedString(builder);
+    }
+  }
+
+  DeserializationError parseNumericValue(uint8_t type, char *value) {
+    switch (current()) {
+      case 't':  // true
+        fieldSetBoolean(value, type, true);
+        return skipKeyword("true");
+      case 'f':  // false
+        fieldSetBoolean(value, type, false);
+        return skipKeyword("false");
+      case 'n':  // null
+        // the member keeps its value
+        return skipKeyword("null");
+    }
+
+    ParsedNumber<Float, UInt> num;
+    DeserializationError err = readNumber(num);
+    if (err)
+      return err;
+    fieldSetNumber(value, type, num);
+    return DeserializationError::Ok;
+  }
+};
+
+template <typename TReader>
+DeserializationError deserializeStruct(const StructBinding &binding,
+                                       void *object, TReader reader,
+                                       NestingLimit nestingLimit) {
+  return JsonStructDeserializer<TReader>(reader).parse(binding, object,
+                                                       nestingLimit);
+}
+
+// deserializeJson(TStruct&, const std::string&, ...)
+template <typename TStruct, typename TInput>
+typename enable_if<IsBoundStruct<TStruct>::value &&
+                       !is_array<TInput>::value,
+                   DeserializationError>::type
+deserializeJson(TStruct &object, const TInput &input,
+                NestingLimit nestingLimit = NestingLimit()) {
+  return deserializeStruct(structBindingOf<TStruct>(), &object,
+                           Reader<TInput>(input), nestingLimit);
+}
+
+// deserializeJson(TStruct&, std::istream&, ...)
+template <typename TStruct, typename TInput>
+typename enable_if<IsBoundStruct<TStruct>::value, DeserializationError>::type
+deserializeJson(TStruct &object, TInput &input,
+                NestingLimit nestingLimit = NestingLimit()) {
+  return deserializeStruct(structBindingOf<TStruct>(), &object,
+                           Reader<TInput>(input), nestingLimit);
+}
+
+// deserializeJson(TStruct&, char*, ...)
+template <typename TStruct, typename TChar>
+typename enable_if<IsBoundStruct<TStruct>::value, DeserializationError>::type
+deserializeJson(TStruct &object, TChar *input,
+                NestingLimit nestingLimit = NestingLimit()) {
+  return deserializeStruct(structBindingOf<TStruct>(), &object,
+                           Reader<TChar *>(input), nestingLimit);
+}
+
+// deserializeJson(TStruct&, char*, size_t, ...)
+template <typename TStruct, typename TChar>
+typename enable_if<IsBoundStruct<TStruct>::value, DeserializationError>::type
+deserializeJson(TStruct &object, TChar *input, size_t inputSize,
+                NestingLimit nestingLimit = NestingLimit()) {
+  return deserializeStruct(structBindingOf<TStruct>(), &object,
+                           BoundedReader<TChar *>(input, inputSize),
+                           nestingLimit);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
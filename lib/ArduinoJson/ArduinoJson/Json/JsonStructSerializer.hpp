@@ -0,0 +1,76 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/FieldFunctions.hpp>
+#include <ArduinoJson/Binding/StructSource.hpp>
+#include <ArduinoJson/Json/JsonSerializer.hpp>
+#include <ArduinoJson/Serialization/measure.hpp>
+#include <ArduinoJson/Serialization/serialize.hpp>
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+namespace ARDUINOJSON_NAMESPACE {
+
+template <typename TWriter>
+class JsonStructSerializer : public JsonSerializer<TWriter> {
+  typedef JsonSerializer<TWriter> base;
+
+ public:
+  JsonStructSerializer(TWriter writer) : base(writer) {}
+
+  void visitStruct(const StructBinding &binding, const void *object) {
+    base::write('{');
+
+    for (uint8_t i = 0; i < binding.count; i++) {
+      const FieldBinding &field = binding.fields[i];
+      const char *value = static_cast<const char *>(object) + field.offset;
+
+      if (i > 0)
+        base::write(',');
+      base::visitString(field.name);
+      base::write(':');
+
+      if (field.isArray()) {
+        base::write('[');
+        size_t n = fieldArraySize(field, object);
+        for (size_t j = 0; j < n; j++) {
+          if (j > 0)
+            base::write(',');
+          fieldAccept(field, value + j * field.size, *this);
+        }
+        base::write(']');
+      } else {
+        fieldAccept(field, value, *this);
+      }
+    }
+
+    base::write('}');
+  }
+};
+
+template <typename TStruct, typename TDestination>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type serializeJson(
+    const TStruct &source, TDestination &destination) {
+  return serialize<JsonStructSerializer>(StructSource<TStruct>(source),
+                                         destination);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type serializeJson(
+    const TStruct &source, void *buffer, size_t bufferSize) {
+  return serialize<JsonStructSerializer>(StructSource<TStruct>(source),
+                                         buffer, bufferSize);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type measureJson(
+    const TStruct &source) {
+  return measure<JsonStructSerializer>(StructSource<TStruct>(source));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
@@ -0,0 +1,493 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Deserialization/DeserializationError.hpp>
+#include <ArduinoJson/Deserialization/NestingLimit.hpp>
+#include <ArduinoJson/Deserialization/Reader.hpp>
+#include <ArduinoJson/Json/EscapeSequence.hpp>
+#include <ArduinoJson/Json/Latch.hpp>
+#include <ArduinoJson/Json/Utf16.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
+#include <ArduinoJson/Numbers/parseNumber.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The characters of numbers, keywords, and keys without quotes
+inline bool canBeInNonQuotedString(char c) {
+  return ('0' <= c && c <= '9') || ('_' <= c && c <= 'z') ||
+         ('A' <= c && c <= 'Z') || c == '+' || c == '-' || c == '.';
+}
+
+inline bool isQuote(char c) {
+  return c == '\'' || c == '\"';
+}
+
+// Returns a value above 0x0F if c is not a hexadecimal digit
+inline uint8_t decodeHex(char c) {
+  if (c < 'A')
+    return uint8_t(c - '0');
+  c = char(c & ~0x20);  // uppercase
+  return uint8_t(c - 'A' + 10);
+}
+
+// Compares a token with a keyword, one character at a time. The token is
+// incomplete if the input ends while it still matches the beginning of the
+// keyword, and invalid if it differs or goes on after it.
+class KeywordMatcher {
+ public:
+  explicit KeywordMatcher(const char *keyword)
+      : _rest(keyword), _matches(true) {}
+
+  void append(char c) {
+    if (_matches && *_rest == c)
+      _rest++;
+    else
+      _matches = false;
+  }
+
+  DeserializationError complete(bool inputEnded) const {
+    if (_matches && !*_rest)
+      return DeserializationError::Ok;
+    if (_matches && inputEnded)
+      return DeserializationError::IncompleteInput;
+    return DeserializationError::InvalidInput;
+  }
+
+ private:
+  const char *_rest;
+  bool _matches;
+};
+
+// Reads a number, which must not be followed by a letter or a digit
+template <typename TLatch>
+inline DeserializationError scanNumberToken(TLatch &latch,
+                                            ParsedNumber<Float, UInt> &num) {
+  num = scanNumber<Float, UInt>(latch);
+  if (canBeInNonQuotedString(latch.current()) || num.type() == VALUE_IS_NULL)
+    return DeserializationError::InvalidInput;
+  return DeserializationError::Ok;
+}
+
+// Decodes a quoted string one character at a time, after the opening quote:
+// the escape sequences, \uXXXX, and the UTF-8 validation. JsonTokenizer
+// pulls the characters from its reader, JsonFeeder pushes those of each
+// chunk.
+class JsonStringDecoder {
+ public:
+#if ARDUINOJSON_VALIDATE_UTF8
+  typedef Utf8::Validator Validator;
+#else
+  typedef Utf8::NoValidator Validator;
+#endif
+
+  explicit JsonStringDecoder(char quote = '\"')
+      : _quote(quote), _state(STATE_STRING) {
+#if ARDUINOJSON_DECODE_UNICODE
+    _codeunit = 0;
+    _hexDigits = 0;
+#endif
+  }
+
+  char quote() const {
+    return _quote;
+  }
+
+  // True when the next characters can be copied up to the next quote or
+  // backslash, with Latch::readStringRun() and validator()
+  bool acceptsRun() const {
+    return _state == STATE_STRING;
+  }
+
+  Validator &validator() {
+    return _validator;
+  }
+
+  bool ended() const {
+    return _state == STATE_ENDED;
+  }
+
+  // Appends the decoded character, if any, to the builder
+  template <typename TBuilder>
+  DeserializationError append(char c, TBuilder &builder) {
+    switch (_state) {
+      case STATE_STRING:
+        if (c == _quote) {
+          _state = STATE_ENDED;
+          if (!_validator.complete())
+            return DeserializationError::InvalidUtf8;
+          return DeserializationError::Ok;
+        }
+        if (!_validator.append(c))
+          return DeserializationError::InvalidUtf8;
+        if (c == '\\')
+          _state = STATE_ESCAPE;
+        else
+          builder.append(c);
+        return DeserializationError::Ok;
+
+      case STATE_ESCAPE:
+        if (c == 'u') {
+#if ARDUINOJSON_DECODE_UNICODE
+          _hexDigits = 0;
+          _codeunit = 0;
+          _state = STATE_HEX;
+          return DeserializationError::Ok;
+#else
+          return DeserializationError::NotSupported;
+#endif
+        }
+        c = EscapeSequence::unescapeChar(c);
+        if (c == '\0')
+          return DeserializationError::InvalidInput;
+        builder.append(c);
+        _state = STATE_STRING;
+        return DeserializationError::Ok;
+
+#if ARDUINOJSON_DECODE_UNICODE
+      case STATE_HEX: {
+        uint8_t value = decodeHex(c);
+        if (value > 0x0F)
+          return DeserializationError::InvalidInput;
+        _codeunit = uint16_t((_codeunit << 4) | value);
+        if (++_hexDigits == 4) {
+          if (_codepoint.append(_codeunit))
+            Utf8::encodeCodepoint(_codepoint.value(), builder);
+          _state = STATE_STRING;
+        }
+        return DeserializationError::Ok;
+      }
+#endif
+
+      default:  // STATE_ENDED
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+ private:
+  enum {
+    STATE_STRING,
+    STATE_ESCAPE,  // after a backslash
+    STATE_HEX,     // in \uXXXX, after _hexDigits digits
+    STATE_ENDED
+  };
+
+  char _quote;
+  uint8_t _state;
+  Validator _validator;
+#if ARDUINOJSON_DECODE_UNICODE
+  Utf16::Codepoint _codepoint;
+  uint16_t _codeunit;
+  uint8_t _hexDigits;
+#endif
+};
+
+// Reads the tokens of a JSON document from a Latch: spaces and comments,
+// strings, keywords, and numbers, and skips the values that aren't needed.
+// JsonDeserializer and JsonStructDeserializer derive from it; JsonFeeder,
+// which is fed instead of reading, shares the functions and classes above.
+template <typename TReader>
+class JsonTokenizer {
+ protected:
+  JsonTokenizer(TReader reader) : _latch(reader) {}
+
+  char current() {
+    return _latch.current();
+  }
+
+  void move() {
+    _latch.clear();
+  }
+
+  bool eat(char charToSkip) {
+    if (current() != charToSkip)
+      return false;
+    move();
+    return true;
+  }
+
+  // Appends the string to the builder, without the quotes
+  template <typename TBuilder>
+  DeserializationError readQuotedString(TBuilder &builder) {
+    JsonStringDecoder decoder(current());
+    move();
+    do {
+      if (decoder.acceptsRun()) {
+        size_t n;
+        const char *run =
+            readStringRun(decoder.quote(), decoder.validator(), n);
+        if (n)
+          builder.append(run, n);
+      }
+
+      char c = current();
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      move();
+
+      DeserializationError err = decoder.append(c, builder);
+      if (err)
+        return err;
+    } while (!decoder.ended());
+
+    return DeserializationError::Ok;
+  }
+
+  // Appends a key without quotes to the builder
+  template <typename TBuilder>
+  DeserializationError readNonQuotedString(TBuilder &builder) {
+    char c = current();
+    ARDUINOJSON_ASSERT(c);
+
+    if (!canBeInNonQuotedString(c))
+      return DeserializationError::InvalidInput;
+
+    do {
+      move();
+      builder.append(c);
+      c = current();
+    } while (canBeInNonQuotedString(c));
+
+    return DeserializationError::Ok;
+  }
+
+  // Returns the characters that need no unescaping, when the input is in RAM
+  template <typename TValidator>
+  const char *readStringRun(char stopChar, TValidator &validator, size_t &n) {
+    typedef integral_constant<bool, IsRamReader<TReader>::value> in_ram;
+    return readStringRun(stopChar, validator, n, in_ram());
+  }
+
+  template <typename TValidator>
+  const char *readStringRun(char stopChar, TValidator &validator, size_t &n,
+                            true_type) {
+    return _latch.readStringRun(stopChar, validator, n);
+  }
+
+  template <typename TValidator>
+  const char *readStringRun(char, TValidator &, size_t &n, false_type) {
+    n = 0;
+    return 0;
+  }
+
+  // Skips true, false, or null; see KeywordMatcher
+  DeserializationError skipKeyword(const char *keyword) {
+    KeywordMatcher matcher(keyword);
+    while (canBeInNonQuotedString(current())) {
+      matcher.append(current());
+      move();
+    }
+    return matcher.complete(current() == '\0');
+  }
+
+  DeserializationError readNumber(ParsedNumber<Float, UInt> &num) {
+    return scanNumberToken(_latch, num);
+  }
+
+  DeserializationError skipVariant(NestingLimit nestingLimit) {
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    switch (current()) {
+      case '[':
+        return skipArray(nestingLimit);
+
+      case '{':
+        return skipObject(nestingLimit);
+
+      case '\"':
+      case '\'':
+        return skipString();
+
+      default:
+        return skipNumericValue();
+    }
+  }
+
+  DeserializationError skipArray(NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening braket
+    ARDUINOJSON_ASSERT(current() == '[');
+    move();
+
+    // Read each value
+    for (;;) {
+      // 1 - Skip value
+      DeserializationError err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // 2 - Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // 3 - More values?
+      if (eat(']'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError skipObject(NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    // Skip opening brace
+    ARDUINOJSON_ASSERT(current() == '{');
+    move();
+
+    // Skip spaces
+    DeserializationError err = skipSpacesAndComments();
+    if (err)
+      return err;
+
+    // Empty object?
+    if (eat('}'))
+      return DeserializationError::Ok;
+
+    // Read each key value pair
+    for (;;) {
+      // Skip key
+      err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // Colon
+      if (!eat(':'))
+        return DeserializationError::InvalidInput;
+
+      // Skip value
+      err = skipVariant(nestingLimit.decrement());
+      if (err)
+        return err;
+
+      // Skip spaces
+      err = skipSpacesAndComments();
+      if (err)
+        return err;
+
+      // More keys/values?
+      if (eat('}'))
+        return DeserializationError::Ok;
+      if (!eat(','))
+        return DeserializationError::InvalidInput;
+    }
+  }
+
+  DeserializationError skipString() {
+    const char stopChar = current();
+
+    Utf8::NoValidator validator;
+    move();
+    for (;;) {
+      size_t n;
+      readStringRun(stopChar, validator, n);
+      char c = current();
+      move();
+      if (c == stopChar)
+        break;
+      if (c == '\0')
+        return DeserializationError::IncompleteInput;
+      if (c == '\\') {
+        if (current() != '\0')
+          move();
+      }
+    }
+
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError skipNumericValue() {
+    char c = current();
+    while (canBeInNonQuotedString(c)) {
+      move();
+      c = current();
+    }
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError skipSpacesAndComments() {
+    for (;;) {
+      switch (current()) {
+        // end of string
+        case '\0':
+          return DeserializationError::IncompleteInput;
+
+        // spaces
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+          move();
+          continue;
+
+#if ARDUINOJSON_ENABLE_COMMENTS
+        // comments
+        case '/':
+          move();  // skip '/'
+          switch (current()) {
+            // block comment
+            case '*': {
+              move();  // skip '*'
+              bool wasStar = false;
+              for (;;) {
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '/' && wasStar) {
+                  move();
+                  break;
+                }
+                wasStar = c == '*';
+                move();
+              }
+              break;
+            }
+
+            // trailing comment
+            case '/':
+              // no need to skip "//"
+              for (;;) {
+                move();
+                char c = current();
+                if (c == '\0')
+                  return DeserializationError::IncompleteInput;
+                if (c == '\n')
+                  break;
+              }
+              break;
+
+            // not a comment, just a '/'
+            default:
+              return DeserializationError::InvalidInput;
+          }
+          break;
+#endif
+
+        default:
+          return DeserializationError::Ok;
+      }
+    }
+  }
+
+  Latch<TReader> _latch;
+
+ private:
+  JsonTokenizer &operator=(const JsonTokenizer &);  // non-copiable
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -32,6 +32,18 @@ class Latch {
     return _current;
   }
 
+  // Skips the characters of a string up to the next quote, backslash, or NUL,
+  // or up to the first one the validator rejects, and returns their address;
+  // only for the readers of a buffer in RAM
+  template <typename TValidator>
+  const char* readStringRun(char quote, TValidator& validator, size_t& n) {
+    if (_loaded) {
+      n = 0;
+      return 0;
+    }
+    return _reader.readStringRun(quote, validator, n);
+  }
+
  private:
   void load() {
     ARDUINOJSON_ASSERT(!_ended);
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Configuration.hpp>
 #include <ArduinoJson/Json/JsonSerializer.hpp>
+#include <ArduinoJson/Misc/Visitable.hpp>
 #include <ArduinoJson/Serialization/measure.hpp>
 #include <ArduinoJson/Serialization/serialize.hpp>
 
@@ -58,7 +59,7 @@ class PrettyJsonSerializer : public JsonSerializer<TWriter> {
     base::write("}");
   }
 
- private:
+ protected:
   void indent() {
     for (uint8_t i = 0; i < _nesting; i++) base::write(ARDUINOJSON_TAB);
   }
@@ -67,18 +68,20 @@ class PrettyJsonSerializer : public JsonSerializer<TWriter> {
 };
 
 template <typename TSource, typename TDestination>
-size_t serializeJsonPretty(const TSource &source, TDestination &destination) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type
+serializeJsonPretty(const TSource &source, TDestination &destination) {
   return serialize<PrettyJsonSerializer>(source, destination);
 }
 
 template <typename TSource>
-size_t serializeJsonPretty(const TSource &source, void *buffer,
-                           size_t bufferSize) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type
+serializeJsonPretty(const TSource &source, void *buffer, size_t bufferSize) {
   return serialize<PrettyJsonSerializer>(source, buffer, bufferSize);
 }
 
 template <typename TSource>
-size_t measureJsonPretty(const TSource &source) {
+typename enable_if<IsVisitable<TSource>::value, size_t>::type
+measureJsonPretty(const TSource &source) {
   return measure<PrettyJsonSerializer>(source);
 }
 
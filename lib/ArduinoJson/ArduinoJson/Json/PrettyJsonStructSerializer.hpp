@@ -0,0 +1,93 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/FieldFunctions.hpp>
+#include <ArduinoJson/Binding/StructSource.hpp>
+#include <ArduinoJson/Json/PrettyJsonSerializer.hpp>
+#include <ArduinoJson/Serialization/measure.hpp>
+#include <ArduinoJson/Serialization/serialize.hpp>
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Same layout as PrettyJsonSerializer: a member or an element per line
+template <typename TWriter>
+class PrettyJsonStructSerializer : public PrettyJsonSerializer<TWriter> {
+  typedef PrettyJsonSerializer<TWriter> base;
+
+ public:
+  PrettyJsonStructSerializer(TWriter &writer) : base(writer) {}
+
+  void visitStruct(const StructBinding &binding, const void *object) {
+    if (!binding.count)
+      return base::write("{}");
+
+    base::write("{\r\n");
+    base::_nesting++;
+    for (uint8_t i = 0; i < binding.count; i++) {
+      const FieldBinding &field = binding.fields[i];
+      const char *value = static_cast<const char *>(object) + field.offset;
+
+      base::indent();
+      base::visitString(field.name);
+      base::write(": ");
+
+      if (field.isArray())
+        visitFieldArray(field, value, object);
+      else
+        fieldAccept(field, value, *this);
+
+      base::write(i + 1 < binding.count ? ",\r\n" : "\r\n");
+    }
+    base::_nesting--;
+    base::indent();
+    base::write("}");
+  }
+
+ private:
+  void visitFieldArray(const FieldBinding &field, const char *value,
+                       const void *object) {
+    size_t n = fieldArraySize(field, object);
+    if (!n)
+      return base::write("[]");
+
+    base::write("[\r\n");
+    base::_nesting++;
+    for (size_t j = 0; j < n; j++) {
+      base::indent();
+      fieldAccept(field, value + j * field.size, *this);
+      base::write(j + 1 < n ? ",\r\n" : "\r\n");
+    }
+    base::_nesting--;
+    base::indent();
+    base::write("]");
+  }
+};
+
+template <typename TStruct, typename TDestination>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type
+serializeJsonPretty(const TStruct &source, TDestination &destination) {
+  return serialize<PrettyJsonStructSerializer>(StructSource<TStruct>(source),
+                                               destination);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type
+serializeJsonPretty(const TStruct &source, void *buffer, size_t bufferSize) {
+  return serialize<PrettyJsonStructSerializer>(StructSource<TStruct>(source),
+                                               buffer, bufferSize);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type
+measureJsonPretty(const TStruct &source) {
+  return measure<PrettyJsonStructSerializer>(StructSource<TStruct>(source));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
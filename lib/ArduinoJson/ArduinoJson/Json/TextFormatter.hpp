@@ -10,6 +10,7 @@
 #include <ArduinoJson/Json/EscapeSequence.hpp>
 #include <ArduinoJson/Numbers/FloatParts.hpp>
 #include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Numbers/ShortestFloat.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/attributes.hpp>
 
@@ -35,7 +36,24 @@ class TextFormatter {
   void writeString(const char *value) {
     ARDUINOJSON_ASSERT(value != NULL);
     writeRaw('\"');
+#if ARDUINOJSON_ESCAPE_TABLES
+    // write the runs of characters that don't need escaping in one call
+    const char *begin = value;
+    for (; *value; value++) {
+      char specialChar = EscapeSequence::escapeChar(*value);
+      if (!specialChar)
+        continue;
+      if (value > begin)
+        writeRaw(begin, value);
+      writeRaw('\\');
+      writeRaw(specialChar);
+      begin = value + 1;
+    }
+    if (value > begin)
+      writeRaw(begin, value);
+#else
     while (*value) writeChar(*value++);
+#endif
     writeRaw('\"');
   }
 
@@ -72,6 +90,14 @@ class TextFormatter {
     }
 #endif
 
+#if ARDUINOJSON_SHORTEST_FLOATS
+    if (value == 0)
+      return writeRaw('0');
+
+    writeShortestFloat(ShortestFloat<T>(value),
+                       value >= ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD ||
+                           value <= ARDUINOJSON_NEGATIVE_EXPONENTIATION_THRESHOLD);
+#else
     FloatParts<T> parts(value);
 
     writePositiveInteger(parts.integral);
@@ -87,6 +113,44 @@ class TextFormatter {
       writeRaw('e');
       writePositiveInteger(parts.exponent);
     }
+#endif
+  }
+
+  template <typename T>
+  void writeShortestFloat(const ShortestFloat<T> &parts, bool scientific) {
+    // buffer should be big enough for 0.0000 and all digits
+    char buffer[32];
+    char *end = buffer;
+
+    // position of the decimal point, from the first digit
+    int point = parts.length + parts.exponent;
+
+    if (scientific || point < -8 || point > 12) {
+      *end++ = parts.digits[0];
+      if (parts.length > 1) {
+        *end++ = '.';
+        for (int i = 1; i < parts.length; i++) *end++ = parts.digits[i];
+      }
+      writeRaw(buffer, end);
+      writeRaw(point > 0 ? "e" : "e-");
+      writePositiveInteger(point > 0 ? point - 1 : 1 - point);
+      return;
+    }
+
+    if (point <= 0) {
+      *end++ = '0';
+      *end++ = '.';
+      while (point++ < 0) *end++ = '0';
+      for (int i = 0; i < parts.length; i++) *end++ = parts.digits[i];
+    } else {
+      for (int i = 0; i < point; i++)
+        *end++ = i < parts.length ? parts.digits[i] : '0';
+      if (point < parts.length) {
+        *end++ = '.';
+        for (int i = point; i < parts.length; i++) *end++ = parts.digits[i];
+      }
+    }
+    writeRaw(buffer, end);
   }
 
   void writeNegativeInteger(UInt value) {
@@ -6,6 +6,10 @@
 
 #include <ArduinoJson/Namespace.hpp>
 
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, uint32_t
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 namespace Utf8 {
@@ -42,5 +46,107 @@ inline void encodeCodepoint(uint32_t codepoint32, TStringBuilder& str) {
     str.append(*p);
   }
 }
+
+// Checks that a sequence of bytes, possibly cut in several pieces, is valid
+// UTF-8: no overlong forms, no surrogates, nothing above U+10FFFF
+class Validator {
+ public:
+  Validator() : _remaining(0), _lower(0x80), _upper(0xBF) {}
+
+  bool append(char c) {
+    uint8_t b = static_cast<uint8_t>(c);
+    if (!_remaining)
+      return b < 0x80 || begin(b);
+    if (b < _lower || b > _upper)
+      return false;
+    _lower = 0x80;
+    _upper = 0xBF;
+    _remaining--;
+    return true;
+  }
+
+  bool append(const char* s, size_t n) {
+    const char* end = s + n;
+    while (s < end) {
+      if (!_remaining) {
+        s = skipAscii(s, end);
+        if (s == end)
+          break;
+        // two-byte sequences (Latin, Greek, Cyrillic...) in one step
+        uint8_t b = static_cast<uint8_t>(*s);
+        if (b >= 0xC2 && b < 0xE0 && end - s >= 2 &&
+            (static_cast<uint8_t>(s[1]) & 0xC0) == 0x80) {
+          s += 2;
+          continue;
+        }
+      }
+      if (!append(*s++))
+        return false;
+    }
+    return true;
+  }
+
+  // Returns false if the last sequence is unfinished
+  bool complete() const {
+    return _remaining == 0;
+  }
+
+ private:
+  bool begin(uint8_t b) {
+    if (b < 0xC2 || b > 0xF4)
+      return false;
+    if (b < 0xE0) {
+      _remaining = 1;
+    } else if (b < 0xF0) {
+      _remaining = 2;
+      if (b == 0xE0)
+        _lower = 0xA0;  // overlong
+      else if (b == 0xED)
+        _upper = 0x9F;  // surrogate
+    } else {
+      _remaining = 3;
+      if (b == 0xF0)
+        _lower = 0x90;  // overlong
+      else if (b == 0xF4)
+        _upper = 0x8F;  // above U+10FFFF
+    }
+    return true;
+  }
+
+  // Skips the ASCII characters, a word at a time
+  static const char* skipAscii(const char* s, const char* end) {
+    const size_t highBits = size_t(-1) / 0xFF * 0x80;
+    while (size_t(end - s) >= sizeof(size_t)) {
+      size_t word;
+      memcpy(&word, s, sizeof(word));
+      if (word & highBits)
+        break;
+      s += sizeof(word);
+    }
+    while (s < end && static_cast<uint8_t>(*s) < 0x80) s++;
+    return s;
+  }
+
+  uint8_t _remaining;
+  uint8_t _lower;
+  uint8_t _upper;
+};
+
+// Accepts everything, when the strings are not validated
+class NoValidator {
+ public:
+  bool append(char) {
+    return true;
+  }
+
+  bool complete() const {
+    return true;
+  }
+};
+
+inline bool isValid(const char* s, size_t n) {
+  Validator validator;
+  return validator.append(s, n) && validator.complete();
+}
 }  // namespace Utf8
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -16,19 +16,35 @@ namespace ARDUINOJSON_NAMESPACE {
 
 // _begin                                   _end
 // v                                           v
-// +-------------+--------------+--------------+
-// | strings...  |   (free)     |  ...variants |
-// +-------------+--------------+--------------+
+// +-------------+--------------+--------------+------+
+// | strings...  |   (free)     |  ...variants | root |
+// +-------------+--------------+--------------+------+
 //               ^              ^
 //             _left          _right
+//
+// The root variant is only stored here with ARDUINOJSON_COMPACT_SLOTS, so that
+// its pointers can be offsets too; it's not part of the capacity.
 
 class MemoryPool {
  public:
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Bytes to allocate on top of the capacity
+  static const size_t overhead = sizeof(VariantSlot);
+
+  // The offsets must reach every byte of the pool from the root
+  static const size_t maxCapacity =
+      ((size_t(1) << (sizeof(SlotOffset) * 8 - 1)) - 1 - overhead) &
+      ~(sizeof(void*) - 1);
+#else
+  static const size_t overhead = 0;
+#endif
+
+  // buf must hold capa + overhead bytes
   MemoryPool(char* buf, size_t capa)
       : _begin(buf),
         _left(buf),
-        _right(buf ? buf + capa : 0),
-        _end(buf ? buf + capa : 0) {
+        _right(buf ? buf + limitCapacity(capa) : 0),
+        _end(buf ? buf + limitCapacity(capa) : 0) {
     ARDUINOJSON_ASSERT(isAligned(_begin));
     ARDUINOJSON_ASSERT(isAligned(_right));
     ARDUINOJSON_ASSERT(isAligned(_end));
@@ -47,6 +63,23 @@ class MemoryPool {
     return size_t(_left - _begin + _end - _right);
   }
 
+  // Gets the number of bytes taken by the strings
+  size_t stringsSize() const {
+    return size_t(_left - _begin);
+  }
+
+  // Gets the number of bytes taken by the variants
+  size_t variantsSize() const {
+    return size_t(_end - _right);
+  }
+
+#if ARDUINOJSON_COMPACT_SLOTS
+  // Returns the root variant, or null if there is no buffer
+  VariantData* root() const {
+    return _end ? reinterpret_cast<VariantSlot*>(_end)->data() : 0;
+  }
+#endif
+
   VariantSlot* allocVariant() {
     return allocRight<VariantSlot>();
   }
@@ -92,6 +125,29 @@ class MemoryPool {
     return _begin <= p && p < _end;
   }
 
+  // Returns the variant allocated last (the one with the lowest address)
+  VariantSlot* lastVariant() const {
+    return reinterpret_cast<VariantSlot*>(_right);
+  }
+
+  // Returns the slot above the first variant allocated
+  VariantSlot* variantsEnd() const {
+    return reinterpret_cast<VariantSlot*>(_end);
+  }
+
+  // Frees the variants below slot, which becomes the last variant
+  void reclaimVariantsBelow(VariantSlot* slot) {
+    _right = reinterpret_cast<char*>(slot);
+    checkInvariants();
+  }
+
+  // Returns the free space as an array of n variants, without allocating it
+  VariantSlot* scratchVariants(size_t n) const {
+    if (!canAlloc(n * sizeof(VariantSlot)))
+      return 0;
+    return reinterpret_cast<VariantSlot*>(_right) - n;
+  }
+
   template <typename T>
   T* allocRight() {
     return reinterpret_cast<T*>(allocRight(sizeof(T)));
@@ -126,7 +182,7 @@ class MemoryPool {
       return 0;
 
     size_t right_size = static_cast<size_t>(_end - _right);
-    memmove(new_right, _right, right_size);
+    memmove(new_right, _right, right_size + overhead);
 
     ptrdiff_t bytes_reclaimed = _right - new_right;
     _right = new_right;
@@ -144,6 +200,14 @@ class MemoryPool {
   }
 
  private:
+  static size_t limitCapacity(size_t capa) {
+#if ARDUINOJSON_COMPACT_SLOTS
+    return capa < maxCapacity ? capa : maxCapacity;
+#else
+    return capa;
+#endif
+  }
+
   StringSlot* allocStringSlot() {
     return allocRight<StringSlot>();
   }
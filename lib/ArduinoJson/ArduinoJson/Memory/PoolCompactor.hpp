@@ -0,0 +1,203 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Memory/MemoryPool.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memmove
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Removes, in place, the strings and the slots that the root can't reach
+// anymore (removed members, overwritten values...)
+//
+// Before:  | s0 xx s1 xx |   (free)   | xx v1 xx v0 |
+// After:   | s0 s1 |        (free)          | v1 v0 |
+//
+// The live slots slide toward _end and the live strings toward _begin. They
+// keep their order, so packed collections remain packed.
+// There is no room for mark bits, so each pass walks the tree to find the next
+// batch of live slots (or strings) in address order: it takes O(n^2) time, but
+// no memory besides a batch on the stack. Like copyFrom(), the walk recurses
+// once per nesting level.
+class PoolCompactor {
+ public:
+  PoolCompactor(MemoryPool* pool, VariantData* root)
+      : _pool(pool), _root(root) {}
+
+  // Returns the number of bytes recovered
+  size_t compact() {
+    size_t usedBefore = _pool->size();
+    compactVariants();
+    compactStrings();
+    return usedBefore - _pool->size();
+  }
+
+ private:
+  static const size_t batchSize = 8;
+
+  struct LiveVariant {
+    VariantSlot* slot;
+    VariantSlot* previous;  // null for the head
+    VariantData* parent;
+  };
+
+  struct LiveString {
+    const char* address;
+    size_t size;
+  };
+
+  static CollectionData* collectionOf(VariantData* var) {
+    return var->isArray() ? var->asArray() : var->asObject();
+  }
+
+  void compactVariants() {
+    VariantSlot* cursor = _pool->variantsEnd();
+    VariantSlot* limit = cursor;
+    for (;;) {
+      LiveVariant batch[batchSize];
+      size_t count = 0;
+      findVariants(_root, limit, batch, count);
+      if (!count)
+        break;
+      for (size_t i = 0; i < count; i++) {
+        VariantSlot* from = batch[i].slot;
+        VariantSlot* to = --cursor;
+        limit = from;
+        if (to == from)
+          continue;
+        moveVariant(batch[i], to);
+        for (size_t j = i + 1; j < count; j++) {
+          if (batch[j].previous == from)
+            batch[j].previous = to;
+          if (batch[j].parent == from->data())
+            batch[j].parent = to->data();
+        }
+      }
+    }
+    _pool->reclaimVariantsBelow(cursor);
+  }
+
+  // Collects the live slots below limit, highest first
+  void findVariants(VariantData* parent, VariantSlot* limit, LiveVariant* batch,
+                    size_t& count) {
+    CollectionData* collection = collectionOf(parent);
+    if (!collection)
+      return;
+    VariantSlot* previous = 0;
+    for (VariantSlot* s = collection->head(); s; s = s->next()) {
+      if (s < limit && (count < batchSize || s > batch[count - 1].slot)) {
+        size_t i = count < batchSize ? count++ : count - 1;
+        for (; i > 0 && batch[i - 1].slot < s; i--) batch[i] = batch[i - 1];
+        batch[i].slot = s;
+        batch[i].previous = previous;
+        batch[i].parent = parent;
+      }
+      findVariants(s->data(), limit, batch, count);
+      previous = s;
+    }
+  }
+
+  void moveVariant(const LiveVariant& var, VariantSlot* to) {
+    VariantSlot* from = var.slot;
+    VariantSlot* next = from->next();
+    *to = *from;
+    to->setNext(next);
+    to->movePointers((to - from) * ptrdiff_t(sizeof(VariantSlot)), 0, 0);
+    if (var.previous)
+      var.previous->setNextNotNull(to);
+    collectionOf(var.parent)->slotMoved(from, to);
+  }
+
+  void compactStrings() {
+    char* cursor = static_cast<char*>(_pool->buffer());
+    const char* limit = cursor;
+    for (;;) {
+      LiveString batch[batchSize];
+      size_t count = 0;
+      findStrings(_root, limit, batch, count);
+      if (!count)
+        break;
+      char* moved[batchSize];
+      for (size_t i = 0; i < count; i++) {
+        memmove(cursor, batch[i].address, batch[i].size);
+        moved[i] = cursor;
+        cursor += batch[i].size;
+      }
+      const LiveString& last = batch[count - 1];
+      // the empty raw values don't move the cursor, so skip one byte
+      limit = last.address + (last.size ? last.size : 1);
+      updateStrings(_root, batch, moved, count);
+    }
+    _pool->reclaimLastString(cursor);
+  }
+
+  // Collects the value of var, the keys of its members, and so on
+  void findStrings(VariantData* var, const char* limit, LiveString* batch,
+                   size_t& count) {
+    if (const char* value = var->ownedString())
+      addString(value, var->memoryUsage(), limit, batch, count);
+    CollectionData* collection = collectionOf(var);
+    if (!collection)
+      return;
+    for (VariantSlot* s = collection->head(); s; s = s->next()) {
+      if (s->ownsKey())
+        addString(s->key(), strlen(s->key()) + 1, limit, batch, count);
+      findStrings(s->data(), limit, batch, count);
+    }
+  }
+
+  // Collects the strings above limit, lowest first
+  void addString(const char* address, size_t size, const char* limit,
+                 LiveString* batch, size_t& count) {
+    // strings parsed in place are outside of the pool
+    if (address < limit || !_pool->owns(const_cast<char*>(address)))
+      return;
+    size_t i = 0;
+    while (i < count && batch[i].address < address) i++;
+    if (i < count && batch[i].address == address) {
+      // an empty raw value may share its address with the next string
+      if (size > batch[i].size)
+        batch[i].size = size;
+      return;
+    }
+    if (i == batchSize)
+      return;
+    if (count < batchSize)
+      count++;
+    for (size_t j = count - 1; j > i; j--) batch[j] = batch[j - 1];
+    batch[i].address = address;
+    batch[i].size = size;
+  }
+
+  void updateStrings(VariantData* var, const LiveString* batch,
+                     char* const* moved, size_t count) {
+    if (const char* value = var->ownedString())
+      var->movePointers(0, distance(value, batch, moved, count), 0);
+    CollectionData* collection = collectionOf(var);
+    if (!collection)
+      return;
+    for (VariantSlot* s = collection->head(); s; s = s->next()) {
+      if (s->ownsKey())
+        s->moveKey(distance(s->key(), batch, moved, count));
+      updateStrings(s->data(), batch, moved, count);
+    }
+  }
+
+  static ptrdiff_t distance(const char* address, const LiveString* batch,
+                            char* const* moved, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      if (batch[i].address == address)
+        return moved[i] - address;
+    }
+    return 0;
+  }
+
+  MemoryPool* _pool;
+  VariantData* _root;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -6,10 +6,18 @@
 
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringBuilder {
  public:
+  // A builder that appends nothing, until a real one is assigned to it
+  StringBuilder() : _parent(0), _size(0) {
+    _slot.value = 0;
+    _slot.size = 0;
+  }
+
   explicit StringBuilder(MemoryPool* parent) : _parent(parent), _size(0) {
     _slot = _parent->allocExpandableString();
   }
@@ -19,7 +27,16 @@ class StringBuilder {
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0) append(*s++);
+    if (!_slot.value)
+      return;
+
+    if (n > _slot.size - _size) {
+      _slot.value = 0;
+      return;
+    }
+
+    memcpy(_slot.value + _size, s, n);
+    _size += n;
   }
 
   void append(char c) {
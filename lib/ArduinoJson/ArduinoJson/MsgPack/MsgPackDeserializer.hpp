@@ -5,12 +5,16 @@
 #pragma once
 
 #include <ArduinoJson/Deserialization/deserialize.hpp>
+#include <ArduinoJson/Json/Utf8.hpp>
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/MsgPack/endianess.hpp>
 #include <ArduinoJson/MsgPack/ieee754.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/StringStorage/StringMover.hpp>
 #include <ArduinoJson/Variant/VariantData.hpp>
 
+#include <string.h>  // memcpy, memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename TReader, typename TStringStorage>
@@ -23,17 +27,51 @@ class MsgPackDeserializer {
                       TStringStorage stringStorage)
       : _pool(&pool), _reader(reader), _stringStorage(stringStorage) {}
 
-  // TODO: add support for filter
-  DeserializationError parse(VariantData &variant, AllowAllFilter,
+  template <typename TFilter>
+  DeserializationError parse(VariantData &variant, TFilter filter,
                              NestingLimit nestingLimit) {
-    return parse(variant, nestingLimit);
+    return parseVariant(variant, filter, nestingLimit);
   }
 
-  DeserializationError parse(VariantData &variant, NestingLimit nestingLimit) {
+ private:
+  // Prevent VS warning "assignment operator could not be generated"
+  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
+
+  template <typename TFilter>
+  DeserializationError parseVariant(VariantData &variant, TFilter filter,
+                                    NestingLimit nestingLimit) {
     uint8_t code;
     if (!readByte(code))
       return DeserializationError::IncompleteInput;
 
+    if ((code & 0xf0) == 0x90)
+      return readArray(variant, code & 0x0F, filter, nestingLimit);
+
+    if ((code & 0xf0) == 0x80)
+      return readObject(variant, code & 0x0F, filter, nestingLimit);
+
+    switch (code) {
+      case 0xdc:
+        return readArray<uint16_t>(variant, filter, nestingLimit);
+
+      case 0xdd:
+        return readArray<uint32_t>(variant, filter, nestingLimit);
+
+      case 0xde:
+        return readObject<uint16_t>(variant, filter, nestingLimit);
+
+      case 0xdf:
+        return readObject<uint32_t>(variant, filter, nestingLimit);
+    }
+
+    if (!filter.allowValue())
+      return skipValue(code);
+
+    return parseValue(variant, code);
+  }
+
+  // Everything but arrays and maps
+  DeserializationError parseValue(VariantData &variant, uint8_t code) {
     if ((code & 0x80) == 0) {
       variant.setUnsignedInteger(code);
       return DeserializationError::Ok;
@@ -49,14 +87,6 @@ class MsgPackDeserializer {
       return readString(variant, code & 0x1f);
     }
 
-    if ((code & 0xf0) == 0x90) {
-      return readArray(variant.toArray(), code & 0x0F, nestingLimit);
-    }
-
-    if ((code & 0xf0) == 0x80) {
-      return readObject(variant.toObject(), code & 0x0F, nestingLimit);
-    }
-
     switch (code) {
       case 0xc0:
         // already null
@@ -102,12 +132,38 @@ class MsgPackDeserializer {
         return DeserializationError::NotSupported;
 #endif
 
+      case 0xc4:
+        return readRaw<uint8_t>(variant, code, 0);
+
+      case 0xc5:
+        return readRaw<uint16_t>(variant, code, 0);
+
+      case 0xc6:
+        return readRaw<uint32_t>(variant, code, 0);
+
+      case 0xc7:
+        return readRaw<uint8_t>(variant, code, 1);
+
+      case 0xc8:
+        return readRaw<uint16_t>(variant, code, 1);
+
+      case 0xc9:
+        return readRaw<uint32_t>(variant, code, 1);
+
       case 0xca:
         return readFloat<float>(variant);
 
       case 0xcb:
         return readDouble<double>(variant);
 
+      case 0xd4:
+      case 0xd5:
+      case 0xd6:
+      case 0xd7:
+      case 0xd8:
+        // fixext: the type and 1, 2, 4, 8, or 16 bytes
+        return readRaw(variant, &code, 1, 1 + (size_t(1) << (code - 0xd4)));
+
       case 0xd9:
         return readString<uint8_t>(variant);
 
@@ -117,26 +173,160 @@ class MsgPackDeserializer {
       case 0xdb:
         return readString<uint32_t>(variant);
 
+      default:
+        return DeserializationError::NotSupported;
+    }
+  }
+
+  DeserializationError skipVariant(NestingLimit nestingLimit) {
+    uint8_t code;
+    if (!readByte(code))
+      return DeserializationError::IncompleteInput;
+
+    if ((code & 0xf0) == 0x90)
+      return skipCollection(code & 0x0F, 1, nestingLimit);
+
+    if ((code & 0xf0) == 0x80)
+      return skipCollection(code & 0x0F, 2, nestingLimit);
+
+    switch (code) {
       case 0xdc:
-        return readArray<uint16_t>(variant.toArray(), nestingLimit);
+        return skipCollection<uint16_t>(1, nestingLimit);
 
       case 0xdd:
-        return readArray<uint32_t>(variant.toArray(), nestingLimit);
+        return skipCollection<uint32_t>(1, nestingLimit);
 
       case 0xde:
-        return readObject<uint16_t>(variant.toObject(), nestingLimit);
+        return skipCollection<uint16_t>(2, nestingLimit);
 
       case 0xdf:
-        return readObject<uint32_t>(variant.toObject(), nestingLimit);
+        return skipCollection<uint32_t>(2, nestingLimit);
+
+      default:
+        return skipValue(code);
+    }
+  }
+
+  // Jumps over everything but arrays and maps, using the length prefixes
+  DeserializationError skipValue(uint8_t code) {
+    if ((code & 0x80) == 0 || (code & 0xe0) == 0xe0)
+      return DeserializationError::Ok;
+
+    if ((code & 0xe0) == 0xa0)
+      return skipBytes(code & 0x1f);
+
+    switch (code) {
+      case 0xc0:
+      case 0xc2:
+      case 0xc3:
+        return DeserializationError::Ok;
+
+      case 0xcc:
+      case 0xd0:
+        return skipBytes(1);
+
+      case 0xcd:
+      case 0xd1:
+        return skipBytes(2);
+
+      case 0xca:
+      case 0xce:
+      case 0xd2:
+        return skipBytes(4);
+
+      case 0xcb:
+      case 0xcf:
+      case 0xd3:
+        return skipBytes(8);
+
+      case 0xd4:
+      case 0xd5:
+      case 0xd6:
+      case 0xd7:
+      case 0xd8:
+        return skipBytes(1 + (size_t(1) << (code - 0xd4)));
+
+      case 0xc4:
+      case 0xd9:
+        return skipSizedBytes<uint8_t>(0);
+
+      case 0xc5:
+      case 0xda:
+        return skipSizedBytes<uint16_t>(0);
+
+      case 0xc6:
+      case 0xdb:
+        return skipSizedBytes<uint32_t>(0);
+
+      case 0xc7:
+        return skipSizedBytes<uint8_t>(1);
+
+      case 0xc8:
+        return skipSizedBytes<uint16_t>(1);
+
+      case 0xc9:
+        return skipSizedBytes<uint32_t>(1);
 
       default:
         return DeserializationError::NotSupported;
     }
   }
 
- private:
-  // Prevent VS warning "assignment operator could not be generated"
-  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
+  template <typename TSize>
+  DeserializationError skipSizedBytes(uint8_t extraBytes) {
+    TSize size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return skipBytes(size_t(size) + extraBytes);
+  }
+
+  DeserializationError skipBytes(size_t n) {
+    bool ok =
+        skipBytes(n, integral_constant<bool, IsRamReader<TReader>::value>());
+    return ok ? DeserializationError::Ok
+              : DeserializationError::IncompleteInput;
+  }
+
+  bool skipBytes(size_t n, true_type) {
+    return _reader.readSpan(n) != 0;
+  }
+
+  bool skipBytes(size_t n, false_type) {
+    char buffer[16];
+    while (n > 0) {
+      size_t chunk = n < sizeof(buffer) ? n : sizeof(buffer);
+      if (_reader.readBytes(buffer, chunk) != chunk)
+        return false;
+      n -= chunk;
+    }
+    return true;
+  }
+
+  template <typename TSize>
+  DeserializationError skipCollection(uint8_t valuesPerEntry,
+                                      NestingLimit nestingLimit) {
+    TSize size;
+    if (!readInteger(size))
+      return DeserializationError::IncompleteInput;
+    return skipCollection(size, valuesPerEntry, nestingLimit);
+  }
+
+  // valuesPerEntry is 1 for the arrays, and 2 (key and value) for the maps
+  DeserializationError skipCollection(size_t n, uint8_t valuesPerEntry,
+                                      NestingLimit nestingLimit) {
+    if (nestingLimit.reached())
+      return DeserializationError::TooDeep;
+
+    for (; n; --n) {
+      for (uint8_t i = 0; i < valuesPerEntry; i++) {
+        DeserializationError err = skipVariant(nestingLimit.decrement());
+        if (err)
+          return err;
+      }
+    }
+
+    return DeserializationError::Ok;
+  }
 
   bool readByte(uint8_t &value) {
     int c = _reader.read();
@@ -241,76 +431,205 @@ class MsgPackDeserializer {
   }
 
   DeserializationError readString(const char *&result, size_t n) {
-    StringBuilder builder = _stringStorage.startString();
+    return readString(result, n, _stringStorage);
+  }
+
+  // The input is writable: moves the string over its header, to make room
+  // for the terminator
+  DeserializationError readString(const char *&result, size_t n,
+                                  StringMover &) {
+    const char *span = _reader.readSpan(n);
+    if (!span)
+      return DeserializationError::IncompleteInput;
+#if ARDUINOJSON_VALIDATE_UTF8
+    if (!Utf8::isValid(span, n))
+      return DeserializationError::InvalidUtf8;
+#endif
+    char *s = const_cast<char *>(span) - 1;
+    memmove(s, span, n);
+    s[n] = 0;
+    result = s;
+    return DeserializationError::Ok;
+  }
+
+  template <typename TStorage>
+  DeserializationError readString(const char *&result, size_t n,
+                                  TStorage &storage) {
+    StringBuilder builder = storage.startString();
+    if (!appendBytes(builder, n))
+      return DeserializationError::IncompleteInput;
+    result = builder.complete();
+    if (!result)
+      return DeserializationError::NoMemory;
+#if ARDUINOJSON_VALIDATE_UTF8
+    if (!Utf8::isValid(result, n))
+      return DeserializationError::InvalidUtf8;
+#endif
+    return DeserializationError::Ok;
+  }
+
+  // Copies the next n bytes of the input
+  bool appendBytes(StringBuilder &builder, size_t n) {
+    return appendBytes(builder, n,
+                       integral_constant<bool, IsRamReader<TReader>::value>());
+  }
+
+  bool appendBytes(StringBuilder &builder, size_t n, true_type) {
+    const char *span = _reader.readSpan(n);
+    if (!span)
+      return false;
+    builder.append(span, n);
+    return true;
+  }
+
+  bool appendBytes(StringBuilder &builder, size_t n, false_type) {
     for (; n; --n) {
       uint8_t c;
       if (!readBytes(c))
-        return DeserializationError::IncompleteInput;
+        return false;
       builder.append(static_cast<char>(c));
     }
-    result = builder.complete();
-    if (!result)
+    return true;
+  }
+
+  // bin and ext are kept as raw values, header included, so that
+  // serializeMsgPack() writes them back unchanged; serializeJson() recognizes
+  // the header and writes null
+  template <typename TSize>
+  DeserializationError readRaw(VariantData &variant, uint8_t code,
+                               uint8_t extraBytes) {
+    uint8_t header[1 + sizeof(TSize)];
+    header[0] = code;
+    if (!readBytes(header + 1, sizeof(TSize)))
+      return DeserializationError::IncompleteInput;
+    TSize size;
+    memcpy(&size, header + 1, sizeof(TSize));
+    fixEndianess(size);
+    return readRaw(variant, header, sizeof(header), size_t(size) + extraBytes);
+  }
+
+  DeserializationError readRaw(VariantData &variant, const uint8_t *header,
+                               size_t headerSize, size_t n) {
+    return readRaw(variant, header, headerSize, n, _stringStorage);
+  }
+
+  // The input is writable: the raw value stays where it is
+  DeserializationError readRaw(VariantData &variant, const uint8_t *,
+                               size_t headerSize, size_t n, StringMover &) {
+    const char *span = _reader.readSpan(n);
+    if (!span)
+      return DeserializationError::IncompleteInput;
+    variant.setOwnedRaw(make_not_null(span - headerSize), headerSize + n);
+    return DeserializationError::Ok;
+  }
+
+  template <typename TStorage>
+  DeserializationError readRaw(VariantData &variant, const uint8_t *header,
+                               size_t headerSize, size_t n,
+                               TStorage &storage) {
+    StringBuilder builder = storage.startString();
+    builder.append(reinterpret_cast<const char *>(header), headerSize);
+    if (!appendBytes(builder, n))
+      return DeserializationError::IncompleteInput;
+    const char *data = builder.complete();
+    if (!data)
       return DeserializationError::NoMemory;
+    variant.setOwnedRaw(make_not_null(data), headerSize + n);
     return DeserializationError::Ok;
   }
 
-  template <typename TSize>
-  DeserializationError readArray(CollectionData &array,
+  template <typename TSize, typename TFilter>
+  DeserializationError readArray(VariantData &variant, TFilter filter,
                                  NestingLimit nestingLimit) {
     TSize size;
     if (!readInteger(size))
       return DeserializationError::IncompleteInput;
-    return readArray(array, size, nestingLimit);
+    return readArray(variant, size, filter, nestingLimit);
   }
 
-  DeserializationError readArray(CollectionData &array, size_t n,
-                                 NestingLimit nestingLimit) {
+  template <typename TFilter>
+  DeserializationError readArray(VariantData &variant, size_t n,
+                                 TFilter filter, NestingLimit nestingLimit) {
+    if (!filter.allowArray())
+      return skipCollection(n, 1, nestingLimit);
+
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
-    for (; n; --n) {
-      VariantData *value = array.addElement(_pool);
-      if (!value)
-        return DeserializationError::NoMemory;
+    CollectionData &array = variant.toArray();
+    TFilter memberFilter = filter[0UL];
 
-      DeserializationError err = parse(*value, nestingLimit.decrement());
+    for (; n; --n) {
+      DeserializationError err;
+      if (memberFilter.allow()) {
+        VariantData *value = array.addElement(_pool);
+        if (!value)
+          return DeserializationError::NoMemory;
+
+        err = parseVariant(*value, memberFilter, nestingLimit.decrement());
+      } else {
+        err = skipVariant(nestingLimit.decrement());
+      }
       if (err)
         return err;
     }
 
-    return DeserializationError::Ok;
+    return packCollection(array);
   }
 
-  template <typename TSize>
-  DeserializationError readObject(CollectionData &object,
+  template <typename TSize, typename TFilter>
+  DeserializationError readObject(VariantData &variant, TFilter filter,
                                   NestingLimit nestingLimit) {
     TSize size;
     if (!readInteger(size))
       return DeserializationError::IncompleteInput;
-    return readObject(object, size, nestingLimit);
+    return readObject(variant, size, filter, nestingLimit);
   }
 
-  DeserializationError readObject(CollectionData &object, size_t n,
-                                  NestingLimit nestingLimit) {
+  template <typename TFilter>
+  DeserializationError readObject(VariantData &variant, size_t n,
+                                  TFilter filter, NestingLimit nestingLimit) {
+    if (!filter.allowObject())
+      return skipCollection(n, 2, nestingLimit);
+
     if (nestingLimit.reached())
       return DeserializationError::TooDeep;
 
-    for (; n; --n) {
-      VariantSlot *slot = object.addSlot(_pool);
-      if (!slot)
-        return DeserializationError::NoMemory;
+    CollectionData &object = variant.toObject();
 
+    for (; n; --n) {
       const char *key = 0;  // <- mute "maybe-uninitialized" (+4 bytes on AVR)
       DeserializationError err = parseKey(key);
       if (err)
         return err;
-      slot->setOwnedKey(make_not_null(key));
 
-      err = parse(*slot->data(), nestingLimit.decrement());
+      TFilter memberFilter = filter[key];
+
+      if (memberFilter.allow()) {
+        VariantSlot *slot = object.addSlot(_pool);
+        if (!slot)
+          return DeserializationError::NoMemory;
+        slot->setOwnedKey(make_not_null(key));
+
+        err = parseVariant(*slot->data(), memberFilter,
+                           nestingLimit.decrement());
+      } else {
+        _stringStorage.reclaim(key);
+        err = skipVariant(nestingLimit.decrement());
+      }
       if (err)
         return err;
     }
 
+    return packCollection(object);
+  }
+
+  DeserializationError packCollection(CollectionData &collection) {
+#if ARDUINOJSON_PACK_COLLECTIONS
+    collection.pack(_pool);
+#else
+    (void)collection;
+#endif
     return DeserializationError::Ok;
   }
 
@@ -342,6 +661,13 @@ class MsgPackDeserializer {
   TStringStorage _stringStorage;
 };
 
+// With a writable char*, the strings, bin, and ext values stay in the input
+// (zero-copy): it must outlive the document. Other inputs are copied.
+// serializeJson() writes the bin and ext values as null.
+// With a Filter, the values it rejects are skipped using their length
+// prefixes, without storing them.
+
+// deserializeMsgPack(JsonDocument&, const std::string&, ...)
 template <typename TInput>
 DeserializationError deserializeMsgPack(
     JsonDocument &doc, const TInput &input,
@@ -349,28 +675,82 @@ DeserializationError deserializeMsgPack(
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
+template <typename TInput>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, const TInput &input, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+template <typename TInput>
+DeserializationError deserializeMsgPack(JsonDocument &doc, const TInput &input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
 
+// deserializeMsgPack(JsonDocument&, std::istream&, ...)
 template <typename TInput>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput *input,
+    JsonDocument &doc, TInput &input,
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
-
 template <typename TInput>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput *input, size_t inputSize,
+    JsonDocument &doc, TInput &input, Filter filter,
     NestingLimit nestingLimit = NestingLimit()) {
-  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
-                                          AllowAllFilter());
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
 }
-
 template <typename TInput>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TInput &input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+
+// deserializeMsgPack(JsonDocument&, char*, ...)
+template <typename TChar>
 DeserializationError deserializeMsgPack(
-    JsonDocument &doc, TInput &input,
+    JsonDocument &doc, TChar *input,
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit,
                                           AllowAllFilter());
 }
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TChar *input,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, nestingLimit, filter);
+}
+
+// deserializeMsgPack(JsonDocument&, char*, size_t, ...)
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, size_t inputSize,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          AllowAllFilter());
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(
+    JsonDocument &doc, TChar *input, size_t inputSize, Filter filter,
+    NestingLimit nestingLimit = NestingLimit()) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
+template <typename TChar>
+DeserializationError deserializeMsgPack(JsonDocument &doc, TChar *input,
+                                        size_t inputSize,
+                                        NestingLimit nestingLimit,
+                                        Filter filter) {
+  return deserialize<MsgPackDeserializer>(doc, input, inputSize, nestingLimit,
+                                          filter);
+}
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <ArduinoJson/Misc/Visitable.hpp>
 #include <ArduinoJson/MsgPack/endianess.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
@@ -38,9 +39,24 @@ class MsgPackSerializer {
   }
 
   void visitArray(const CollectionData& array) {
-    size_t n = array.size();
+    writeArrayHeader(array.size());
+    for (VariantSlot* slot = array.head(); slot; slot = slot->next()) {
+      slot->data()->accept(*this);
+    }
+  }
+
+  void visitObject(const CollectionData& object) {
+    writeMapHeader(object.size());
+    for (VariantSlot* slot = object.head(); slot; slot = slot->next()) {
+      visitString(slot->key());
+      slot->data()->accept(*this);
+    }
+  }
+
+  // The n elements must follow
+  void writeArrayHeader(size_t n) {
     if (n < 0x10) {
-      writeByte(uint8_t(0x90 + array.size()));
+      writeByte(uint8_t(0x90 + n));
     } else if (n < 0x10000) {
       writeByte(0xDC);
       writeInteger(uint16_t(n));
@@ -48,13 +64,10 @@ class MsgPackSerializer {
       writeByte(0xDD);
       writeInteger(uint32_t(n));
     }
-    for (VariantSlot* slot = array.head(); slot; slot = slot->next()) {
-      slot->data()->accept(*this);
-    }
   }
 
-  void visitObject(const CollectionData& object) {
-    size_t n = object.size();
+  // The n keys and values must follow
+  void writeMapHeader(size_t n) {
     if (n < 0x10) {
       writeByte(uint8_t(0x80 + n));
     } else if (n < 0x10000) {
@@ -64,10 +77,6 @@ class MsgPackSerializer {
       writeByte(0xDF);
       writeInteger(uint32_t(n));
     }
-    for (VariantSlot* slot = object.head(); slot; slot = slot->next()) {
-      visitString(slot->key());
-      slot->data()->accept(*this);
-    }
   }
 
   void visitString(const char* value) {
@@ -175,18 +184,20 @@ class MsgPackSerializer {
 };
 
 template <typename TSource, typename TDestination>
-inline size_t serializeMsgPack(const TSource& source, TDestination& output) {
+inline typename enable_if<IsVisitable<TSource>::value, size_t>::type
+serializeMsgPack(const TSource& source, TDestination& output) {
   return serialize<MsgPackSerializer>(source, output);
 }
 
 template <typename TSource>
-inline size_t serializeMsgPack(const TSource& source, void* output,
-                               size_t size) {
+inline typename enable_if<IsVisitable<TSource>::value, size_t>::type
+serializeMsgPack(const TSource& source, void* output, size_t size) {
   return serialize<MsgPackSerializer>(source, output, size);
 }
 
 template <typename TSource>
-inline size_t measureMsgPack(const TSource& source) {
+inline typename enable_if<IsVisitable<TSource>::value, size_t>::type
+measureMsgPack(const TSource& source) {
   return measure<MsgPackSerializer>(source);
 }
 
@@ -0,0 +1,67 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Binding/FieldFunctions.hpp>
+#include <ArduinoJson/Binding/StructSource.hpp>
+#include <ArduinoJson/MsgPack/MsgPackSerializer.hpp>
+#include <ArduinoJson/Serialization/measure.hpp>
+#include <ArduinoJson/Serialization/serialize.hpp>
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+
+namespace ARDUINOJSON_NAMESPACE {
+
+template <typename TWriter>
+class MsgPackStructSerializer : public MsgPackSerializer<TWriter> {
+  typedef MsgPackSerializer<TWriter> base;
+
+ public:
+  MsgPackStructSerializer(TWriter writer) : base(writer) {}
+
+  void visitStruct(const StructBinding &binding, const void *object) {
+    base::writeMapHeader(binding.count);
+
+    for (uint8_t i = 0; i < binding.count; i++) {
+      const FieldBinding &field = binding.fields[i];
+      const char *value = static_cast<const char *>(object) + field.offset;
+
+      base::visitString(field.name);
+
+      if (field.isArray()) {
+        size_t n = fieldArraySize(field, object);
+        base::writeArrayHeader(n);
+        for (size_t j = 0; j < n; j++)
+          fieldAccept(field, value + j * field.size, *this);
+      } else {
+        fieldAccept(field, value, *this);
+      }
+    }
+  }
+};
+
+template <typename TStruct, typename TDestination>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type
+serializeMsgPack(const TStruct &source, TDestination &destination) {
+  return serialize<MsgPackStructSerializer>(StructSource<TStruct>(source),
+                                            destination);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type
+serializeMsgPack(const TStruct &source, void *buffer, size_t bufferSize) {
+  return serialize<MsgPackStructSerializer>(StructSource<TStruct>(source),
+                                            buffer, bufferSize);
+}
+
+template <typename TStruct>
+typename enable_if<IsBoundStruct<TStruct>::value, size_t>::type measureMsgPack(
+    const TStruct &source) {
+  return measure<MsgPackStructSerializer>(StructSource<TStruct>(source));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif  // ARDUINOJSON_HAS_CONSTEXPR
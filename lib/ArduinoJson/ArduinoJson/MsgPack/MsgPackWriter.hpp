@@ -0,0 +1,267 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Misc/Visitable.hpp>
+#include <ArduinoJson/MsgPack/MsgPackSerializer.hpp>
+#include <ArduinoJson/MsgPack/MsgPackStructSerializer.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Serialization/Writers/BufferingWriter.hpp>
+#include <ArduinoJson/Variant/VariantData.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Writes MessagePack values one at a time, without a JsonDocument.
+//
+// With beginArray(n) and beginMap(n), the caller knows the number of elements
+// (or members) and writes them right after: the values go straight to the
+// destination.
+//
+// With beginArray(buffer, capacity), the count doesn't need to be known: the
+// elements are encoded in the buffer, and each time it's full, they're sent
+// as an array of their own. The receiver gets a sequence of arrays (one per
+// chunk) that it concatenates. An element larger than the buffer is sent
+// alone, as an array of one element. Each write() is one element, so nested
+// containers must come from a document or a bound struct.
+template <typename TDestination>
+class MsgPackWriter {
+  typedef Writer<TDestination> direct_writer_type;
+  typedef typename conditional<IsBufferedDestination<TDestination>::value,
+                               BufferingWriter<direct_writer_type>,
+                               direct_writer_type>::type writer_type;
+
+  // Writes in the chunk buffer, and nothing once it's full
+  class ChunkWriter {
+   public:
+    ChunkWriter(uint8_t *begin, uint8_t *end)
+        : _ptr(begin), _end(end), _overflowed(false) {}
+
+    size_t write(uint8_t c) {
+      if (_ptr == _end) {
+        _overflowed = true;
+        return 0;
+      }
+      *_ptr++ = c;
+      return 1;
+    }
+
+    size_t write(const uint8_t *s, size_t n) {
+      if (n > size_t(_end - _ptr)) {
+        _overflowed = true;
+        return 0;
+      }
+      memcpy(_ptr, s, n);
+      _ptr += n;
+      return n;
+    }
+
+    uint8_t *ptr() const {
+      return _ptr;
+    }
+
+    bool overflowed() const {
+      return _overflowed;
+    }
+
+   private:
+    uint8_t *_ptr;
+    uint8_t *_end;
+    bool _overflowed;
+  };
+
+  template <typename TWriter>
+  struct serializer {
+#if ARDUINOJSON_HAS_CONSTEXPR
+    typedef MsgPackStructSerializer<TWriter> type;
+#else
+    typedef MsgPackSerializer<TWriter> type;
+#endif
+  };
+
+  // A string that VariantData can't hold: in compact slots, its pointer is an
+  // offset that may not reach the stack
+  struct LinkedString {
+    const char *value;
+
+    template <typename TVisitor>
+    void accept(TVisitor &visitor) const {
+      if (value)
+        visitor.visitString(value);
+      else
+        visitor.visitNull();
+    }
+  };
+
+ public:
+  explicit MsgPackWriter(TDestination &destination)
+      : _writer((direct_writer_type(destination))),
+        _serializer(_writer),
+        _chunk(0),
+        _chunkCapacity(0),
+        _chunkSize(0),
+        _chunkCount(0),
+        _chunkSent(false) {}
+
+  ~MsgPackWriter() {
+    flush();
+  }
+
+  // The n elements must follow
+  void beginArray(size_t n) {
+    ARDUINOJSON_ASSERT(!_chunk);
+    _serializer.writeArrayHeader(n);
+  }
+
+  // The n keys and values must follow, alternately
+  void beginMap(size_t n) {
+    ARDUINOJSON_ASSERT(!_chunk);
+    _serializer.writeMapHeader(n);
+  }
+
+  // The elements follow until endArray(), in chunks of up to capacity bytes
+  void beginArray(void *buffer, size_t capacity) {
+    ARDUINOJSON_ASSERT(!_chunk);
+    ARDUINOJSON_ASSERT(buffer != 0);
+    _chunk = static_cast<uint8_t *>(buffer);
+    _chunkCapacity = capacity;
+    _chunkSize = 0;
+    _chunkCount = 0;
+    _chunkSent = false;
+  }
+
+  void endArray() {
+    ARDUINOJSON_ASSERT(_chunk);
+    // an empty array is still an array
+    if (_chunkCount || !_chunkSent)
+      sendChunk();
+    _chunk = 0;
+  }
+
+  void write(bool value) {
+    VariantData data = VariantData();
+    data.setBoolean(value);
+    emit(data);
+  }
+
+  template <typename T>
+  typename enable_if<is_integral<T>::value>::type write(T value) {
+    VariantData data = VariantData();
+    data.setInteger(value);
+    emit(data);
+  }
+
+  template <typename T>
+  typename enable_if<is_floating_point<T>::value>::type write(T value) {
+    VariantData data = VariantData();
+    data.setFloat(Float(value));
+    emit(data);
+  }
+
+  void write(const char *value) {
+    LinkedString s = {value};
+    emit(s);
+  }
+
+  // JsonDocument, JsonVariantConst, JsonArrayConst...
+  template <typename T>
+  typename enable_if<IsVisitable<T>::value>::type write(const T &value) {
+    emit(value);
+  }
+
+#if ARDUINOJSON_HAS_CONSTEXPR
+  template <typename T>
+  typename enable_if<IsBoundStruct<T>::value>::type write(const T &object) {
+    emit(StructSource<T>(object));
+  }
+#endif
+
+  void writeNull() {
+    VariantData data = VariantData();
+    data.setNull();
+    emit(data);
+  }
+
+  // Returns the number of bytes written, including those still in the buffer
+  // of a Print or a std::ostream
+  size_t bytesWritten() const {
+    return _serializer.bytesWritten();
+  }
+
+  // Sends the buffered bytes of a Print or a std::ostream; the destructor
+  // does it too
+  void flush() {
+    flushWriter(_writer);
+  }
+
+ private:
+  MsgPackWriter(const MsgPackWriter &);             // cannot be copied
+  MsgPackWriter &operator=(const MsgPackWriter &);  // cannot be assigned
+
+  template <typename TWriter, size_t N>
+  static void flushWriter(BufferingWriter<TWriter, N> &writer) {
+    writer.flush();
+  }
+
+  template <typename TWriter>
+  static void flushWriter(TWriter &) {}
+
+  template <typename TSource>
+  void emit(const TSource &source) {
+    if (_chunk)
+      appendToChunk(source);
+    else
+      source.accept(_serializer);
+  }
+
+  template <typename TSource>
+  void appendToChunk(const TSource &source) {
+    if (encodeInChunk(source))
+      return;
+    if (_chunkCount) {
+      sendChunk();
+      if (encodeInChunk(source))
+        return;
+    }
+    // larger than the buffer
+    _serializer.writeArrayHeader(1);
+    source.accept(_serializer);
+    _chunkSent = true;
+  }
+
+  template <typename TSource>
+  bool encodeInChunk(const TSource &source) {
+    ChunkWriter writer(_chunk + _chunkSize, _chunk + _chunkCapacity);
+    typename serializer<ChunkWriter &>::type chunkSerializer(writer);
+    source.accept(chunkSerializer);
+    if (writer.overflowed())
+      return false;
+    _chunkSize = size_t(writer.ptr() - _chunk);
+    _chunkCount++;
+    return true;
+  }
+
+  void sendChunk() {
+    _serializer.writeArrayHeader(_chunkCount);
+    _serializer.visitRawJson(reinterpret_cast<const char *>(_chunk),
+                             _chunkSize);
+    _chunkSize = 0;
+    _chunkCount = 0;
+    _chunkSent = true;
+  }
+
+  writer_type _writer;
+  typename serializer<writer_type &>::type _serializer;
+  uint8_t *_chunk;
+  size_t _chunkCapacity;
+  size_t _chunkSize;
+  size_t _chunkCount;
+  bool _chunkSent;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
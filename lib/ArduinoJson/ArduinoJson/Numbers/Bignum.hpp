@@ -0,0 +1,85 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A fixed-size unsigned integer of N words of 32 bits.
+// It only has what decimalToFloat() needs to compare a decimal with the
+// midpoint between two floats.
+template <size_t N>
+class Bignum {
+ public:
+  explicit Bignum(uint64_t value) : _size(0) {
+    while (value) {
+      _words[_size++] = uint32_t(value);
+      value >>= 32;
+    }
+  }
+
+  void multiply(uint32_t factor) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < _size; i++) {
+      carry += uint64_t(_words[i]) * factor;
+      _words[i] = uint32_t(carry);
+      carry >>= 32;
+    }
+    if (carry) {
+      ARDUINOJSON_ASSERT(_size < N);
+      _words[_size++] = uint32_t(carry);
+    }
+  }
+
+  void multiplyByPowerOfFive(int exponent) {
+    static const uint32_t powers[] = {1,      5,       25,       125,
+                                      625,    3125,    15625,    78125,
+                                      390625, 1953125, 9765625,  48828125,
+                                      244140625, 1220703125};
+    for (; exponent >= 13; exponent -= 13) multiply(powers[13]);
+    if (exponent > 0)
+      multiply(powers[exponent]);
+  }
+
+  void shiftLeft(int bits) {
+    if (_size == 0 || bits <= 0)
+      return;
+    size_t words = size_t(bits / 32);
+    int shift = bits % 32;
+    ARDUINOJSON_ASSERT(_size + words + 1 <= N);
+    _words[_size + words] = 0;
+    for (size_t i = _size; i > 0; i--) {
+      uint64_t w = uint64_t(_words[i - 1]) << shift;
+      _words[i + words] |= uint32_t(w >> 32);
+      _words[i - 1 + words] = uint32_t(w);
+    }
+    for (size_t i = 0; i < words; i++) _words[i] = 0;
+    _size += words;
+    if (_words[_size])
+      _size++;
+  }
+
+  // Returns -1, 0, or 1
+  friend int compare(const Bignum& a, const Bignum& b) {
+    if (a._size != b._size)
+      return a._size < b._size ? -1 : 1;
+    for (size_t i = a._size; i > 0; i--) {
+      if (a._words[i - 1] != b._words[i - 1])
+        return a._words[i - 1] < b._words[i - 1] ? -1 : 1;
+    }
+    return 0;
+  }
+
+ private:
+  uint32_t _words[N];
+  size_t _size;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,209 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/DiyFp.hpp>
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Florian Loitsch's Grisu2, as in "Printing Floating-Point Numbers Quickly and
+// Accurately with Integers" (PLDI 2010).
+// It finds the digits of the shortest decimal that reads back as the same
+// float, except when a shorter one lies within the error of the products,
+// next to the boundaries (about 0.1% of the doubles and 0.3% of the floats,
+// and the ties like 1e23). When the digits come that close to a boundary,
+// shorten() tries the shorter prefixes with decimalToFloat(), so the result is
+// always the shortest.
+// Unlike FloatParts, it only uses integer arithmetic, so it doesn't call the
+// software floating point routines of the MCUs without an FPU (except
+// decimalToFloat() in the rare cases above).
+
+template <typename TFloat>
+struct ShortestFloat {
+  // the float is digits * 10^exponent, where digits is a string without
+  // leading or trailing zeros
+  char digits[18];
+  int8_t length;
+  int16_t exponent;
+
+  // value must be finite and positive
+  ShortestFloat(TFloat value) : length(0), exponent(0), _suspect(false) {
+    typedef FloatTraits<TFloat> traits;
+    typedef typename traits::mantissa_type bits_type;
+    const int precision = traits::mantissa_bits + 1;
+    const int bias = (1 << (sizeof(TFloat) * 8 - precision - 1)) - 1 +
+                     traits::mantissa_bits;
+    const uint64_t hiddenBit = uint64_t(1) << traits::mantissa_bits;
+
+    bits_type bits = alias_cast<bits_type>(value);
+    uint64_t fraction = bits & traits::mantissa_max;
+    int biasedExponent = int(bits >> traits::mantissa_bits);
+
+    DiyFp v = biasedExponent ? DiyFp(fraction + hiddenBit, biasedExponent - bias)
+                             : DiyFp(fraction, 1 - bias);  // subnormal
+
+    // the boundaries are half-way to the neighbors; the lower one is closer
+    // when the fraction is 0, because the exponent changes below
+    DiyFp plus = DiyFp::normalize(DiyFp(2 * v.f + 1, v.e - 1));
+    DiyFp minus = fraction == 0 && biasedExponent > 1
+                      ? DiyFp(4 * v.f - 1, v.e - 2)
+                      : DiyFp(2 * v.f - 1, v.e - 1);
+    minus = DiyFp::normalizeTo(minus, plus.e);
+    v = DiyFp::normalize(v);
+
+    // scale by 10^-k, so that the exponent of plus is in [-60, -32]
+    int e = -60 - plus.e - 1;
+    int k = int(int32_t(e) * 78913 / (int32_t(1) << 18)) + (e > 0);
+    int index = (k - cachedPowersMinExponent + 7) / 8;
+    k = cachedPowersMinExponent + index * 8;
+    DiyFp c = cachedPowerOfTen(index);
+    exponent = int16_t(-k);
+
+    DiyFp w = DiyFp::mul(v, c);
+    DiyFp wMinus = DiyFp::mul(minus, c);
+    DiyFp wPlus = DiyFp::mul(plus, c);
+    // the products can be off by one ulp: stay inside the safe interval
+    wMinus.f++;
+    wPlus.f--;
+
+    generateDigits(wMinus, w, wPlus);
+    if (_suspect)
+      shorten(value);
+  }
+
+ private:
+  // Set when a decimal with one digit less may lie in the interval: the
+  // boundaries can be 2 units away from low and high
+  bool _suspect;
+
+  void checkShorter(uint64_t rest, uint64_t delta, uint64_t tenK,
+                    uint64_t unit) {
+    _suspect = rest <= delta + 2 * unit || tenK - rest <= 2 * unit;
+  }
+
+  // Tries the prefixes of the digits, truncated or rounded up, from the
+  // longest to the shortest, and keeps the shortest that reads back as value.
+  // The digits are those of high, so if a decimal of n digits lies in the
+  // interval, one of these two does too.
+  void shorten(TFloat value) {
+    uint64_t prefixes[sizeof(digits)];
+    uint64_t prefix = 0;
+    for (int i = 0; i < length; i++) {
+      prefix = prefix * 10 + uint64_t(digits[i] - '0');
+      prefixes[i] = prefix;
+    }
+    int bestLength = length;
+    uint64_t best = 0;
+    for (int n = length - 1; n > 0; n--) {
+      int16_t e = int16_t(exponent + length - n);
+      bool roundUp = digits[n] >= '5';
+      uint64_t candidate = prefixes[n - 1] + (roundUp ? 1 : 0);
+      if (!readsBackAs(value, candidate, e)) {
+        candidate = prefixes[n - 1] + (roundUp ? 0 : 1);
+        if (!readsBackAs(value, candidate, e))
+          break;
+      }
+      bestLength = n;
+      best = candidate;
+    }
+    if (bestLength == length)
+      return;
+    int16_t e = int16_t(exponent + length - bestLength);
+    length = 0;
+    exponent = e;
+    writeDigits(best);
+    trimZeros();
+  }
+
+  static bool readsBackAs(TFloat value, uint64_t significand, int e) {
+    DecimalNumber number;
+    number.significand = significand;
+    number.exponent = e;
+    for (uint64_t n = significand; n; n /= 10) number.digits++;
+    return decimalToFloat<TFloat>(number) == value;
+  }
+
+  // Writes the digits of n; rounding 9...9 up adds one, trimZeros() drops it
+  void writeDigits(uint64_t n) {
+    char reversed[sizeof(digits)];
+    int count = 0;
+    do {
+      reversed[count++] = char('0' + n % 10);
+      n /= 10;
+    } while (n);
+    while (count > 0) digits[length++] = reversed[--count];
+  }
+
+  void generateDigits(const DiyFp& low, const DiyFp& w, const DiyFp& high) {
+    uint64_t delta = DiyFp::sub(high, low).f;
+    uint64_t dist = DiyFp::sub(high, w).f;
+
+    // split high into integral (p1) and fractional (p2) parts
+    const int shift = -high.e;
+    const uint64_t one = uint64_t(1) << shift;
+    uint32_t p1 = uint32_t(high.f >> shift);
+    uint64_t p2 = high.f & (one - 1);
+
+    uint32_t pow10 = 1;
+    int n = 1;
+    while (n < 10 && p1 >= pow10 * 10) {
+      pow10 *= 10;
+      n++;
+    }
+
+    while (n > 0) {
+      digits[length++] = char('0' + p1 / pow10);
+      p1 %= pow10;
+      n--;
+      uint64_t rest = (uint64_t(p1) << shift) + p2;
+      if (rest <= delta) {
+        exponent = int16_t(exponent + n);
+        round(dist, delta, rest, uint64_t(pow10) << shift);
+        trimZeros();
+        return;
+      }
+      checkShorter(rest, delta, uint64_t(pow10) << shift, 1);
+      pow10 /= 10;
+    }
+
+    uint64_t unit = 1;
+    for (;;) {
+      p2 *= 10;
+      delta *= 10;
+      dist *= 10;
+      unit *= 10;
+      digits[length++] = char('0' + (p2 >> shift));
+      p2 &= one - 1;
+      exponent--;
+      if (p2 <= delta)
+        break;
+      checkShorter(p2, delta, one, unit);
+    }
+    round(dist, delta, p2, one);
+    trimZeros();
+  }
+
+  // Moves the last digit toward w, as long as it stays in the interval
+  void round(uint64_t dist, uint64_t delta, uint64_t rest, uint64_t tenK) {
+    while (rest < dist && delta - rest >= tenK &&
+           (rest + tenK < dist || dist - rest > rest + tenK - dist)) {
+      digits[length - 1]--;
+      rest += tenK;
+    }
+  }
+
+  void trimZeros() {
+    while (length > 1 && digits[length - 1] == '0') {
+      length--;
+      exponent++;
+    }
+    digits[length] = 0;
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
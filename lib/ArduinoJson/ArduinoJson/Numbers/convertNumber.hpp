@@ -76,10 +76,18 @@ TOut convertPositiveInteger(TIn value) {
 }
 
 template <typename TOut, typename TIn>
-TOut convertNegativeInteger(TIn value) {
+typename enable_if<is_integral<TOut>::value, TOut>::type convertNegativeInteger(
+    TIn value) {
   return canStoreNegativeInteger<TOut>(value) ? TOut(~value + 1) : 0;
 }
 
+// ~value + 1 is positive in TIn, so it can't be converted to a float
+template <typename TOut, typename TIn>
+typename enable_if<is_floating_point<TOut>::value, TOut>::type
+convertNegativeInteger(TIn value) {
+  return -TOut(value);
+}
+
 template <typename TOut, typename TIn>
 typename enable_if<is_floating_point<TOut>::value, TOut>::type convertFloat(
     TIn value) {
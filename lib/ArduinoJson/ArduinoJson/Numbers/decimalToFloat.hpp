@@ -0,0 +1,281 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Numbers/Bignum.hpp>
+#include <ArduinoJson/Numbers/DiyFp.hpp>
+#include <ArduinoJson/Numbers/FloatTraits.hpp>
+#include <ArduinoJson/Polyfills/alias_cast.hpp>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The digits of a number, as significand * 10^exponent.
+// Only the first 19 significant digits fit in significand (20 if they don't
+// overflow, for the largest integers); the following ones only set the
+// truncated flag, which tells that the number is a bit larger.
+struct DecimalNumber {
+  uint64_t significand;
+  int32_t exponent;
+  uint8_t digits;  // significant digits in significand
+  bool truncated;
+
+  DecimalNumber() : significand(0), exponent(0), digits(0), truncated(false) {}
+
+  void appendIntegralDigit(uint8_t digit) {
+    if (fits(digit)) {
+      append(digit);
+    } else {
+      drop(digit);
+      exponent++;
+    }
+  }
+
+  void appendDecimalDigit(uint8_t digit) {
+    if (fits(digit)) {
+      append(digit);
+      exponent--;
+    } else {
+      drop(digit);
+    }
+  }
+
+  template <typename TUInt>
+  bool isInteger() const {
+    return exponent == 0 && !truncated && significand <= TUInt(-1);
+  }
+
+ private:
+  bool fits(uint8_t digit) const {
+    if (digits < 19)
+      return true;
+    const uint64_t max = uint64_t(-1);
+    return digits == 19 && significand <= (max - digit) / 10;
+  }
+
+  void append(uint8_t digit) {
+    significand = significand * 10 + digit;
+    if (significand)
+      digits++;  // leading zeros don't count
+  }
+
+  void drop(uint8_t digit) {
+    if (digit)
+      truncated = true;
+  }
+};
+
+// Converts a decimal number to the nearest float, ties to even.
+// Three steps, from the fastest to the slowest:
+// 1. Clinger's fast path, when the significand and the power of ten are both
+//    exact floats: a single multiplication or division.
+// 2. David Gay's and Florian Loitsch's approach (as in double-conversion's
+//    DiyFpStrtod): multiplies the significand by a cached power of ten in
+//    64-bit integers, keeping track of the error. It's enough unless the
+//    number is very close to the midpoint between two floats.
+// 3. Compares the number with that midpoint using big integers.
+// The result is correctly rounded, except for the numbers with more than 19
+// significant digits that fall very close to a midpoint: they round down.
+template <typename TFloat>
+class DecimalToFloat {
+  typedef FloatTraits<TFloat> traits;
+  typedef typename traits::mantissa_type bits_type;
+
+  static const int precision = traits::mantissa_bits + 1;
+  static const int exponentBias = (1 << (sizeof(TFloat) * 8 - precision - 1)) -
+                                  1 + traits::mantissa_bits;
+  static const int denormalExponent = 1 - exponentBias;
+  static const int maxExponent =
+      (1 << (sizeof(TFloat) * 8 - precision)) - 1 - exponentBias;
+
+  // beyond these bounds, the number rounds to infinity and zero
+  static const int maxDecimalPoint = traits::exponent_max + 1;
+  static const int minDecimalPoint = sizeof(TFloat) == 8 ? -324 : -46;
+
+  // the largest integer and power of ten that are exact floats
+  static const uint64_t maxExactInteger = uint64_t(1) << precision;
+  static const int maxExactPowerOfTen = sizeof(TFloat) == 8 ? 22 : 10;
+
+  typedef Bignum<sizeof(TFloat) == 8 ? 30 : 8> bignum_type;
+
+ public:
+  static TFloat convert(const DecimalNumber& number) {
+    if (number.significand == 0)
+      return 0;
+
+    int32_t point = number.exponent + number.digits;
+    if (point > maxDecimalPoint)
+      return traits::inf();
+    if (point <= minDecimalPoint)
+      return 0;
+
+    int exponent = int(number.exponent);
+    if (!number.truncated && number.significand <= maxExactInteger &&
+        exponent >= -maxExactPowerOfTen && exponent <= maxExactPowerOfTen) {
+      TFloat significand = TFloat(number.significand);
+      if (exponent >= 0)
+        return significand * exactPowerOfTen(exponent);
+      else
+        return significand / exactPowerOfTen(-exponent);
+    }
+
+    bits_type guess;
+    if (multiplyByCachedPower(number, guess))
+      return alias_cast<TFloat>(guess);
+    return alias_cast<TFloat>(compareWithMidpoint(number, guess));
+  }
+
+ private:
+  // n <= maxExactPowerOfTen, so all the products are exact
+  static TFloat exactPowerOfTen(int n) {
+    TFloat result = 1;
+    for (uint8_t index = 0; n != 0; index++) {
+      if (n & 1)
+        result *= traits::positiveBinaryPowerOfTen(index);
+      n >>= 1;
+    }
+    return result;
+  }
+
+  // 10^n, for n = 1..7, normalized
+  static DiyFp adjustmentPowerOfTen(int n) {
+    static const uint32_t table[] ARDUINOJSON_PROGMEM = {
+        0xA0000000, 0xC8000000, 0xFA000000, 0x9C400000,
+        0xC3500000, 0xF4240000, 0x98968000,
+    };
+    static const int8_t exponents[] = {-60, -57, -54, -50, -47, -44, -40};
+    return DiyFp(uint64_t(readStaticDword(table + n - 1)) << 32,
+                 exponents[n - 1]);
+  }
+
+  // Returns the number of bits of the significand of a float of order
+  // (f * 2^e with f in [1/2, 1) and e = order); less than precision for the
+  // denormals
+  static int significandSize(int order) {
+    if (order >= denormalExponent + precision)
+      return precision;
+    if (order <= denormalExponent)
+      return 0;
+    return order - denormalExponent;
+  }
+
+  // Returns the bits of the float f * 2^e; f has at most precision bits
+  static bits_type makeBits(DiyFp value) {
+    const uint64_t hiddenBit = uint64_t(1) << traits::mantissa_bits;
+    while (value.f > hiddenBit + traits::mantissa_max) {
+      value.f >>= 1;
+      value.e++;
+    }
+    if (value.e >= maxExponent)
+      return alias_cast<bits_type>(traits::inf());
+    if (value.e < denormalExponent)
+      return 0;
+    while (value.e > denormalExponent && (value.f & hiddenBit) == 0) {
+      value.f <<= 1;
+      value.e--;
+    }
+    uint64_t biasedExponent = 0;
+    if (value.e != denormalExponent || (value.f & hiddenBit) != 0)
+      biasedExponent = uint64_t(value.e + exponentBias);
+    return bits_type((value.f & traits::mantissa_max) |
+                     (biasedExponent << traits::mantissa_bits));
+  }
+
+  // Computes significand * 10^exponent in 64 bits, with an error counted in
+  // eighths of the last bit, then rounds it to the float precision.
+  // Returns false if the error may cross the midpoint between two floats.
+  static bool multiplyByCachedPower(const DecimalNumber& number,
+                                    bits_type& result) {
+    const int denominatorLog = 3;
+    const int denominator = 1 << denominatorLog;
+    const uint64_t one = 1;
+
+    // when truncated, the significand has 19 or 20 digits, so it shifts by 4
+    // bits at most
+    DiyFp input = DiyFp::normalize(DiyFp(number.significand, 0));
+    int error = number.truncated ? (denominator / 2) << -input.e : 0;
+
+    int exponent = int(number.exponent);
+    int index = (exponent - cachedPowersMinExponent) / 8;
+    int adjustment = exponent - (cachedPowersMinExponent + index * 8);
+    if (adjustment) {
+      input = DiyFp::mul(input, adjustmentPowerOfTen(adjustment));
+      // the product is exact unless it needs more than 64 bits
+      if (number.digits + adjustment > 19)
+        error += denominator / 2;
+    }
+
+    input = DiyFp::mul(input, cachedPowerOfTen(index));
+    // the cached power and the product are both off by half a bit, and the
+    // product of the errors is less than a bit
+    error += denominator / 2 + denominator / 2 + (error ? 1 : 0);
+
+    int oldExponent = input.e;
+    input = DiyFp::normalize(input);
+    error <<= oldExponent - input.e;
+
+    int precisionBits = 64 - significandSize(input.e + 64);
+    if (precisionBits + denominatorLog >= 64) {
+      int shift = precisionBits + denominatorLog - 64 + 1;
+      input.f >>= shift;
+      input.e = int16_t(input.e + shift);
+      error = (error >> shift) + 1 + denominator;
+      precisionBits -= shift;
+    }
+
+    uint64_t precisionBitsValue = (input.f & ((one << precisionBits) - 1)) *
+                                  denominator;
+    uint64_t halfWay = (one << (precisionBits - 1)) * denominator;
+    DiyFp rounded(input.f >> precisionBits, input.e + precisionBits);
+    if (precisionBitsValue >= halfWay + uint64_t(error))
+      rounded.f++;
+    result = makeBits(rounded);
+
+    return precisionBitsValue + uint64_t(error) <= halfWay ||
+           precisionBitsValue >= halfWay + uint64_t(error);
+  }
+
+  // Compares the number with the midpoint between guess and the next float,
+  // and returns the nearest
+  static bits_type compareWithMidpoint(const DecimalNumber& number,
+                                       bits_type guess) {
+    if (guess == alias_cast<bits_type>(traits::inf()))
+      guess--;  // the largest float
+
+    uint64_t mantissa = guess & traits::mantissa_max;
+    int biasedExponent = int(guess >> traits::mantissa_bits);
+    int exponent = denormalExponent;
+    if (biasedExponent) {
+      mantissa += uint64_t(1) << traits::mantissa_bits;
+      exponent = biasedExponent - exponentBias;
+    }
+
+    // number = significand * 5^e10 * 2^e10
+    // midpoint = (2 * mantissa + 1) * 2^(exponent - 1)
+    int e10 = int(number.exponent);
+    bignum_type left(number.significand);
+    bignum_type right(2 * mantissa + 1);
+    if (e10 >= 0)
+      left.multiplyByPowerOfFive(e10);
+    else
+      right.multiplyByPowerOfFive(-e10);
+    int e2 = exponent - 1;
+    if (e10 > e2)
+      left.shiftLeft(e10 - e2);
+    else
+      right.shiftLeft(e2 - e10);
+
+    int cmp = compare(left, right);
+    if (cmp > 0 || (cmp == 0 && (number.truncated || (mantissa & 1))))
+      guess++;
+    return guess;
+  }
+};
+
+template <typename TFloat>
+inline TFloat decimalToFloat(const DecimalNumber& number) {
+  return DecimalToFloat<TFloat>::convert(number);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Numbers/FloatTraits.hpp>
 #include <ArduinoJson/Numbers/convertNumber.hpp>
+#include <ArduinoJson/Numbers/decimalToFloat.hpp>
 #include <ArduinoJson/Polyfills/assert.hpp>
 #include <ArduinoJson/Polyfills/ctype.hpp>
 #include <ArduinoJson/Polyfills/math.hpp>
@@ -51,56 +52,132 @@ struct ParsedNumber {
 template <typename A, typename B>
 struct choose_largest : conditional<(sizeof(A) > sizeof(B)), A, B> {};
 
-template <typename TFloat, typename TUInt>
-inline ParsedNumber<TFloat, TUInt> parseNumber(const char *s) {
-  typedef FloatTraits<TFloat> traits;
-  typedef typename choose_largest<typename traits::mantissa_type, TUInt>::type
-      mantissa_t;
-  typedef typename traits::exponent_type exponent_t;
-  typedef ParsedNumber<TFloat, TUInt> return_type;
+inline bool isFloatChar(char c) {
+  return c == '.' || c == 'e' || c == 'E';
+}
 
-  ARDUINOJSON_ASSERT(s != 0);
+template <typename TLatch>
+inline void skipLetters(TLatch &latch) {
+  while (isalpha(latch.current())) latch.clear();
+}
+
+// Reads a null-terminated string, like Latch reads a TReader
+class StringLatch {
+ public:
+  explicit StringLatch(const char *s) : _ptr(s) {}
+
+  char current() const {
+    return *_ptr;
+  }
+
+  void clear() {
+    _ptr++;
+  }
+
+ private:
+  const char *_ptr;
+};
+
+// Parses the number at the current position of the latch, and stops at the
+// first character that can't be part of it, so the deserializers don't need to
+// copy the number first. The caller must check this character.
+template <typename TFloat, typename TUInt, typename TLatch>
+inline ParsedNumber<TFloat, TUInt> scanNumber(TLatch &latch) {
+  typedef ParsedNumber<TFloat, TUInt> return_type;
 
   bool is_negative = false;
-  switch (*s) {
+  switch (latch.current()) {
     case '-':
       is_negative = true;
-      s++;
+      latch.clear();
       break;
     case '+':
-      s++;
+      latch.clear();
       break;
   }
 
 #if ARDUINOJSON_ENABLE_NAN
-  if (*s == 'n' || *s == 'N')
-    return traits::nan();
+  if (latch.current() == 'n' || latch.current() == 'N') {
+    skipLetters(latch);
+    return FloatTraits<TFloat>::nan();
+  }
 #endif
 
 #if ARDUINOJSON_ENABLE_INFINITY
-  if (*s == 'i' || *s == 'I')
-    return is_negative ? -traits::inf() : traits::inf();
+  if (latch.current() == 'i' || latch.current() == 'I') {
+    skipLetters(latch);
+    return is_negative ? -FloatTraits<TFloat>::inf()
+                       : FloatTraits<TFloat>::inf();
+  }
 #endif
 
-  if (!isdigit(*s) && *s != '.')
+  char c = latch.current();
+  if (!isdigit(c) && c != '.')
     return return_type();
 
+#if ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS
+  DecimalNumber number;
+
+  for (; isdigit(c); c = latch.current()) {
+    number.appendIntegralDigit(uint8_t(c - '0'));
+    latch.clear();
+  }
+
+  if (!isFloatChar(c) && number.isInteger<TUInt>())
+    return return_type(TUInt(number.significand), is_negative);
+
+  if (c == '.') {
+    latch.clear();
+    for (c = latch.current(); isdigit(c); c = latch.current()) {
+      number.appendDecimalDigit(uint8_t(c - '0'));
+      latch.clear();
+    }
+  }
+
+  if (c == 'e' || c == 'E') {
+    latch.clear();
+    bool negative_exponent = false;
+    c = latch.current();
+    if (c == '-') {
+      negative_exponent = true;
+      latch.clear();
+    } else if (c == '+') {
+      latch.clear();
+    }
+
+    int32_t exponent = 0;
+    for (c = latch.current(); isdigit(c); c = latch.current()) {
+      // large enough to underflow or overflow any float
+      if (exponent < 100000)
+        exponent = exponent * 10 + (c - '0');
+      latch.clear();
+    }
+    number.exponent += negative_exponent ? -exponent : exponent;
+  }
+
+  TFloat result = decimalToFloat<TFloat>(number);
+#else
+  typedef FloatTraits<TFloat> traits;
+  typedef typename choose_largest<typename traits::mantissa_type, TUInt>::type
+      mantissa_t;
+  typedef typename traits::exponent_type exponent_t;
+
   mantissa_t mantissa = 0;
   exponent_t exponent_offset = 0;
   const mantissa_t maxUint = TUInt(-1);
 
-  while (isdigit(*s)) {
-    uint8_t digit = uint8_t(*s - '0');
+  for (; isdigit(c); c = latch.current()) {
+    uint8_t digit = uint8_t(c - '0');
     if (mantissa > maxUint / 10)
       break;
     mantissa *= 10;
     if (mantissa > maxUint - digit)
       break;
     mantissa += digit;
-    s++;
+    latch.clear();
   }
 
-  if (*s == '\0')
+  if (!isdigit(c) && !isFloatChar(c))
     return return_type(TUInt(mantissa), is_negative);
 
   // avoid mantissa overflow
@@ -110,54 +187,66 @@ inline ParsedNumber<TFloat, TUInt> parseNumber(const char *s) {
   }
 
   // remaing digits can't fit in the mantissa
-  while (isdigit(*s)) {
+  for (; isdigit(c); c = latch.current()) {
     exponent_offset++;
-    s++;
+    latch.clear();
   }
 
-  if (*s == '.') {
-    s++;
-    while (isdigit(*s)) {
+  if (c == '.') {
+    latch.clear();
+    for (c = latch.current(); isdigit(c); c = latch.current()) {
       if (mantissa < traits::mantissa_max / 10) {
-        mantissa = mantissa * 10 + uint8_t(*s - '0');
+        mantissa = mantissa * 10 + uint8_t(c - '0');
         exponent_offset--;
       }
-      s++;
+      latch.clear();
     }
   }
 
   int exponent = 0;
-  if (*s == 'e' || *s == 'E') {
-    s++;
+  if (c == 'e' || c == 'E') {
+    latch.clear();
     bool negative_exponent = false;
-    if (*s == '-') {
+    c = latch.current();
+    if (c == '-') {
       negative_exponent = true;
-      s++;
-    } else if (*s == '+') {
-      s++;
+      latch.clear();
+    } else if (c == '+') {
+      latch.clear();
     }
 
-    while (isdigit(*s)) {
-      exponent = exponent * 10 + (*s - '0');
-      if (exponent + exponent_offset > traits::exponent_max) {
-        if (negative_exponent)
-          return is_negative ? -0.0f : 0.0f;
-        else
-          return is_negative ? -traits::inf() : traits::inf();
-      }
-      s++;
+    for (c = latch.current(); isdigit(c); c = latch.current()) {
+      if (exponent + exponent_offset <= traits::exponent_max)
+        exponent = exponent * 10 + (c - '0');
+      latch.clear();
+    }
+    if (exponent + exponent_offset > traits::exponent_max) {
+      if (negative_exponent)
+        return is_negative ? -0.0f : 0.0f;
+      else
+        return is_negative ? -traits::inf() : traits::inf();
     }
     if (negative_exponent)
       exponent = -exponent;
   }
   exponent += exponent_offset;
 
-  // we should be at the end of the string, otherwise it's an error
-  if (*s != '\0')
-    return return_type();
-
   TFloat result = traits::make_float(static_cast<TFloat>(mantissa), exponent);
+#endif
 
   return is_negative ? -result : result;
 }
+
+template <typename TFloat, typename TUInt>
+inline ParsedNumber<TFloat, TUInt> parseNumber(const char *s) {
+  ARDUINOJSON_ASSERT(s != 0);
+
+  StringLatch latch(s);
+  ParsedNumber<TFloat, TUInt> result = scanNumber<TFloat, TUInt>(latch);
+
+  // we should be at the end of the string, otherwise it's an error
+  if (latch.current() != '\0')
+    return ParsedNumber<TFloat, TUInt>();
+  return result;
+}
 }  // namespace ARDUINOJSON_NAMESPACE
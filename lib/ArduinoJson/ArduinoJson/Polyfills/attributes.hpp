@@ -30,8 +30,10 @@
 
 #if __cplusplus >= 201103L
 #define NOEXCEPT noexcept
+#define ARDUINOJSON_CONSTEXPR constexpr
 #else
 #define NOEXCEPT throw()
+#define ARDUINOJSON_CONSTEXPR
 #endif
 
 #if defined(__has_attribute)
@@ -12,6 +12,10 @@ inline bool isdigit(char c) {
   return '0' <= c && c <= '9';
 }
 
+inline bool isalpha(char c) {
+  return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
 inline bool issign(char c) {
   return '-' == c || c == '+';
 }
@@ -0,0 +1,34 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Configuration.hpp>
+#include <ArduinoJson/Namespace.hpp>
+
+#include <stdint.h>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Static tables go to the flash when PROGMEM is available, because
+// they would take RAM on the ESP8266 and the AVR otherwise
+#if ARDUINOJSON_ENABLE_PROGMEM
+#define ARDUINOJSON_PROGMEM PROGMEM
+inline uint32_t readStaticDword(const uint32_t* p) {
+  return pgm_read_dword(p);
+}
+inline char readStaticByte(const char* p) {
+  return static_cast<char>(pgm_read_byte(p));
+}
+#else
+#define ARDUINOJSON_PROGMEM
+inline uint32_t readStaticDword(const uint32_t* p) {
+  return *p;
+}
+inline char readStaticByte(const char* p) {
+  return *p;
+}
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -26,6 +27,11 @@ class Writer {
   TDestination* _dest;
 };
 
+// Tells whether the writes to TDestination are expensive enough to be buffered
+// (see BufferingWriter and ARDUINOJSON_BUFFER_PRINT)
+template <typename TDestination, typename Enable = void>
+struct IsBufferedDestination : false_type {};
+
 }  // namespace ARDUINOJSON_NAMESPACE
 
 #include <ArduinoJson/Serialization/Writers/StaticStringWriter.hpp>
@@ -0,0 +1,61 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Passes the bytes to TWriter in blocks of N, instead of one by one.
+// CAUTION: call flush() at the end
+template <typename TWriter, size_t N = ARDUINOJSON_WRITE_BUFFER_SIZE>
+class BufferingWriter {
+ public:
+  explicit BufferingWriter(TWriter writer)
+      : _writer(writer), _size(0), _bytesWritten(0) {}
+
+  size_t write(uint8_t c) {
+    if (_size == N)
+      flush();
+    _buffer[_size++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    if (_size + n > N) {
+      flush();
+      // too large for the buffer
+      if (n >= N) {
+        _bytesWritten += _writer.write(s, n);
+        return n;
+      }
+    }
+    memcpy(_buffer + _size, s, n);
+    _size += n;
+    return n;
+  }
+
+  void flush() {
+    if (_size)
+      _bytesWritten += _writer.write(_buffer, _size);
+    _size = 0;
+  }
+
+  // Returns the number of bytes accepted by TWriter, which can be less than
+  // the bytes received if the destination is full
+  size_t bytesWritten() const {
+    return _bytesWritten;
+  }
+
+ private:
+  TWriter _writer;
+  size_t _size;
+  size_t _bytesWritten;
+  uint8_t _buffer[N];
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -25,4 +25,12 @@ class Writer<
   ::Print* _print;
 };
 
+#if ARDUINOJSON_BUFFER_PRINT
+template <typename TDestination>
+struct IsBufferedDestination<
+    TDestination,
+    typename enable_if<is_base_of< ::Print, TDestination>::value>::type>
+    : true_type {};
+#endif
+
 }  // namespace ARDUINOJSON_NAMESPACE
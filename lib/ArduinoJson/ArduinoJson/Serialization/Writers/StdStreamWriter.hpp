@@ -29,4 +29,11 @@ class Writer<
  private:
   std::ostream* _os;
 };
+
+// std::ostream::put() checks the stream state for each byte
+template <typename TDestination>
+struct IsBufferedDestination<
+    TDestination,
+    typename enable_if<is_base_of<std::ostream, TDestination>::value>::type>
+    : true_type {};
 }  // namespace ARDUINOJSON_NAMESPACE
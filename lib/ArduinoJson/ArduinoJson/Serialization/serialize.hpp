@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ArduinoJson/Serialization/Writer.hpp>
+#include <ArduinoJson/Serialization/Writers/BufferingWriter.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -18,11 +19,23 @@ size_t doSerialize(const TSource &source, TWriter writer) {
 
 template <template <typename> class TSerializer, typename TSource,
           typename TDestination>
-size_t serialize(const TSource &source, TDestination &destination) {
+typename enable_if<!IsBufferedDestination<TDestination>::value, size_t>::type
+serialize(const TSource &source, TDestination &destination) {
   Writer<TDestination> writer(destination);
   return doSerialize<TSerializer>(source, writer);
 }
 
+template <template <typename> class TSerializer, typename TSource,
+          typename TDestination>
+typename enable_if<IsBufferedDestination<TDestination>::value, size_t>::type
+serialize(const TSource &source, TDestination &destination) {
+  typedef BufferingWriter<Writer<TDestination> > TWriter;
+  TWriter writer((Writer<TDestination>(destination)));
+  doSerialize<TSerializer, TSource, TWriter &>(source, writer);
+  writer.flush();
+  return writer.bytesWritten();
+}
+
 template <template <typename> class TSerializer, typename TSource>
 size_t serialize(const TSource &source, void *buffer, size_t bufferSize) {
   StaticStringWriter writer(reinterpret_cast<char *>(buffer), bufferSize);
@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Namespace.hpp>
 
+#include <string.h>  // memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringMover {
@@ -18,6 +20,12 @@ class StringMover {
       *(*_writePtr)++ = char(c);
     }
 
+    // s is further in the input, so the regions may overlap
+    void append(const char* s, size_t n) {
+      memmove(*_writePtr, s, n);
+      *_writePtr += n;
+    }
+
     char* complete() const {
       *(*_writePtr)++ = 0;
       return _startPtr;
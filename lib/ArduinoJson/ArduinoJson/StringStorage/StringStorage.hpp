@@ -18,9 +18,11 @@ struct StringStorage {
   }
 };
 
+// With ARDUINOJSON_COMPACT_SLOTS, the strings must be in the pool
 template <typename TChar>
-struct StringStorage<TChar*,
-                     typename enable_if<!is_const<TChar>::value>::type> {
+struct StringStorage<
+    TChar*, typename enable_if<!is_const<TChar>::value &&
+                               !ARDUINOJSON_COMPACT_SLOTS>::type> {
   typedef StringMover type;
 
   static type create(MemoryPool&, TChar* input) {
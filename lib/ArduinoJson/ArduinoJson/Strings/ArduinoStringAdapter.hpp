@@ -8,6 +8,7 @@
 
 #include <ArduinoJson/Polyfills/safe_strcmp.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -41,6 +42,10 @@ class ArduinoStringAdapter {
     return compare(expected) == 0;
   }
 
+  KeyHash hash() const {
+    return hashKey(_str->c_str());
+  }
+
   size_t size() const {
     return _str->length();
   }
@@ -9,6 +9,7 @@
 
 #include <ArduinoJson/Polyfills/safe_strcmp.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -25,6 +26,10 @@ class ConstRamStringAdapter {
     return compare(expected) == 0;
   }
 
+  KeyHash hash() const {
+    return hashKey(_str);
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -7,6 +7,7 @@
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Polyfills/pgmspace.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -29,6 +30,15 @@ class FlashStringAdapter {
     return compare(expected) == 0;
   }
 
+  KeyHash hash() const {
+    size_t n = size();
+    if (!n)
+      return hashKey(0, 0);
+    const char* p = reinterpret_cast<const char*>(_str);
+    return makeKeyHash(n, char(pgm_read_byte(p)),
+                       char(pgm_read_byte(p + n - 1)));
+  }
+
   bool isNull() const {
     return !_str;
   }
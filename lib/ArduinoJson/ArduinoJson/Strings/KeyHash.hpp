@@ -0,0 +1,47 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/attributes.hpp>
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t, uint16_t
+#include <string.h>  // strlen
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// An 8-bit hash of a key (see ARDUINOJSON_HASH_KEYS), made of its length, its
+// first character, and its last character: it costs a strlen() and tells
+// apart most keys of real documents, like "temp_min" and "temp_max", or
+// "sensor1" and "sensor2".
+// All the string adapters must hash the characters that equals() compares, or
+// getSlot() would miss keys: up to the terminator or the size.
+typedef uint8_t KeyHash;
+
+// Single return statements, so that KeyLiteral can hash at compile time
+inline ARDUINOJSON_CONSTEXPR KeyHash foldKeyHash(uint16_t hash) {
+  return KeyHash(hash ^ (hash >> 8));
+}
+
+inline ARDUINOJSON_CONSTEXPR KeyHash makeKeyHash(size_t length, char first,
+                                                char last) {
+  return foldKeyHash(
+      uint16_t(uint16_t(length * 31 + static_cast<unsigned char>(first)) * 31 +
+               static_cast<unsigned char>(last)));
+}
+
+// The hash of a null key is the hash of an empty key
+inline KeyHash hashKey(const char* key, size_t length) {
+  if (!length)
+    return makeKeyHash(0, 0, 0);
+  return makeKeyHash(length, key[0], key[length - 1]);
+}
+
+inline KeyHash hashKey(const char* key) {
+  return hashKey(key, key ? strlen(key) : 0);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
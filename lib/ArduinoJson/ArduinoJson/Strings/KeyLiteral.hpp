@@ -0,0 +1,82 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Polyfills/attributes.hpp>
+#include <ArduinoJson/Strings/ConstRamStringAdapter.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
+
+#include <stddef.h>  // size_t
+#include <string.h>  // strncmp
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A key known at compile time, with its size and its hash, so that
+// doc[JsonKey("wind")] doesn't call strlen() and, with ARDUINOJSON_HASH_KEYS,
+// only compares the keys with the same hash.
+// In C++11, it can be a constant:
+//   constexpr JsonKey windKey("wind");
+// CAUTION: the size comes from the array, so it only takes string literals.
+class KeyLiteral {
+ public:
+  template <size_t N>
+  ARDUINOJSON_CONSTEXPR KeyLiteral(const char (&str)[N])
+      : _str(str),
+        _size(N - 1),
+        _hash(N > 1 ? makeKeyHash(N - 1, str[0], str[N - 2])
+                    : makeKeyHash(0, 0, 0)) {}
+
+  ARDUINOJSON_CONSTEXPR const char* c_str() const {
+    return _str;
+  }
+
+  ARDUINOJSON_CONSTEXPR size_t size() const {
+    return _size;
+  }
+
+  ARDUINOJSON_CONSTEXPR KeyHash hash() const {
+    return _hash;
+  }
+
+ private:
+  const char* _str;
+  size_t _size;
+  KeyHash _hash;
+};
+
+// Stored by address, like a const char*
+class KeyLiteralAdapter : public ConstRamStringAdapter {
+ public:
+  KeyLiteralAdapter(const KeyLiteral& key)
+      : ConstRamStringAdapter(key.c_str()),
+        _size(key.size()),
+        _hash(key.hash()) {}
+
+  bool equals(const char* expected) const {
+    // the terminator of the literal ends the comparison
+    return expected && strncmp(expected, _str, _size + 1) == 0;
+  }
+
+  KeyHash hash() const {
+    return _hash;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+ private:
+  size_t _size;
+  KeyHash _hash;
+};
+
+template <>
+struct IsString<KeyLiteral> : true_type {};
+
+inline KeyLiteralAdapter adaptString(const KeyLiteral& key) {
+  return KeyLiteralAdapter(key);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
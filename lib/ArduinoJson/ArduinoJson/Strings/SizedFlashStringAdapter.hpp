@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -29,6 +30,22 @@ class SizedFlashStringAdapter {
     return compare(expected) == 0;
   }
 
+  // like strncmp_P(), stops at the terminator
+  KeyHash hash() const {
+    const char* p = reinterpret_cast<const char*>(_str);
+    size_t n = 0;
+    char first = 0, last = 0;
+    for (; p && n < _size; n++) {
+      char c = char(pgm_read_byte(p + n));
+      if (!c)
+        break;
+      if (!n)
+        first = c;
+      last = c;
+    }
+    return makeKeyHash(n, first, last);
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -6,6 +6,7 @@
 
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 #include <string.h>  // strcmp
@@ -24,6 +25,14 @@ class SizedRamStringAdapter {
     return compare(expected) == 0;
   }
 
+  // like strncmp(), stops at the terminator
+  KeyHash hash() const {
+    size_t n = 0;
+    if (_str)
+      while (n < _size && _str[n]) n++;
+    return hashKey(_str, n);
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -7,6 +7,7 @@
 #include <ArduinoJson/Memory/MemoryPool.hpp>
 #include <ArduinoJson/Namespace.hpp>
 #include <ArduinoJson/Strings/IsString.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
 #include <ArduinoJson/Strings/StoragePolicy.hpp>
 
 #include <string>
@@ -42,6 +43,10 @@ class StlStringAdapter {
     return *_str == expected;
   }
 
+  KeyHash hash() const {
+    return hashKey(_str->c_str(), _str->size());
+  }
+
   size_t size() const {
     return _str->size();
   }
@@ -55,8 +55,10 @@ class StringAdapter : public RamStringAdapter {
   }
 
   const char* save(MemoryPool* pool) const {
+#if !ARDUINOJSON_COMPACT_SLOTS  // the compact slots can only point to the pool
     if (_isStatic)
       return data();
+#endif
     return RamStringAdapter::save(pool);
   }
 
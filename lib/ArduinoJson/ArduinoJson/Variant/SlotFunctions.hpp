@@ -26,14 +26,6 @@ inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool,
   }
 }
 
-template <typename TAdaptedString>
-inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool*,
-                       storage_policy::store_by_address) {
-  ARDUINOJSON_ASSERT(var);
-  var->setLinkedKey(make_not_null(key.data()));
-  return true;
-}
-
 template <typename TAdaptedString>
 inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool,
                        storage_policy::store_by_copy) {
@@ -45,6 +37,24 @@ inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool,
   return true;
 }
 
+#if ARDUINOJSON_COMPACT_SLOTS
+// the compact slots can only point to the pool
+template <typename TAdaptedString>
+inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool,
+                       storage_policy::store_by_address) {
+  return slotSetKey(var, RamStringAdapter(key.data()), pool,
+                    storage_policy::store_by_copy());
+}
+#else
+template <typename TAdaptedString>
+inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool*,
+                       storage_policy::store_by_address) {
+  ARDUINOJSON_ASSERT(var);
+  var->setLinkedKey(make_not_null(key.data()));
+  return true;
+}
+#endif
+
 inline size_t slotSize(const VariantSlot* var) {
   size_t n = 0;
   while (var) {
@@ -0,0 +1,96 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2020
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson/Namespace.hpp>
+#include <ArduinoJson/Polyfills/assert.hpp>
+#include <ArduinoJson/Polyfills/type_traits.hpp>
+
+#include <stddef.h>  // ptrdiff_t, size_t
+#include <stdint.h>  // int16_t, int32_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+#if ARDUINOJSON_COMPACT_SLOTS
+
+// 16 bits on MCUs, where pools are small, 32 bits on computers
+typedef conditional<sizeof(void*) <= 4, int16_t, int32_t>::type SlotOffset;
+typedef conditional<sizeof(void*) <= 4, uint16_t, uint32_t>::type SlotSize;
+
+// A pointer stored as the distance from itself to its target (0 means null).
+// It remains valid as long as the pointer and its target move together, so
+// when a slot moves alone, its pointers must be updated (see move()).
+template <typename T>
+class SlotPointer {
+  SlotOffset _offset;
+
+ public:
+  // Must be a POD!
+  // - no constructor
+  // - no destructor
+  // - no virtual
+  // - no inheritance
+
+  T* get() const {
+    if (!_offset)
+      return 0;
+    return reinterpret_cast<T*>(
+        const_cast<char*>(reinterpret_cast<const char*>(this)) + _offset);
+  }
+
+  void set(T* p) {
+    if (!p) {
+      _offset = 0;
+      return;
+    }
+    ptrdiff_t offset =
+        reinterpret_cast<const char*>(p) - reinterpret_cast<const char*>(this);
+    ARDUINOJSON_ASSERT(offset == SlotOffset(offset));
+    _offset = SlotOffset(offset);
+  }
+
+  // The pointer moved by selfDistance, and its target by targetDistance
+  void move(ptrdiff_t selfDistance, ptrdiff_t targetDistance) {
+    if (_offset)
+      _offset = SlotOffset(_offset + targetDistance - selfDistance);
+  }
+};
+
+#else
+
+typedef size_t SlotSize;
+
+template <typename T>
+class SlotPointer {
+  T* _ptr;
+
+ public:
+  // Must be a POD!
+  // - no constructor
+  // - no destructor
+  // - no virtual
+  // - no inheritance
+
+  T* get() const {
+    return _ptr;
+  }
+
+  void set(T* p) {
+    _ptr = p;
+  }
+
+  // The pointer moved by selfDistance, and its target by targetDistance
+  void move(ptrdiff_t, ptrdiff_t targetDistance) {
+    if (!_ptr)
+      return;
+    _ptr = reinterpret_cast<T*>(reinterpret_cast<void*>(
+        const_cast<char*>(reinterpret_cast<const char*>(_ptr)) +
+        targetDistance));
+  }
+};
+
+#endif
+
+}  // namespace ARDUINOJSON_NAMESPACE
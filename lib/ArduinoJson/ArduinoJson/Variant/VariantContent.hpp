@@ -9,12 +9,14 @@
 #include <ArduinoJson/Collection/CollectionData.hpp>
 #include <ArduinoJson/Numbers/Float.hpp>
 #include <ArduinoJson/Numbers/Integer.hpp>
+#include <ArduinoJson/Variant/SlotPointer.hpp>
 
 namespace ARDUINOJSON_NAMESPACE {
 
 //
 enum {
   VALUE_MASK = 0x7F,
+  TYPE_MASK = 0x6F,  // VALUE_MASK without COLLECTION_IS_FRAGMENTED
 
   VALUE_IS_OWNED = 0x01,
   VALUE_IS_NULL = 0,
@@ -33,6 +35,9 @@ enum {
   VALUE_IS_OBJECT = 0x20,
   VALUE_IS_ARRAY = 0x40,
 
+  // the slots of the collection might not be contiguous (see CollectionData)
+  COLLECTION_IS_FRAGMENTED = 0x10,
+
   KEY_IS_OWNED = 0x80
 };
 
@@ -45,10 +50,10 @@ union VariantContent {
   Float asFloat;
   UInt asInteger;
   CollectionData asCollection;
-  const char *asString;
+  SlotPointer<const char> asString;
   struct {
-    const char *data;
-    size_t size;
+    SlotPointer<const char> data;
+    SlotSize size;
   } asRaw;
 };
 }  // namespace ARDUINOJSON_NAMESPACE
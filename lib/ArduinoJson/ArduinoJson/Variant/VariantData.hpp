@@ -47,11 +47,12 @@ class VariantData {
 
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
-        return visitor.visitString(_content.asString);
+        return visitor.visitString(_content.asString.get());
 
       case VALUE_IS_OWNED_RAW:
       case VALUE_IS_LINKED_RAW:
-        return visitor.visitRawJson(_content.asRaw.data, _content.asRaw.size);
+        return visitor.visitRawJson(_content.asRaw.data.get(),
+                                    _content.asRaw.size);
 
       case VALUE_IS_NEGATIVE_INTEGER:
         return visitor.visitNegativeInteger(_content.asInteger);
@@ -93,6 +94,11 @@ class VariantData {
     return const_cast<VariantData *>(this)->asObject();
   }
 
+  // Gets the string or the raw value stored in the pool, or null
+  const char *ownedString() const {
+    return (_flags & VALUE_IS_OWNED) ? _content.asString.get() : 0;
+  }
+
   bool copyFrom(const VariantData &src, MemoryPool *pool) {
     switch (src.type()) {
       case VALUE_IS_ARRAY:
@@ -100,10 +106,19 @@ class VariantData {
       case VALUE_IS_OBJECT:
         return toObject().copyFrom(src._content.asCollection, pool);
       case VALUE_IS_OWNED_STRING:
-        return setOwnedString(RamStringAdapter(src._content.asString), pool);
+        return setOwnedString(RamStringAdapter(src._content.asString.get()),
+                              pool);
       case VALUE_IS_OWNED_RAW:
         return setOwnedRaw(
-            serialized(src._content.asRaw.data, src._content.asRaw.size), pool);
+            serialized(src._content.asRaw.data.get(), src._content.asRaw.size),
+            pool);
+      case VALUE_IS_LINKED_STRING:
+        setLinkedString(src._content.asString.get());
+        return true;
+      case VALUE_IS_LINKED_RAW:
+        setLinkedRaw(
+            serialized(src._content.asRaw.data.get(), src._content.asRaw.size));
+        return true;
       default:
         setType(src.type());
         _content = src._content;
@@ -119,13 +134,13 @@ class VariantData {
     switch (type()) {
       case VALUE_IS_LINKED_STRING:
       case VALUE_IS_OWNED_STRING:
-        return !strcmp(_content.asString, other._content.asString);
+        return !strcmp(_content.asString.get(), other._content.asString.get());
 
       case VALUE_IS_LINKED_RAW:
       case VALUE_IS_OWNED_RAW:
         return _content.asRaw.size == other._content.asRaw.size &&
-               !memcmp(_content.asRaw.data, other._content.asRaw.data,
-                       _content.asRaw.size);
+               !memcmp(_content.asRaw.data.get(),
+                       other._content.asRaw.data.get(), _content.asRaw.size);
 
       case VALUE_IS_BOOLEAN:
       case VALUE_IS_POSITIVE_INTEGER:
@@ -218,20 +233,26 @@ class VariantData {
   void setLinkedRaw(SerializedValue<const char *> value) {
     if (value.data()) {
       setType(VALUE_IS_LINKED_RAW);
-      _content.asRaw.data = value.data();
-      _content.asRaw.size = value.size();
+      _content.asRaw.data.set(value.data());
+      _content.asRaw.size = SlotSize(value.size());
     } else {
       setType(VALUE_IS_NULL);
     }
   }
 
+  void setOwnedRaw(not_null<const char *> data, size_t size) {
+    setType(VALUE_IS_OWNED_RAW);
+    _content.asRaw.data.set(data.get());
+    _content.asRaw.size = SlotSize(size);
+  }
+
   template <typename T>
   bool setOwnedRaw(SerializedValue<T> value, MemoryPool *pool) {
     char *dup = adaptString(value.data(), value.size()).save(pool);
     if (dup) {
       setType(VALUE_IS_OWNED_RAW);
-      _content.asRaw.data = dup;
-      _content.asRaw.size = value.size();
+      _content.asRaw.data.set(dup);
+      _content.asRaw.size = SlotSize(value.size());
       return true;
     } else {
       setType(VALUE_IS_NULL);
@@ -273,10 +294,26 @@ class VariantData {
     _content.asInteger = value;
   }
 
+  // Stores a number of scanNumber(), if there is one
+  template <typename TParsedNumber>
+  void setNumber(const TParsedNumber &num) {
+    switch (num.type()) {
+      case VALUE_IS_NEGATIVE_INTEGER:
+        setNegativeInteger(num.uintValue);
+        break;
+      case VALUE_IS_POSITIVE_INTEGER:
+        setPositiveInteger(num.uintValue);
+        break;
+      case VALUE_IS_FLOAT:
+        setFloat(num.floatValue);
+        break;
+    }
+  }
+
   void setLinkedString(const char *value) {
     if (value) {
       setType(VALUE_IS_LINKED_STRING);
-      _content.asString = value;
+      _content.asString.set(value);
     } else {
       setType(VALUE_IS_NULL);
     }
@@ -288,7 +325,7 @@ class VariantData {
 
   void setOwnedString(not_null<const char *> s) {
     setType(VALUE_IS_OWNED_STRING);
-    _content.asString = s.get();
+    _content.asString.set(s.get());
   }
 
   bool setOwnedString(const char *s) {
@@ -321,7 +358,7 @@ class VariantData {
   size_t memoryUsage() const {
     switch (type()) {
       case VALUE_IS_OWNED_STRING:
-        return strlen(_content.asString) + 1;
+        return strlen(_content.asString.get()) + 1;
       case VALUE_IS_OWNED_RAW:
         return _content.asRaw.size;
       case VALUE_IS_OBJECT:
@@ -374,16 +411,31 @@ class VariantData {
     return _content.asCollection.getOrAddMember(key, pool);
   }
 
-  void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
+  bool isFragmented() const {
+    return (_flags & COLLECTION_IS_FRAGMENTED) != 0;
+  }
+
+  void setFragmented(bool fragmented) {
+    if (fragmented)
+      _flags |= COLLECTION_IS_FRAGMENTED;
+    else
+      _flags &= uint8_t(~COLLECTION_IS_FRAGMENTED);
+  }
+
+  // This variant moved by selfDistance, the strings by stringDistance, and
+  // the slots by variantDistance
+  void movePointers(ptrdiff_t selfDistance, ptrdiff_t stringDistance,
+                    ptrdiff_t variantDistance) {
     if (_flags & VALUE_IS_OWNED)
-      _content.asString += stringDistance;
+      _content.asString.move(selfDistance, stringDistance);
     if (_flags & COLLECTION_MASK)
-      _content.asCollection.movePointers(stringDistance, variantDistance);
+      _content.asCollection.movePointers(selfDistance, stringDistance,
+                                         variantDistance);
   }
 
  private:
   uint8_t type() const {
-    return _flags & VALUE_MASK;
+    return _flags & TYPE_MASK;
   }
 
   void setType(uint8_t t) {
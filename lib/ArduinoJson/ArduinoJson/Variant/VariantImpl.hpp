@@ -24,7 +24,7 @@ inline T VariantData::asIntegral() const {
       return convertNegativeInteger<T>(_content.asInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
-      return parseInteger<T>(_content.asString);
+      return parseInteger<T>(_content.asString.get());
     case VALUE_IS_FLOAT:
       return convertFloat<T>(_content.asFloat);
     default:
@@ -58,7 +58,7 @@ inline T VariantData::asFloat() const {
       return -static_cast<T>(_content.asInteger);
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
-      return parseFloat<T>(_content.asString);
+      return parseFloat<T>(_content.asString.get());
     case VALUE_IS_FLOAT:
       return static_cast<T>(_content.asFloat);
     default:
@@ -70,7 +70,7 @@ inline const char *VariantData::asString() const {
   switch (type()) {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
-      return _content.asString;
+      return _content.asString.get();
     default:
       return 0;
   }
@@ -189,6 +189,11 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   // set(SerializedValue<const char *>)
   FORCE_INLINE bool set(SerializedValue<const char *> value) const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    // the compact slots can only point to the pool
+    if (value.data())
+      return variantSetOwnedRaw(_data, value, _pool);
+#endif
     return variantSetLinkedRaw(_data, value);
   }
 
@@ -221,6 +226,11 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   // set(const char*);
   FORCE_INLINE bool set(const char *value) const {
+#if ARDUINOJSON_COMPACT_SLOTS
+    // the compact slots can only point to the pool
+    if (value)
+      return variantSetOwnedString(_data, RamStringAdapter(value), _pool);
+#endif
     return variantSetLinkedString(_data, value);
   }
 
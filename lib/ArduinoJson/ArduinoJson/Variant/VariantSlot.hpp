@@ -6,6 +6,8 @@
 
 #include <ArduinoJson/Polyfills/gsl/not_null.hpp>
 #include <ArduinoJson/Polyfills/type_traits.hpp>
+#include <ArduinoJson/Strings/KeyHash.hpp>
+#include <ArduinoJson/Variant/SlotPointer.hpp>
 #include <ArduinoJson/Variant/VariantContent.hpp>
 
 #include <stdint.h>  // int8_t, int16_t
@@ -20,8 +22,11 @@ class VariantSlot {
   // (+20% on ESP8266 for example)
   VariantContent _content;
   uint8_t _flags;
+#if ARDUINOJSON_HASH_KEYS
+  KeyHash _keyHash;
+#endif
   VariantSlotDiff _next;
-  const char* _key;
+  SlotPointer<const char> _key;
 
  public:
   // Must be a POD!
@@ -60,6 +65,11 @@ class VariantSlot {
     return const_cast<VariantSlot*>(this)->next(distance);
   }
 
+  // Distance to the next slot (negative), or 0 for the last slot
+  ptrdiff_t nextDistance() const {
+    return _next;
+  }
+
   void setNext(VariantSlot* slot) {
     _next = VariantSlotDiff(slot ? slot - this : 0);
   }
@@ -71,35 +81,59 @@ class VariantSlot {
 
   void setOwnedKey(not_null<const char*> k) {
     _flags |= KEY_IS_OWNED;
-    _key = k.get();
+    _key.set(k.get());
+#if ARDUINOJSON_HASH_KEYS
+    _keyHash = hashKey(k.get());
+#endif
   }
 
   void setLinkedKey(not_null<const char*> k) {
     _flags &= VALUE_MASK;
-    _key = k.get();
+    _key.set(k.get());
+#if ARDUINOJSON_HASH_KEYS
+    _keyHash = hashKey(k.get());
+#endif
   }
 
   const char* key() const {
-    return _key;
+    return _key.get();
+  }
+
+#if ARDUINOJSON_HASH_KEYS
+  KeyHash keyHash() const {
+    return _keyHash;
   }
+#endif
 
   bool ownsKey() const {
     return (_flags & KEY_IS_OWNED) != 0;
   }
 
+  // The owned key moved by distance
+  void moveKey(ptrdiff_t distance) {
+    _key.move(0, distance);
+  }
+
   void clear() {
     _next = 0;
     _flags = 0;
-    _key = 0;
+    _key.set(0);
+#if ARDUINOJSON_HASH_KEYS
+    _keyHash = 0;
+#endif
   }
 
-  void movePointers(ptrdiff_t stringDistance, ptrdiff_t variantDistance) {
+  // This slot moved by selfDistance, the strings by stringDistance, and the
+  // other slots by variantDistance
+  void movePointers(ptrdiff_t selfDistance, ptrdiff_t stringDistance,
+                    ptrdiff_t variantDistance) {
     if (_flags & KEY_IS_OWNED)
-      _key += stringDistance;
+      _key.move(selfDistance, stringDistance);
     if (_flags & VALUE_IS_OWNED)
-      _content.asString += stringDistance;
+      _content.asString.move(selfDistance, stringDistance);
     if (_flags & COLLECTION_MASK)
-      _content.asCollection.movePointers(stringDistance, variantDistance);
+      _content.asCollection.movePointers(selfDistance, stringDistance,
+                                         variantDistance);
   }
 };
 
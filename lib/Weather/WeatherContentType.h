@@ -0,0 +1,24 @@
+#pragma once
+
+#include <ctype.h>
+#include <string.h>
+
+/**
+ * Tells if the Content-Type header of an answer announces JSON, like "application/json" or "application/json; charset=utf-8".
+ * A captive portal answers with "text/html" instead, and this check costs nothing next to the body.
+ * An empty or missing header is accepted, the body will tell.
+ * */
+inline bool weatherIsJsonContentType(const char* contentType) {
+  if (!contentType || !*contentType) {
+    return true;
+  }
+  const char* expected = "application/json";
+  size_t length = strlen(expected);
+  for (size_t i = 0; i < length; i++) {
+    if (tolower(static_cast<unsigned char>(contentType[i])) != expected[i]) { // INFO: stops at the end of contentType too, as '\0' matches nothing
+      return false;
+    }
+  }
+  char next = contentType[length];
+  return next == '\0' || next == ';' || next == ' ';
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <ArduinoJson.h>
+#include <TimeLib.h>
+#include <WeatherReport.h>
+
+#ifdef PROGMEM
+#define WEATHER_PROGMEM PROGMEM
+#else
+#define WEATHER_PROGMEM // INFO: on the computer, "flash" is plain constant data
+#endif
+
+/**
+ * Static configuration, read from flash: only its index (one FlashNode per value) is in RAM.
+ * shutdownHours is indexed by month (1 = january); 0 means no watering that month.
+ * */
+const char weatherConfigJson[] WEATHER_PROGMEM = "{"
+  "\"shutdownHours\": [0, 0, 0, 0, 20, 20, 21, 21, 21, 20, 20, 0, 0],"
+  "\"startHour\": 8,"
+  "\"maxWind\": 2"
+"}";
+typedef StaticFlashDocument<128> WeatherConfig;
+
+/**
+ * Calculates local hour for WEST (Western europen time zone)
+ * */
+inline int weatherLocalHour(signed long unixtime) {
+  int _month = month(unixtime);
+  int _hour = hour(unixtime);
+  if (_month >= 3 && _month <= 10) {
+    // most likely it is daily savings time, let's check the details
+
+    // make a time as 1 of April, this year
+    tmElements_t time;
+    time.Month = 4; // april
+    time.Day = 1;
+    time.Year = year(unixtime);
+    time.Hour = 0;
+    time.Minute = 0;
+    time.Second = 0;
+    time_t firstOfApril = makeTime(time);
+    time_t _previousSunday = previousSunday(firstOfApril) + 60 * 60; // last sunday in march at 01 o'clock
+
+    if (unixtime >= _previousSunday) {
+      //  ok, the last sunday in march , 01 o'clock has passed
+      time.Month = 11;  // November
+      time.Day = 1;
+      time_t firstOfNovember = makeTime(time);
+      time_t _previousSunday = previousSunday(firstOfNovember) + 60 * 60; // last sunday in october, 01 o'clock
+      if (unixtime <= _previousSunday) {
+        // indeed, it is daily savings time
+        _hour += 3; // time offset must be manually added (+ 2)
+        if (_hour >= 24) {
+          return _hour - 24;
+        } else {
+          return _hour;
+        }
+      }
+    }
+  }
+  _hour += 2;
+  if (_hour >= 24) {
+    return _hour - 24;
+  } else {
+    return _hour;
+  }
+}
+
+struct WeatherDecision {
+  int month;
+  int hour; // local hour in germany preserving daily savings time
+  bool goodTime;
+  bool goodWind;
+  bool goodWeather;
+
+  bool pumpOn() const {
+    return goodTime && goodWind && goodWeather;
+  }
+};
+
+/**
+ * Decides if the pump runs for a weather report.
+ * The firmware and tools/replay both call it, so that replayed answers get the same outcome as on the chip.
+ * INFO: TimeLib caches the last broken-down time in globals, so this must not run on several threads at once.
+ * */
+inline WeatherDecision weatherDecide(const WeatherReport& report, const FlashDocument& config) {
+  WeatherDecision decision;
+  unsigned long unixtime = report.dt;
+  decision.month = month(unixtime);
+  decision.hour = weatherLocalHour(unixtime);
+  int uppermax = config["shutdownHours"][size_t(decision.month)].as<int>(); // dynamically change shutdown hour depending on month
+  decision.goodTime = decision.month >= 4 && decision.month <= 10 && decision.hour >= config["startHour"].as<int>() && decision.hour < uppermax;
+  decision.goodWind = report.wind.speed <= config["maxWind"].as<float>();
+  decision.goodWeather = weatherIsGood(report);
+  return decision;
+}
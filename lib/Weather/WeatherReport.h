@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ArduinoJson.h>
+
+/**
+ * The parts of the weather website's answer the pump logic needs.
+ * deserializeJson() writes straight into this struct, so no JsonDocument is needed.
+ * */
+struct WeatherWind {
+  float speed;
+};
+JSON_BINDING(WeatherWind, JSON_FIELD(WeatherWind, speed))
+
+struct WeatherCondition {
+  int id;
+};
+JSON_BINDING(WeatherCondition, JSON_FIELD(WeatherCondition, id))
+
+struct WeatherReport {
+  unsigned long dt;
+  WeatherWind wind;
+  WeatherCondition weather[4]; // INFO: the website rarely reports more than 2 states, the most significant first; the ones after the 4th are skipped
+  uint8_t weatherCount; // INFO: all the states of the answer, so it exceeds 4 when some were skipped
+
+  uint8_t storedWeatherCount() const {
+    return weatherCount < 4 ? weatherCount : 4;
+  }
+};
+JSON_BINDING(WeatherReport,
+  JSON_FIELD(WeatherReport, dt),
+  JSON_FIELD(WeatherReport, wind),
+  JSON_ARRAY_FIELD(WeatherReport, weather, weatherCount))
+
+/**
+ * True if no state of the report is bad weather (id below 800).
+ * A state that wasn't stored could be bad weather, so a report with skipped states isn't good weather either.
+ * */
+inline bool weatherIsGood(const WeatherReport& report) {
+  if (report.weatherCount > report.storedWeatherCount()) {
+    return false;
+  }
+  for (uint8_t index = 0; index < report.storedWeatherCount(); index++) {
+    if (report.weather[index].id < 800) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -3,6 +3,9 @@
 #include <ESP8266WiFi.h>
 #include <ESP8266HTTPClient.h>
 #include <TimeLib.h>
+#include <WeatherContentType.h>
+#include <WeatherDecision.h>
+#include <WeatherReport.h>
 #include <list>
 
 const uint8_t powerLED = D4;
@@ -17,12 +20,13 @@ const uint8_t signalB = D6;
 WiFiClient client;
 HTTPClient http;
 String responseData;
-DynamicJsonDocument weatherDoc(15360);
-JsonArray reports;
+WeatherReport report;
 
 const char* ssid = "Erpix";
 const char* password = "lolno";
 
+WeatherConfig config;
+
 void rgbBlink (boolean red, boolean green, boolean blue, int duration) {
   if (red) {
     digitalWrite(signalR, HIGH);
@@ -64,51 +68,6 @@ void errorHandler(String error) {
   ESP.reset();
 }
 
-/**
- * Calculates local hour for WEST (Western europen time zone)
- * */
-int localHourTime(signed long unixtime) {
-  int _month = month(unixtime);
-  int _hour = hour(unixtime);
-  if (_month >= 3 && _month <= 10) {
-    // most likely it is daily savings time, let's check the details
-
-    // make a time as 1 of April, this year
-    tmElements_t time;
-    time.Month = 4; // april
-    time.Day = 1;
-    time.Year = year(unixtime);
-    time.Hour = 0;
-    time.Minute = 0;
-    time.Second = 0;
-    time_t firstOfApril = makeTime(time);
-    time_t _previousSunday = previousSunday(firstOfApril) + 60 * 60; // last sunday in march at 01 o'clock
-
-    if (unixtime >= _previousSunday) {
-      //  ok, the last sunday in march , 01 o'clock has passed
-      time.Month = 11;  // November
-      time.Day = 1;
-      time_t firstOfNovember = makeTime(time);
-      time_t _previousSunday = previousSunday(firstOfNovember) + 60 * 60; // last sunday in october, 01 o'clock
-      if (unixtime <= _previousSunday) {
-        // indeed, it is daily savings time
-        _hour += 3; // time offset must be manually added (+ 2)
-        if (_hour >= 24) {
-          return _hour - 24;
-        } else {
-          return _hour;
-        }
-      }
-    }
-  }
-  _hour += 2;
-  if (_hour >= 24) {
-    return _hour - 24;
-  } else {
-    return _hour;
-  }
-}
-
 void setup() {
   Serial.begin(115200);
   pinMode(powerLED, OUTPUT);
@@ -123,6 +82,12 @@ void setup() {
   Serial.println();
   Serial.println("Startup complete.");
   Serial.println("~~~~~~~~~~~~~~~~~");
+  DeserializationError error = deserializeJson(config, weatherConfigJson);
+  if (error) {
+    String errorMsg("Configuration Error: ");
+    errorMsg.concat(error.c_str());
+    errorHandler(errorMsg);
+  }
   digitalWrite(powerLED, HIGH);
 }
 
@@ -162,6 +127,8 @@ void loop() {
     }
     Serial.print("Contacting Weather Website....");
     http.begin(client, "norhere");
+    const char* headerKeys[] = {"Content-Type"};
+    http.collectHeaders(headerKeys, 1); // INFO: HTTPClient drops the headers it isn't asked to keep
     int httpCode = http.GET(); // fetch the GET code of the HTTP request, INFO: http.GET() is synchronous
     if (httpCode == 302) { //INFO: 302 occurs usually when the chip itself is denied internet access and is thus moved to the router's internet blockage website
         Serial.print("Failed! (");
@@ -175,10 +142,29 @@ void loop() {
     } else {
       if (httpCode >= 200 && httpCode < 400) {
         responseData = http.getString(); // if the code is good, get the fetchable data
-        Serial.print("Done! (");
-        Serial.print(httpCode);
-        Serial.println(")");
-        esc = true; // escape from the fail-repeating loop with requested information
+        DeserializationError sniffed = DeserializationError::InvalidInput;
+        if (weatherIsJsonContentType(http.header("Content-Type").c_str())) {
+          sniffed = sniffJson(responseData); // INFO: a captive portal may answer 200 with an HTML page; this fails on its first byte, before deserializeJson() touches the report
+        }
+        if (sniffed) {
+          Serial.print("Failed! (");
+          Serial.print(httpCode);
+          Serial.print(", ");
+          Serial.print(http.header("Content-Type"));
+          Serial.print(", ");
+          Serial.print(sniffed.c_str());
+          Serial.println(") (Is the chip behind a captive portal?)");
+          digitalWrite(errorLED, HIGH);
+          delay(500);
+          digitalWrite(errorLED, LOW);
+          delay(500);
+          tries++;
+        } else {
+          Serial.print("Done! (");
+          Serial.print(httpCode);
+          Serial.println(")");
+          esc = true; // escape from the fail-repeating loop with requested information
+        }
       } else {
         Serial.print("Failed! (");
         Serial.print(httpCode);
@@ -196,48 +182,22 @@ void loop() {
   }
 
   Serial.print("Processing Data....");
-  DeserializationError error = deserializeJson(weatherDoc, responseData);
+  report = WeatherReport(); // INFO: fields missing from the answer must not keep the previous hour's values
+  DeserializationError error = deserializeJson(report, responseData);
   if (error) {
     String errorMsg("Parsing Error: ");
     errorMsg.concat(error.c_str());
     errorHandler(errorMsg);
   }
 
-  float wind = weatherDoc["wind"]["speed"];
-  unsigned long unixtime = weatherDoc["dt"];
-  int timeM = month(unixtime);
-  int timeH = localHourTime(unixtime); // local hour in germany preserving daily savings time
-  int uppermax = 0;
-  switch (timeM) { // dynamically change shutdown hour depending on month
-    case 4: uppermax = 20; break;
-    case 5: uppermax = 20; break;
-    case 6: uppermax = 21; break;
-    case 7: uppermax = 21; break;
-    case 8: uppermax = 21; break;
-    case 9: uppermax = 20; break;
-    case 10: uppermax = 20; break;
-  }
-  JsonArray weather = weatherDoc["weather"].as<JsonArray>(); // get the current weather states as an array
-  int weatherids[weather.size()];
-  int index = 0; // INFO: the index is explicitly for the currweatherids array
-  for(JsonVariant obj : weather) {
-    weatherids[index] = obj["id"].as<int>(); // save states' id in array
-    index++;
-  }
-  boolean goodTime = false;
-  boolean goodWeather = true;
-  boolean goodWind = false;
-  for (int id : weatherids) {
-    if (id < 800) { // INFO: the logic is reversed; while by default its true, if one bad weather is seen, the boolean is false. this is to increase priority of bad weather
-      goodWeather = false;
-    }
-  }
-  if (timeM >= 4 && timeM <= 10 && timeH >= 8 && timeH < uppermax) {
-    goodTime = true;
-  }
-  if (wind <= 2) {
-    goodWind = true;
-  }
+  float wind = report.wind.speed;
+  unsigned long unixtime = report.dt;
+  WeatherDecision decision = weatherDecide(report, config);
+  int timeM = decision.month;
+  int timeH = decision.hour;
+  boolean goodTime = decision.goodTime;
+  boolean goodWeather = decision.goodWeather;
+  boolean goodWind = decision.goodWind;
   Serial.println("Done!");
 
   ledBlink(waterLED, 4, 50, true);
@@ -281,13 +241,16 @@ void loop() {
   }
 
   Serial.print(" (Id's:");
-  for (int id : weatherids) {
+  for (uint8_t index = 0; index < report.storedWeatherCount(); index++) {
     Serial.print(" ");
-    Serial.print(id);
+    Serial.print(report.weather[index].id);
+  }
+  if (report.weatherCount > report.storedWeatherCount()) {
+    Serial.print(" ...");
   }
   Serial.println(")");
 
-  if (goodTime && goodWeather && goodWind) {
+  if (decision.pumpOn()) {
     Serial.println("Outcome: Environment fits requirements. Pump is on.");
     digitalWrite(waterLED, HIGH);
     digitalWrite(bridge, HIGH);
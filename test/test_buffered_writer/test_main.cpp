@@ -0,0 +1,172 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+/**
+ * Stands in for Arduino's Print, which the computer doesn't have
+ * */
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* s, size_t n) {
+    size_t written = 0;
+    while (n-- && write(*s++)) {
+      written++;
+    }
+    return written;
+  }
+};
+
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT 1
+#include <ArduinoJson.h>
+#include <sstream>
+#include <unity.h>
+
+using ARDUINOJSON_NAMESPACE::BufferingWriter;
+using ARDUINOJSON_NAMESPACE::Writer;
+
+/**
+ * BufferingWriter, and the destinations serialize() buffers: every std::ostream, and only the Prints that opt in
+ * (ARDUINOJSON_BUFFER_PRINT is 0 here).
+ * */
+
+/**
+ * Keeps the bytes and counts the calls of write(); refuses the bytes after capacity
+ * */
+class CountingPrint : public Print {
+ public:
+  explicit CountingPrint(size_t capacity = 4096) : calls(0), _capacity(capacity) {}
+
+  size_t write(uint8_t c) {
+    calls++;
+    if (output.size() >= _capacity) {
+      return 0;
+    }
+    output += char(c);
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    calls++;
+    size_t room = _capacity - output.size();
+    if (n > room) {
+      n = room;
+    }
+    output.append(reinterpret_cast<const char*>(s), n);
+    return n;
+  }
+
+  std::string output;
+  size_t calls;
+
+ private:
+  size_t _capacity;
+};
+
+/**
+ * A Print whose write() is expensive enough to be buffered
+ * */
+class SlowPrint : public CountingPrint {
+ public:
+  explicit SlowPrint(size_t capacity = 4096) : CountingPrint(capacity) {}
+};
+
+namespace ARDUINOJSON_NAMESPACE {
+template <>
+struct IsBufferedDestination<SlowPrint> : true_type {};
+}
+
+StaticJsonDocument<4096> doc;
+std::string expected;
+
+void setUp() {
+  doc.clear();
+  for (int i = 0; i < 50; i++) {
+    JsonObject item = doc.createNestedObject();
+    item["id"] = i;
+    item["name"] = "forecast";
+    item["temp"] = 280.5 + i;
+  }
+  expected.clear();
+  serializeJson(doc, expected);
+}
+
+void tearDown() {}
+
+void test_block_writes() {
+  CountingPrint print;
+  BufferingWriter<Writer<CountingPrint>, 8> writer((Writer<CountingPrint>(print)));
+  for (uint8_t i = 0; i < 20; i++) {
+    TEST_ASSERT_EQUAL_size_t(1, writer.write(uint8_t('a' + i)));
+  }
+  TEST_ASSERT_EQUAL_size_t(2, print.calls); // INFO: the last 4 bytes wait for flush()
+  writer.flush();
+  TEST_ASSERT_EQUAL_size_t(3, print.calls);
+  TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrst", print.output.c_str());
+  TEST_ASSERT_EQUAL_size_t(20, writer.bytesWritten());
+}
+
+void test_large_block_goes_straight_through() {
+  CountingPrint print;
+  BufferingWriter<Writer<CountingPrint>, 8> writer((Writer<CountingPrint>(print)));
+  writer.write('<');
+  writer.write(reinterpret_cast<const uint8_t*>("0123456789"), 10);
+  writer.write('>');
+  writer.flush();
+  TEST_ASSERT_EQUAL_STRING("<0123456789>", print.output.c_str());
+  TEST_ASSERT_EQUAL_size_t(3, print.calls); // INFO: "<", the block, ">"
+}
+
+void test_print_is_not_buffered_by_default() {
+  CountingPrint print;
+  TEST_ASSERT_EQUAL_size_t(expected.size(), serializeJson(doc, print));
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), print.output.c_str());
+  TEST_ASSERT_TRUE(print.calls > expected.size() / 2); // INFO: about one call per byte
+}
+
+void test_print_that_opts_in() {
+  SlowPrint print;
+  TEST_ASSERT_EQUAL_size_t(expected.size(), serializeJson(doc, print));
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), print.output.c_str());
+  // INFO: a block is sent before it is full when the next string does not fit
+  TEST_ASSERT_TRUE(print.calls <= 2 * expected.size() / ARDUINOJSON_WRITE_BUFFER_SIZE + 1);
+
+  SlowPrint pretty;
+  std::string expectedPretty;
+  serializeJsonPretty(doc, expectedPretty);
+  TEST_ASSERT_EQUAL_size_t(expectedPretty.size(), serializeJsonPretty(doc, pretty));
+  TEST_ASSERT_EQUAL_STRING(expectedPretty.c_str(), pretty.output.c_str());
+
+  SlowPrint msgPack;
+  std::string expectedMsgPack;
+  serializeMsgPack(doc, expectedMsgPack);
+  TEST_ASSERT_EQUAL_size_t(expectedMsgPack.size(), serializeMsgPack(doc, msgPack));
+  TEST_ASSERT_TRUE(expectedMsgPack == msgPack.output);
+}
+
+void test_full_print_is_reported() {
+  CountingPrint direct(100);
+  TEST_ASSERT_EQUAL_size_t(100, serializeJson(doc, direct));
+  SlowPrint buffered(100);
+  TEST_ASSERT_EQUAL_size_t(100, serializeJson(doc, buffered));
+  TEST_ASSERT_EQUAL_STRING(direct.output.c_str(), buffered.output.c_str());
+}
+
+void test_ostream_is_buffered() {
+  std::ostringstream os;
+  TEST_ASSERT_EQUAL_size_t(expected.size(), serializeJson(doc, os));
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), os.str().c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_block_writes);
+  RUN_TEST(test_large_block_goes_straight_through);
+  RUN_TEST(test_print_is_not_buffered_by_default);
+  RUN_TEST(test_print_that_opts_in);
+  RUN_TEST(test_full_print_is_reported);
+  RUN_TEST(test_ostream_is_buffered);
+  return UNITY_END();
+}
@@ -0,0 +1,113 @@
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * measureJsonCapacity(): capacity() must be the smallest capacity that deserializes the input, with the same filter
+ * and nesting limit, and the parts of the report must add up to it.
+ * */
+
+const char* answer = "{\"coord\":{\"lon\":8.68,\"lat\":50.11},\"weather\":[{\"id\":800,\"main\":\"Clear\"},{\"id\":701,\"main\":\"Mist\"}],"
+                     "\"main\":{\"temp\":291.5,\"humidity\":52},\"wind\":{\"speed\":1.5,\"deg\":250},\"dt\":1600000000,"
+                     "\"name\":\"Frankfurt am Main\"}";
+
+const char* weatherFilter = "{\"dt\":true,\"wind\":{\"speed\":true},\"weather\":[{\"id\":true}]}";
+
+const size_t step = sizeof(void*); // INFO: the capacities are padded to this
+
+/**
+ * The reported capacity works, and the next smaller one doesn't
+ * */
+template <typename TFilter>
+void checkSmallest(const JsonCapacityReport& report, const char* json, TFilter filter) {
+  TEST_ASSERT_EQUAL_STRING("Ok", report.error.c_str());
+  TEST_ASSERT_EQUAL_size_t(0, report.capacity() % step);
+  DynamicJsonDocument exact(report.capacity());
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(exact, json, filter).c_str());
+  TEST_ASSERT_EQUAL_size_t(report.variants * sizeof(ARDUINOJSON_NAMESPACE::VariantSlot) + report.strings,
+                           exact.memoryUsage());
+  if (report.capacity() >= step) {
+    DynamicJsonDocument smaller(report.capacity() - step);
+    TEST_ASSERT_EQUAL_STRING("NoMemory", deserializeJson(smaller, json, filter).c_str());
+  }
+}
+
+StaticJsonDocument<8> all; // INFO: the filter that keeps everything, like no filter
+
+void setUp() {
+  all.set(true);
+}
+void tearDown() {}
+
+void test_small_documents() {
+  JsonCapacityReport report = measureJsonCapacity("{\"a\":1,\"b\":[1,2]}");
+  TEST_ASSERT_EQUAL_size_t(4, report.variants); // INFO: a, b, and the two elements
+  TEST_ASSERT_EQUAL_size_t(4, report.strings);  // INFO: "a" and "b"
+  TEST_ASSERT_EQUAL_size_t(step - 4, report.padding);
+  TEST_ASSERT_EQUAL_size_t(0, report.transient);
+  TEST_ASSERT_EQUAL_size_t(JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(2) + step, report.capacity());
+  checkSmallest(report, "{\"a\":1,\"b\":[1,2]}", DeserializationOption::Filter(all));
+
+  report = measureJsonCapacity("42");
+  TEST_ASSERT_EQUAL_STRING("Ok", report.error.c_str());
+  TEST_ASSERT_EQUAL_size_t(0, report.capacity()); // INFO: the root isn't in the pool
+}
+
+void test_answer() {
+  JsonCapacityReport report = measureJsonCapacity(answer);
+  checkSmallest(report, answer, DeserializationOption::Filter(all));
+  TEST_ASSERT_EQUAL_size_t(18, report.variants); // INFO: 6 members, 2 in coord, 2 + 4 in weather, 2 in main, 2 in wind
+}
+
+void test_filter() {
+  StaticJsonDocument<256> filter;
+  deserializeJson(filter, weatherFilter);
+  JsonCapacityReport report = measureJsonCapacity(answer, DeserializationOption::Filter(filter));
+  checkSmallest(report, answer, DeserializationOption::Filter(filter));
+  TEST_ASSERT_EQUAL_size_t(8, report.variants); // INFO: dt, wind, speed, weather, 2 elements, and their ids
+  TEST_ASSERT_TRUE(report.transient > 0); // INFO: the key "name" is stored before the filter drops it
+}
+
+void test_inputs() {
+  std::string input = answer;
+  JsonCapacityReport fromString = measureJsonCapacity(input);
+  char mutableInput[512];
+  strcpy(mutableInput, answer);
+  JsonCapacityReport fromMutable = measureJsonCapacity(mutableInput);
+  TEST_ASSERT_EQUAL_STRING(answer, mutableInput); // INFO: the strings are copied, the input can be parsed again
+  TEST_ASSERT_EQUAL_size_t(fromString.capacity(), fromMutable.capacity());
+  TEST_ASSERT_EQUAL_size_t(fromString.variants, fromMutable.variants);
+  TEST_ASSERT_EQUAL_size_t(fromString.strings, fromMutable.strings);
+}
+
+void test_errors() {
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", measureJsonCapacity("{\"a\":tru3}").error.c_str());
+  TEST_ASSERT_EQUAL_STRING("IncompleteInput", measureJsonCapacity("[1,2").error.c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep", measureJsonCapacity("[[[1]]]", DeserializationOption::NestingLimit(2)).error.c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", measureJsonCapacity("[[[1]]]", DeserializationOption::NestingLimit(3)).error.c_str());
+}
+
+void test_large_input() {
+  std::string json = "[";
+  for (int i = 0; i < 300; i++) {
+    json += "{\"id\":";
+    json += std::to_string(i);
+    json += ",\"text\":\"a longer string, to grow the first document\"},";
+  }
+  json += "null]";
+  JsonCapacityReport report = measureJsonCapacity(json);
+  TEST_ASSERT_EQUAL_size_t(300 * 3 + 1, report.variants);
+  checkSmallest(report, json.c_str(), DeserializationOption::Filter(all));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_small_documents);
+  RUN_TEST(test_answer);
+  RUN_TEST(test_filter);
+  RUN_TEST(test_inputs);
+  RUN_TEST(test_errors);
+  RUN_TEST(test_large_input);
+  return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#define ARDUINOJSON_COMPACT_SLOTS 1
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+using ARDUINOJSON_NAMESPACE::MemoryPool;
+using ARDUINOJSON_NAMESPACE::VariantSlot;
+
+/**
+ * ARDUINOJSON_COMPACT_SLOTS: the variants hold offsets instead of pointers, so every string is copied in the pool, and
+ * every operation that moves the pool, or the slots in it, must keep the offsets right.
+ * */
+
+const char* answer = "{\"coord\":{\"lon\":8.68,\"lat\":50.11},\"weather\":[{\"id\":800,\"main\":\"Clear\",\"icon\":\"01d\"}],"
+                     "\"main\":{\"temp\":291.5,\"pressure\":1021,\"humidity\":52},\"wind\":{\"speed\":1.5,\"deg\":250},"
+                     "\"dt\":1600000000,\"name\":\"Frankfurt\",\"cod\":200}";
+
+void checkAnswer(const JsonDocument& doc) {
+  TEST_ASSERT_EQUAL_INT(800, doc["weather"][0]["id"].as<int>());
+  TEST_ASSERT_EQUAL_STRING("Clear", doc["weather"][0]["main"].as<const char*>());
+  TEST_ASSERT_EQUAL_UINT32(1600000000UL, doc["dt"].as<unsigned long>());
+  TEST_ASSERT_EQUAL_STRING("Frankfurt", doc["name"].as<const char*>());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING(answer, output.c_str());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_slot_size() {
+  // INFO: 16-bit offsets on MCUs, 32-bit ones on computers
+  TEST_ASSERT_EQUAL_size_t(sizeof(void*) == 8 ? 16 : 12, sizeof(VariantSlot));
+  TEST_ASSERT_EQUAL_size_t(sizeof(VariantSlot), MemoryPool::overhead);
+  TEST_ASSERT_EQUAL_size_t(3 * sizeof(VariantSlot), JSON_ARRAY_SIZE(3));
+}
+
+void test_answer() {
+  StaticJsonDocument<1024> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, answer).c_str());
+  checkAnswer(doc);
+  TEST_ASSERT_EQUAL_size_t(1024, doc.capacity()); // INFO: the root isn't counted
+}
+
+void test_exact_capacity() {
+  StaticJsonDocument<512> measured;
+  deserializeJson(measured, answer);
+  DynamicJsonDocument doc(measured.memoryUsage());
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, answer).c_str());
+  checkAnswer(doc);
+  DynamicJsonDocument smaller(measured.memoryUsage() - 8);
+  TEST_ASSERT_EQUAL_STRING("NoMemory", deserializeJson(smaller, answer).c_str());
+}
+
+void test_mutable_input_is_copied() {
+  char input[] = "{\"name\":\"Frankfurt\"}";
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, input).c_str());
+  memset(input, 'x', strlen(input));
+  TEST_ASSERT_EQUAL_STRING("Frankfurt", doc["name"].as<const char*>());
+}
+
+void test_literals_are_copied() {
+  StaticJsonDocument<256> doc;
+  doc["key"] = "value";
+  doc["raw"] = serialized("[1,2]");
+  TEST_ASSERT_EQUAL_size_t(JSON_OBJECT_SIZE(2) + 4 + 6 + 4 + 5, doc.memoryUsage());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("{\"key\":\"value\",\"raw\":[1,2]}", output.c_str());
+}
+
+void test_copy_and_move() {
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, answer);
+
+  DynamicJsonDocument copy(doc);
+  checkAnswer(copy);
+  StaticJsonDocument<1024> staticCopy = doc;
+  checkAnswer(staticCopy);
+  StaticJsonDocument<1024> staticCopy2 = staticCopy;
+  checkAnswer(staticCopy2);
+
+  DynamicJsonDocument moved(std::move(copy));
+  checkAnswer(moved);
+  TEST_ASSERT_TRUE(copy.isNull()); // INFO: without a pool, the root is the member variant again
+  TEST_ASSERT_EQUAL_size_t(0, copy.capacity());
+
+  DynamicJsonDocument assigned(16);
+  assigned = std::move(moved);
+  checkAnswer(assigned);
+  assigned = doc;
+  checkAnswer(assigned);
+}
+
+void test_shrink_and_collect() {
+  DynamicJsonDocument doc(2048);
+  deserializeJson(doc, answer);
+  doc.shrinkToFit(); // INFO: moves the slots and the root down to the strings
+  TEST_ASSERT_TRUE(doc.capacity() - doc.memoryUsage() < sizeof(void*)); // INFO: only the padding of the strings
+  checkAnswer(doc);
+
+  DynamicJsonDocument collected(2048);
+  deserializeJson(collected, answer);
+  collected["name"] = std::string("Offenbach"); // INFO: leaves the old string behind
+  collected["name"] = std::string("Frankfurt");
+  size_t before = collected.memoryUsage();
+  TEST_ASSERT_TRUE(collected.garbageCollect());
+  TEST_ASSERT_TRUE(collected.memoryUsage() < before);
+  checkAnswer(collected);
+}
+
+void test_packed_array_of_objects() {
+  StaticJsonDocument<2048> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "[{\"a\":[1,\"x\"]},{\"a\":[2,\"y\"]},{\"a\":[3,\"z\"]}]").c_str());
+  TEST_ASSERT_TRUE(doc.data().asArray()->isPacked() || !ARDUINOJSON_PACK_COLLECTIONS);
+  TEST_ASSERT_EQUAL_STRING("z", doc[2]["a"][1].as<const char*>()); // INFO: pack() moved the slots, not the strings
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("[{\"a\":[1,\"x\"]},{\"a\":[2,\"y\"]},{\"a\":[3,\"z\"]}]", output.c_str());
+}
+
+void test_msgpack_round_trip() {
+  StaticJsonDocument<1024> doc;
+  deserializeJson(doc, answer);
+  std::string msgPack;
+  serializeMsgPack(doc, msgPack);
+  StaticJsonDocument<1024> copy;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(copy, msgPack).c_str());
+  checkAnswer(copy);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_slot_size);
+  RUN_TEST(test_answer);
+  RUN_TEST(test_exact_capacity);
+  RUN_TEST(test_mutable_input_is_copied);
+  RUN_TEST(test_literals_are_copied);
+  RUN_TEST(test_copy_and_move);
+  RUN_TEST(test_shrink_and_collect);
+  RUN_TEST(test_packed_array_of_objects);
+  RUN_TEST(test_msgpack_round_trip);
+  return UNITY_END();
+}
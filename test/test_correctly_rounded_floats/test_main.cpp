@@ -0,0 +1,168 @@
+#include <ArduinoJson.h>
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS: the parser must give the nearest float, like strtod() and strtof(), for every
+ * number of up to 19 significant digits, and for the longer ones that aren't within their dropped digits of a midpoint.
+ * */
+
+using ARDUINOJSON_NAMESPACE::ParsedNumber;
+using ARDUINOJSON_NAMESPACE::parseNumber;
+
+const char* hardDoubles[] = {
+  "293.15", "0.000001", "0.1", "3.6", "1e23", "8.41e21", "9007199254740993", "9007199254740992.5",
+  "2.2250738585072011e-308",   // between the largest denormal and the smallest normal
+  "2.2250738585072012e-308",
+  "4.9e-324", "2.4703282292062328e-324", "2.4703282292062327e-324", // the smallest denormal, and half of it
+  "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", // the largest, and past it
+  "1e-400", "1e400", "0.0000000000000000000000000000000000001",
+  "123456789012345678", "1234567890123456789", "12345678901234567890", "18446744073709551615", "18446744073709551616",
+  "3.14159265358979323846264338327950288", // INFO: more than 19 digits, far from a midpoint
+  "7.2057594037927933e16", "5e-324", "1.00000000000000011102230246251565404", "0.0", "-0.0", "-293.15"
+};
+
+const char* hardFloats[] = {
+  "293.15", "3.6", "0.1", "16777217", "16777216.5", "3.4028235e38", "3.4028236e38", "3.40282357e38",
+  "1.17549435e-38", "1.4e-45", "7e-46", "7.1e-46", "1e-50", "1e39", "8.589973e9", "1.00000006", "-0.0"
+};
+
+uint32_t seed = 1;
+
+uint32_t nextRandom() {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+uint64_t randomBits() {
+  return uint64_t(nextRandom()) << 40 ^ uint64_t(nextRandom()) << 20 ^ nextRandom();
+}
+
+void checkDouble(const char* s) {
+  ParsedNumber<double, uint64_t> parsed = parseNumber<double, uint64_t>(s);
+  double expected = strtod(s, NULL);
+  double actual = parsed.as<double>();
+  TEST_ASSERT_TRUE_MESSAGE(memcmp(&expected, &actual, sizeof(double)) == 0, s);
+}
+
+void checkFloat(const char* s) {
+  ParsedNumber<float, uint32_t> parsed = parseNumber<float, uint32_t>(s);
+  float expected = strtof(s, NULL);
+  float actual = parsed.as<float>();
+  TEST_ASSERT_TRUE_MESSAGE(memcmp(&expected, &actual, sizeof(float)) == 0, s);
+}
+
+void setUp() {
+  seed = 1;
+}
+
+void tearDown() {}
+
+void test_hard_doubles() {
+  for (size_t i = 0; i < sizeof(hardDoubles) / sizeof(hardDoubles[0]); i++) {
+    checkDouble(hardDoubles[i]);
+  }
+}
+
+void test_hard_floats() {
+  for (size_t i = 0; i < sizeof(hardFloats) / sizeof(hardFloats[0]); i++) {
+    checkFloat(hardFloats[i]);
+  }
+}
+
+void test_random_doubles() {
+  char buffer[64];
+  for (int i = 0; i < 100000; i++) {
+    uint64_t bits = randomBits() & ~(uint64_t(1) << 63);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (isnan(value) || isinf(value)) {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%.17g", value); // INFO: reads back as value
+    checkDouble(buffer);
+    snprintf(buffer, sizeof(buffer), "%.*g", int(1 + nextRandom() % 16), value); // INFO: any nearby decimal
+    checkDouble(buffer);
+  }
+}
+
+void test_doubles_near_midpoints() {
+  char buffer[64];
+  for (int i = 0; i < 20000; i++) {
+    uint64_t bits = randomBits() & ~(uint64_t(1) << 63);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    double next = nextafter(value, INFINITY);
+    if (isnan(value) || isinf(next)) {
+      continue;
+    }
+    long double midpoint = ((long double)value + next) / 2; // INFO: exact, long double has 64 bits of precision
+    snprintf(buffer, sizeof(buffer), "%.18Le", midpoint); // INFO: 19 digits, on either side of the midpoint
+    checkDouble(buffer);
+  }
+}
+
+void test_floats() {
+  char buffer[64];
+  for (int i = 0; i < 100000; i++) {
+    uint32_t bits = nextRandom() & 0x7FFFFFFF;
+    bits |= (nextRandom() & 1) << 23;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (isnan(value) || isinf(value)) {
+      continue;
+    }
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+    checkFloat(buffer);
+    double midpoint = ((double)value + nextafterf(value, INFINITY)) / 2; // INFO: exact
+    snprintf(buffer, sizeof(buffer), "%.*e", int(7 + nextRandom() % 12), midpoint);
+    checkFloat(buffer);
+  }
+}
+
+void test_integers_stay_integers() {
+  ParsedNumber<double, uint64_t> parsed = parseNumber<double, uint64_t>("18446744073709551615");
+  TEST_ASSERT_EQUAL_INT(ARDUINOJSON_NAMESPACE::VALUE_IS_POSITIVE_INTEGER, parsed.type());
+  TEST_ASSERT_TRUE(parsed.uintValue == 18446744073709551615ULL);
+  parsed = parseNumber<double, uint64_t>("18446744073709551616");
+  TEST_ASSERT_EQUAL_INT(ARDUINOJSON_NAMESPACE::VALUE_IS_FLOAT, parsed.type());
+  parsed = parseNumber<double, uint64_t>("-42");
+  TEST_ASSERT_EQUAL_INT(ARDUINOJSON_NAMESPACE::VALUE_IS_NEGATIVE_INTEGER, parsed.type());
+  TEST_ASSERT_EQUAL_INT(-42, parsed.as<int>());
+  parsed = parseNumber<double, uint64_t>("42.0");
+  TEST_ASSERT_EQUAL_INT(ARDUINOJSON_NAMESPACE::VALUE_IS_FLOAT, parsed.type());
+}
+
+void test_documents() {
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "{\"temp\":293.15,\"speed\":3.6,\"tiny\":0.000001}").c_str());
+  JsonFloat expected = JsonFloat(sizeof(JsonFloat) == 8 ? strtod("293.15", NULL) : strtof("293.15", NULL));
+  TEST_ASSERT_TRUE(doc["temp"].as<JsonFloat>() == expected);
+  expected = JsonFloat(sizeof(JsonFloat) == 8 ? strtod("0.000001", NULL) : strtof("0.000001", NULL));
+  TEST_ASSERT_TRUE(doc["tiny"].as<JsonFloat>() == expected);
+  TEST_ASSERT_TRUE(doc["speed"].as<float>() == 3.6f);
+
+  std::string msgPack;
+  serializeMsgPack(doc, msgPack);
+  StaticJsonDocument<256> copy;
+  deserializeMsgPack(copy, msgPack);
+  TEST_ASSERT_TRUE(copy["temp"].as<JsonFloat>() == doc["temp"].as<JsonFloat>());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_hard_doubles);
+  RUN_TEST(test_hard_floats);
+  RUN_TEST(test_random_doubles);
+  RUN_TEST(test_doubles_near_midpoints);
+  RUN_TEST(test_floats);
+  RUN_TEST(test_integers_stay_integers);
+  RUN_TEST(test_documents);
+  return UNITY_END();
+}
@@ -0,0 +1,132 @@
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * ARDUINOJSON_ESCAPE_TABLES: the lookup tables must escape and unescape exactly the characters of the old list, and
+ * writeString() must write the same output with one write() per run of characters that don't need escaping.
+ * */
+
+using ARDUINOJSON_NAMESPACE::EscapeSequence;
+
+const char* escapes = "\"\"\\\\b\bf\fn\nr\rt\t"; // INFO: the escape, then the character, like the old list
+
+/**
+ * Counts the calls, to tell the runs from the single bytes
+ * */
+struct CountingWriter {
+  std::string output;
+  size_t calls = 0;
+
+  size_t write(uint8_t c) {
+    calls++;
+    output += char(c);
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    calls++;
+    output.append(reinterpret_cast<const char*>(s), n);
+    return n;
+  }
+};
+
+std::string serialized(const char* value) {
+  StaticJsonDocument<16> doc;
+  doc.set(value);
+  std::string output;
+  serializeJson(doc, output);
+  return output;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_escape_every_byte() {
+  for (int i = 0; i < 256; i++) {
+    char c = char(i);
+    char expected = 0;
+    for (const char* p = escapes; *p; p += 2) {
+      if (p[1] == c && c) {
+        expected = p[0];
+      }
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected, EscapeSequence::escapeChar(c), "escapeChar");
+  }
+}
+
+void test_unescape_every_byte() {
+  for (int i = 0; i < 256; i++) {
+    char c = char(i);
+    char expected = c == '/' ? '/' : 0; // INFO: "\/" is read, but never written
+    for (const char* p = escapes; *p; p += 2) {
+      if (p[0] == c && c) {
+        expected = p[1];
+      }
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(expected, EscapeSequence::unescapeChar(c), "unescapeChar");
+  }
+}
+
+void test_serialize() {
+  TEST_ASSERT_EQUAL_STRING("\"light rain\"", serialized("light rain").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"\"", serialized("").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"a\\\"b\\\\c\\nd/e\"", serialized("a\"b\\c\nd/e").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"\\b\\f\\n\\r\\t\"", serialized("\b\f\n\r\t").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"\\\"\\\"\"", serialized("\"\"").c_str()); // INFO: no run between them
+  TEST_ASSERT_EQUAL_STRING("\"\x01\x1f\x7f`~\"", serialized("\x01\x1f\x7f`~").c_str()); // INFO: written as they are, like upstream
+  TEST_ASSERT_EQUAL_STRING("\"Gr\xc3\xbc\xc3\x9f""e \xe2\x82\xac\"", serialized("Gr\xc3\xbc\xc3\x9f""e \xe2\x82\xac").c_str());
+}
+
+void test_round_trip() {
+  // INFO: every ASCII character, then multibyte ones, so that ARDUINOJSON_VALIDATE_UTF8 accepts them
+  std::string value;
+  for (int i = 1; i < 0x80; i++) {
+    value += char(i);
+  }
+  value += "\xc3\xa9\xe2\x82\xac\xf0\x9d\x84\x9e";
+  StaticJsonDocument<512> doc;
+  doc.set(value.c_str());
+  std::string json;
+  serializeJson(doc, json);
+  StaticJsonDocument<512> parsed;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(parsed, json).c_str());
+  TEST_ASSERT_EQUAL_STRING(value.c_str(), parsed.as<const char*>());
+}
+
+void test_deserialize() {
+  StaticJsonDocument<128> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"").c_str());
+  TEST_ASSERT_EQUAL_STRING("\"\\/\b\f\n\r\t", doc.as<const char*>());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, "'it\\'s'").c_str()); // INFO: not even in single quotes, like upstream
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, "\"\\x\"").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, "\"\\a\"").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, "\"\\`\"").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, "\"\\\xe9\"").c_str());
+}
+
+void test_runs() {
+  StaticJsonDocument<64> doc;
+  doc["description"] = "light \"rain\"\n";
+  CountingWriter writer;
+  size_t n = serializeJson(doc, writer);
+  TEST_ASSERT_EQUAL_STRING("{\"description\":\"light \\\"rain\\\"\\n\"}", writer.output.c_str());
+  TEST_ASSERT_EQUAL_size_t(writer.output.size(), n);
+#if ARDUINOJSON_ESCAPE_TABLES
+  // INFO: { " description " : " light \ " rain \ " \ n " }
+  TEST_ASSERT_EQUAL_size_t(16, writer.calls);
+#endif
+  TEST_ASSERT_TRUE(writer.calls <= n);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_escape_every_byte);
+  RUN_TEST(test_unescape_every_byte);
+  RUN_TEST(test_serialize);
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_deserialize);
+  RUN_TEST(test_runs);
+  return UNITY_END();
+}
@@ -0,0 +1,290 @@
+// INFO: PROGMEM on the computer; the bytes of the "flash" are scrambled, so a read that doesn't go through
+// pgm_read_byte() gets garbage
+#include <stdint.h>
+#include <vector>
+#define PROGMEM
+
+std::vector<uint8_t> flash;
+
+const uint8_t scramble = 0x5a;
+
+inline uint8_t readFlash(const void* p) {
+  const uint8_t* byte = static_cast<const uint8_t*>(p);
+  bool inFlash = !flash.empty() && byte >= &flash[0] && byte < &flash[0] + flash.size();
+  return inFlash ? *byte ^ scramble : *byte;
+}
+
+#define pgm_read_byte(p) readFlash(p)
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t*>(p))
+class __FlashStringHelper;
+
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * FlashDocument: the nodes in RAM, the bytes in flash. Every value must read like the same document parsed by
+ * deserializeJson(), the errors must be those of deserializeJson(), and nothing may read the flash directly.
+ * */
+
+using ARDUINOJSON_NAMESPACE::FlashDocument;
+using ARDUINOJSON_NAMESPACE::FlashNode;
+using ARDUINOJSON_NAMESPACE::FlashVariant;
+using ARDUINOJSON_NAMESPACE::StaticFlashDocument;
+
+/**
+ * Copies the JSON in the "flash", scrambled, with its terminator
+ * */
+const __FlashStringHelper* toFlash(const std::string& json) {
+  flash.clear();
+  for (size_t i = 0; i <= json.size(); i++) {
+    flash.push_back(uint8_t(json.c_str()[i]) ^ scramble);
+  }
+  return reinterpret_cast<const __FlashStringHelper*>(&flash[0]);
+}
+
+const char* documents[] = {
+  "{\"shutdownHours\": [0, 0, 0, 0, 20, 20, 21, 21, 21, 20, 20, 0, 0], \"startHour\": 8, \"maxWind\": 2}",
+  "{\"coord\":{\"lon\":8.68,\"lat\":50.11},\"weather\":[{\"id\":500,\"main\":\"Rain\"},{\"id\":701}],\"wind\":{\"speed\":3.6,"
+  "\"deg\":240},\"dt\":1600000000,\"name\":\"Frankfurt am Main\"}",
+  "[true, false, null, -0, 1e3, -1.5E-3, 4294967295, -2147483648, 0.1, 12345678901234567890, \"\", '']",
+  "{'single': 'quotes', \"mixed\": \"it's\", \"escaped\": \"a \\\"b\\\" \\\\ \\/ \\b\\f\\n\\r\\t end\"}",
+  " \t\r\n{ \"a\" : [ [ ] , { } , [ [ 1 ] ] ] , \"\" : \"empty key\" , \"b\" : { \"c\" : { \"d\" : null } } } ",
+  "{unquoted:1,\"\xc3\xa9t\xc3\xa9\":\"\xe2\x82\xac\",_under_score:-3}",
+  "\"a string\"",
+  "42",
+};
+
+/**
+ * Empty when the value in flash reads like the value of the JsonDocument, else where they differ
+ * */
+std::string compare(FlashVariant flashValue, JsonVariantConst value, const std::string& path) {
+  bool isArray = !value.as<JsonArrayConst>().isNull();
+  bool isObject = !value.as<JsonObjectConst>().isNull();
+  if (flashValue.isNull() != value.isNull() || flashValue.isBoolean() != value.is<bool>() ||
+      flashValue.isString() != value.is<const char*>() || flashValue.isArray() != isArray ||
+      flashValue.isObject() != isObject) {
+    return path + ": not the same type";
+  }
+  if (flashValue.isNumber() != (value.is<double>() || value.is<long>())) {
+    return path + ": not the same type";
+  }
+  if (flashValue.as<double>() != value.as<double>() || flashValue.as<long>() != value.as<long>() ||
+      flashValue.as<int>() != value.as<int>() || flashValue.as<unsigned>() != value.as<unsigned>() ||
+      flashValue.as<float>() != value.as<float>() || flashValue.as<bool>() != value.as<bool>()) {
+    return path + ": not the same number";
+  }
+  if (value.is<const char*>()) {
+    char buffer[64];
+    size_t length = flashValue.copyString(buffer, sizeof(buffer));
+    if (length != strlen(value.as<const char*>()) || strcmp(buffer, value.as<const char*>()) != 0 ||
+        !flashValue.equals(value.as<const char*>())) {
+      return path + ": not the same string";
+    }
+  }
+  if (flashValue.size() != value.size()) {
+    return path + ": not the same size";
+  }
+  if (isArray) {
+    for (size_t i = 0; i < value.size(); i++) {
+      std::string error = compare(flashValue[i], value[i], path + "[" + std::to_string(i) + "]");
+      if (!error.empty()) {
+        return error;
+      }
+    }
+    if (!flashValue[value.size()].isNull()) {
+      return path + ": an element after the end";
+    }
+  }
+  if (isObject) {
+    JsonObjectConst object = value.as<JsonObjectConst>();
+    for (JsonObjectConst::iterator it = object.begin(); it != object.end(); ++it) {
+      const char* key = it->key().c_str();
+      std::string error = compare(flashValue[key], object[key], path + "." + key);
+      if (!error.empty()) {
+        return error;
+      }
+    }
+    if (!flashValue["missing"].isNull() || !flashValue[(const char*)0].isNull()) {
+      return path + ": a missing member";
+    }
+  }
+  return std::string();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_like_json_document() {
+  for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+    DynamicJsonDocument expected(4096);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("Ok", deserializeJson(expected, documents[i]).c_str(), documents[i]);
+    StaticFlashDocument<1024> doc;
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("Ok", deserializeJson(doc, toFlash(documents[i])).c_str(), documents[i]);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("", compare(doc.root(), expected.as<JsonVariantConst>(), "root").c_str(),
+                                     documents[i]);
+    TEST_ASSERT_EQUAL_size_t_MESSAGE(expected.size(), doc.size(), documents[i]);
+  }
+}
+
+void test_config() {
+  StaticFlashDocument<128> config;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(config, toFlash(documents[0])).c_str());
+  TEST_ASSERT_EQUAL_size_t(120, config.memoryUsage()); // INFO: 20 nodes of 6 bytes
+  TEST_ASSERT_EQUAL_size_t(6, sizeof(FlashNode));
+  TEST_ASSERT_EQUAL_size_t(13, config["shutdownHours"].size());
+  TEST_ASSERT_EQUAL_INT(21, config["shutdownHours"][size_t(7)].as<int>());
+  TEST_ASSERT_EQUAL_INT(8, config[JsonKey("startHour")].as<int>());
+  TEST_ASSERT_EQUAL_FLOAT(2.0f, config["maxWind"].as<float>());
+  TEST_ASSERT_TRUE(config["shutdownHours"][size_t(13)].isNull());
+  TEST_ASSERT_TRUE(config["startHour"]["x"].isNull()); // INFO: a member of a number
+  TEST_ASSERT_TRUE(config["startHour"][size_t(0)].isNull());
+  TEST_ASSERT_EQUAL_size_t(0, config["startHour"].size());
+  TEST_ASSERT_TRUE(config["starthour"].isNull());
+  TEST_ASSERT_TRUE(config[JsonKey("startHou")].isNull());
+}
+
+void test_errors() {
+  // INFO: every prefix of every document, and broken ones; deserializeJson() is the reference
+  std::vector<std::string> inputs;
+  for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+    std::string document = documents[i];
+    for (size_t n = 0; n < document.size(); n++) {
+      inputs.push_back(document.substr(0, n));
+    }
+  }
+  const char* broken[] = {"[1,]", "[1 2]", "{\"a\" 1}", "{\"a\":1,}", "{a:1}", "[tru]", "[nul]", "[falsey]", "[1x]",
+                          "[-]", "[.5]", "\"\\x\"", "[\"a\"\"b\"]", "}", "]", "{\"a\":1]", "[1}", "[+1]", "[0x10]"};
+  inputs.insert(inputs.end(), broken, broken + sizeof(broken) / sizeof(broken[0]));
+  for (size_t i = 0; i < inputs.size(); i++) {
+    DynamicJsonDocument expected(4096);
+    DeserializationError error = deserializeJson(expected, inputs[i]);
+    StaticFlashDocument<1024> doc;
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(error.c_str(), deserializeJson(doc, toFlash(inputs[i])).c_str(), inputs[i].c_str());
+    TEST_ASSERT_TRUE(!error || doc.isNull()); // INFO: the document is emptied on error
+  }
+}
+
+void test_not_supported() {
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("NotSupported", deserializeJson(doc, toFlash("[\"\\u00e9\"]")).c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, toFlash("[1 /* comment */]")).c_str());
+  std::string big = "[\"" + std::string(70000, 'x') + "\"]"; // INFO: the offsets are 16 bits
+  TEST_ASSERT_EQUAL_STRING("NotSupported", deserializeJson(doc, toFlash(big)).c_str());
+  TEST_ASSERT_TRUE(doc.isNull());
+}
+
+void test_nesting_limit() {
+  for (uint8_t limit = 0; limit < 5; limit++) {
+    const char* inputs[] = {"[[[1]]]", "{\"a\":{\"b\":[]}}", "[{}]", "1"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      DynamicJsonDocument expected(1024);
+      DeserializationError error = deserializeJson(expected, inputs[i], DeserializationOption::NestingLimit(limit));
+      StaticFlashDocument<256> doc;
+      TEST_ASSERT_EQUAL_STRING_MESSAGE(error.c_str(),
+                                       deserializeJson(doc, toFlash(inputs[i]), DeserializationOption::NestingLimit(limit)).c_str(),
+                                       inputs[i]);
+    }
+  }
+}
+
+void test_no_memory() {
+  // INFO: one node per key and per value; 17 nodes here
+  std::string json = "{\"a\":[1,2,{\"b\":\"c\"}],\"d\":{\"e\":[[]],\"f\":null},\"g\":true}";
+  StaticFlashDocument<17 * sizeof(FlashNode)> exact;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(exact, toFlash(json)).c_str());
+  TEST_ASSERT_EQUAL_size_t(17 * sizeof(FlashNode), exact.memoryUsage());
+  TEST_ASSERT_EQUAL_size_t(exact.capacity(), exact.memoryUsage());
+  StaticFlashDocument<16 * sizeof(FlashNode)> tooSmall;
+  TEST_ASSERT_EQUAL_STRING("NoMemory", deserializeJson(tooSmall, toFlash(json)).c_str());
+  TEST_ASSERT_TRUE(tooSmall.isNull());
+  TEST_ASSERT_EQUAL_size_t(0, tooSmall.memoryUsage());
+  StaticFlashDocument<1> one; // INFO: rounded up to a node
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(one, toFlash("null")).c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(one, toFlash("[]")).c_str());
+  TEST_ASSERT_EQUAL_STRING("NoMemory", deserializeJson(one, toFlash("[1]")).c_str());
+}
+
+void test_copy_string() {
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("[\"a\\\"b\\\\c\", \"plain\", 1]")).c_str());
+  char buffer[16];
+  TEST_ASSERT_EQUAL_size_t(5, doc[size_t(0)].copyString(buffer, sizeof(buffer)));
+  TEST_ASSERT_EQUAL_STRING("a\"b\\c", buffer);
+  // INFO: like strlcpy(), the length of the whole string, and size - 1 characters
+  memset(buffer, '*', sizeof(buffer));
+  TEST_ASSERT_EQUAL_size_t(5, doc[size_t(1)].copyString(buffer, 3));
+  TEST_ASSERT_EQUAL_STRING("pl", buffer);
+  TEST_ASSERT_EQUAL_INT('*', buffer[3]);
+  buffer[0] = '*';
+  TEST_ASSERT_EQUAL_size_t(5, doc[size_t(1)].copyString(buffer, 0));
+  TEST_ASSERT_EQUAL_INT('*', buffer[0]);
+  TEST_ASSERT_EQUAL_size_t(0, doc[size_t(2)].copyString(buffer, sizeof(buffer)));
+  TEST_ASSERT_TRUE(doc[size_t(0)].equals("a\"b\\c"));
+  TEST_ASSERT_FALSE(doc[size_t(0)].equals("a\"b\\"));
+  TEST_ASSERT_FALSE(doc[size_t(0)].equals("a\\\"b\\\\c")); // INFO: not the escaped form
+  TEST_ASSERT_FALSE(doc[size_t(1)].equals("plains"));
+  TEST_ASSERT_FALSE(doc[size_t(1)].equals(0));
+  TEST_ASSERT_FALSE(doc[size_t(2)].equals("1"));
+}
+
+void test_duplicate_keys() {
+  // INFO: unlike deserializeJson(), which replaces the value
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("{\"dup\":1,\"dup\":2}")).c_str());
+  TEST_ASSERT_EQUAL_size_t(2, doc.size());
+  TEST_ASSERT_EQUAL_INT(1, doc["dup"].as<int>());
+}
+
+void test_negative_numbers() {
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("[-5, -2147483648, -1.5]")).c_str());
+  TEST_ASSERT_EQUAL_FLOAT(-5.0, doc[size_t(0)].as<double>());
+  TEST_ASSERT_EQUAL_FLOAT(-2147483648.0, doc[size_t(1)].as<float>());
+  TEST_ASSERT_EQUAL_INT(-1, doc[size_t(2)].as<int>());
+  TEST_ASSERT_EQUAL_INT(0, doc[size_t(0)].as<unsigned>());
+  // INFO: the same conversion reads the numbers in strings
+  StaticJsonDocument<64> json;
+  json.set("-5");
+  TEST_ASSERT_EQUAL_FLOAT(-5.0, json.as<double>());
+}
+
+void test_escaped_keys() {
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("{\"a\\\"b\":1,\"a\\\\\":2,\"tab\\t\":3}")).c_str());
+  TEST_ASSERT_EQUAL_INT(1, doc["a\"b"].as<int>());
+  TEST_ASSERT_EQUAL_INT(2, doc["a\\"].as<int>());
+  TEST_ASSERT_EQUAL_INT(3, doc[JsonKey("tab\t")].as<int>());
+  TEST_ASSERT_TRUE(doc["a\\\"b"].isNull());
+  TEST_ASSERT_TRUE(doc["a"].isNull());
+}
+
+void test_clear_and_reuse() {
+  StaticFlashDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("{\"a\":1}")).c_str());
+  TEST_ASSERT_EQUAL_INT(1, doc["a"].as<int>());
+  doc.clear();
+  TEST_ASSERT_TRUE(doc.isNull());
+  TEST_ASSERT_EQUAL_size_t(0, doc.memoryUsage());
+  TEST_ASSERT_TRUE(doc["a"].isNull());
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, toFlash("[7]")).c_str());
+  TEST_ASSERT_EQUAL_INT(7, doc[size_t(0)].as<int>());
+  TEST_ASSERT_EQUAL_size_t(2 * sizeof(FlashNode), doc.memoryUsage());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_like_json_document);
+  RUN_TEST(test_config);
+  RUN_TEST(test_errors);
+  RUN_TEST(test_not_supported);
+  RUN_TEST(test_nesting_limit);
+  RUN_TEST(test_no_memory);
+  RUN_TEST(test_copy_string);
+  RUN_TEST(test_duplicate_keys);
+  RUN_TEST(test_negative_numbers);
+  RUN_TEST(test_escaped_keys);
+  RUN_TEST(test_clear_and_reuse);
+  return UNITY_END();
+}
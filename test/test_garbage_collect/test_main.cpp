@@ -0,0 +1,153 @@
+#include <ArduinoJson.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * garbageCollect() compacts the pool in place: it must keep what the root
+ * can reach and never allocate a second pool.
+ * */
+
+static size_t heapUsed = 0;
+static size_t heapPeak = 0;
+
+/**
+ * Records the bytes allocated by the documents, in a header before each block
+ * */
+struct CountingAllocator {
+  void* allocate(size_t size) {
+    size_t* block = static_cast<size_t*>(malloc(sizeof(size_t) + size));
+    if (!block) return 0;
+    *block = size;
+    heapUsed += size;
+    if (heapUsed > heapPeak) heapPeak = heapUsed;
+    return block + 1;
+  }
+
+  void deallocate(void* ptr) {
+    if (!ptr) return;
+    size_t* block = static_cast<size_t*>(ptr) - 1;
+    heapUsed -= *block;
+    free(block);
+  }
+
+  void* reallocate(void* ptr, size_t size) {
+    size_t* block = static_cast<size_t*>(ptr) - 1;
+    heapUsed -= *block;
+    block = static_cast<size_t*>(realloc(block, sizeof(size_t) + size));
+    *block = size;
+    heapUsed += size;
+    if (heapUsed > heapPeak) heapPeak = heapUsed;
+    return block + 1;
+  }
+};
+
+typedef BasicJsonDocument<CountingAllocator> CountedJsonDocument;
+
+void setUp() {
+  heapUsed = 0;
+  heapPeak = 0;
+}
+
+void tearDown() {}
+
+void test_root_string() {
+  StaticJsonDocument<256> doc;
+  doc.set(std::string("hello world"));
+  TEST_ASSERT_EQUAL_size_t(0, doc.compactPool());
+  TEST_ASSERT_EQUAL_size_t(12, doc.memoryUsage());
+  TEST_ASSERT_EQUAL_STRING("hello world", doc.as<const char*>());
+}
+
+void test_root_string_after_garbage() {
+  StaticJsonDocument<256> doc;
+  // as<JsonVariant>() doesn't clear the pool, unlike set()
+  doc.as<JsonVariant>().set(std::string("garbage"));
+  doc.as<JsonVariant>().set(std::string("hello world"));
+  TEST_ASSERT_EQUAL_size_t(8, doc.compactPool());
+  TEST_ASSERT_EQUAL_size_t(12, doc.memoryUsage());
+  TEST_ASSERT_EQUAL_STRING("hello world", doc.as<const char*>());
+}
+
+void test_root_raw_value() {
+  StaticJsonDocument<256> doc;
+  doc.set(serialized(std::string("[1,2]")));
+  doc.garbageCollect();
+  TEST_ASSERT_EQUAL_size_t(5, doc.memoryUsage());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("[1,2]", output.c_str());
+}
+
+void test_removed_members() {
+  StaticJsonDocument<512> doc;
+  const char* json = "{\"a\":\"one\",\"b\":[1,2,3],\"c\":{\"d\":\"two\"}}";
+  deserializeJson(doc, json);
+  size_t before = doc.memoryUsage();
+  doc.remove("b");
+  doc["c"]["d"] = std::string("three");
+  TEST_ASSERT_GREATER_THAN(0, doc.compactPool());
+  TEST_ASSERT_LESS_OR_EQUAL(before, doc.memoryUsage());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("{\"a\":\"one\",\"c\":{\"d\":\"three\"}}", output.c_str());
+}
+
+void test_basic_document_keeps_its_signature() {
+  CountedJsonDocument doc(256);
+  doc["name"] = std::string("Frankfurt");
+  TEST_ASSERT_TRUE(doc.garbageCollect());
+}
+
+/**
+ * 10,000 updates of a rolling 12-entry forecast cache, the way the firmware
+ * keeps one, collected whenever the pool is 75% full
+ * */
+void test_soak() {
+  const size_t capacity = 4096;
+  CountedJsonDocument doc(capacity);
+  size_t allocated = heapPeak;
+  size_t collections = 0;
+  for (int i = 0; i < 10000; i++) {
+    JsonArray forecast = doc["forecast"];
+    if (forecast.isNull()) forecast = doc.createNestedArray("forecast");
+    if (forecast.size() == 12) forecast.remove(0);
+    JsonObject entry = forecast.createNestedObject();
+    char text[16];
+    sprintf(text, "cond-%d", i % 97);
+    entry[std::string("main")] = std::string(text);
+    entry["dt"] = 1600000000 + i * 3600;
+    sprintf(text, "{\"t\":%d}", i % 41);
+    entry["raw"] = serialized(std::string(text));
+    sprintf(text, "%d", i);
+    doc["updated"] = std::string(text);
+    TEST_ASSERT_EQUAL_STRING(text, doc["updated"]);  // the pool wasn't full
+
+    if (doc.memoryUsage() > capacity * 3 / 4) {
+      std::string before, after;
+      serializeJson(doc, before);
+      TEST_ASSERT_GREATER_THAN(0, doc.compactPool());
+      serializeJson(doc, after);
+      TEST_ASSERT_EQUAL_STRING(before.c_str(), after.c_str());
+      TEST_ASSERT_LESS_OR_EQUAL(capacity / 2, doc.memoryUsage());
+      collections++;
+    }
+  }
+  TEST_ASSERT_GREATER_THAN(10, collections);
+  TEST_ASSERT_EQUAL_size_t(12, doc["forecast"].size());
+  TEST_ASSERT_EQUAL_STRING("9999", doc["updated"]);
+  // the pool is never copied
+  TEST_ASSERT_EQUAL_size_t(allocated, heapPeak);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_root_string);
+  RUN_TEST(test_root_string_after_garbage);
+  RUN_TEST(test_root_raw_value);
+  RUN_TEST(test_removed_members);
+  RUN_TEST(test_basic_document_keeps_its_signature);
+  RUN_TEST(test_soak);
+  return UNITY_END();
+}
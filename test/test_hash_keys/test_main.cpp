@@ -0,0 +1,227 @@
+// INFO: PROGMEM on the computer, to test the flash adapters; the strings are in RAM
+#include <stdint.h>
+#define PROGMEM
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t*>(p))
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t*>(p))
+class __FlashStringHelper;
+
+#define ARDUINOJSON_HASH_KEYS 1
+#include <ArduinoJson.h>
+#include <sstream>
+#include <string.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+/**
+ * ARDUINOJSON_HASH_KEYS: getSlot() skips the slots whose hash differs, so every adapter must hash a key like the slots
+ * do, and every lookup must find the member that a walk with strcmp() finds, whatever made the key.
+ * */
+
+using ARDUINOJSON_NAMESPACE::adaptString;
+using ARDUINOJSON_NAMESPACE::hashKey;
+using ARDUINOJSON_NAMESPACE::KeyHash;
+using ARDUINOJSON_NAMESPACE::VariantSlot;
+
+/**
+ * Keys whose hashes collide, keys that share a prefix, and the edge cases of the hash
+ * */
+const char* keys[] = {"", "a", "b", "ab", "ba", "aab", "abb", "temp", "temp_min", "temp_max", "feels_like", "sensor1",
+                      "sensor2", "sensor10", "sensor20", "\xc3\xa9t\xc3\xa9", "\xe2\x82\xac", "a b", "weather", "wind"};
+
+const size_t keyCount = sizeof(keys) / sizeof(keys[0]);
+
+const __FlashStringHelper* flash(const char* s) {
+  return reinterpret_cast<const __FlashStringHelper*>(s);
+}
+
+/**
+ * The member found by walking the object with strcmp(), like getSlot() without the hashes
+ * */
+JsonVariantConst walk(JsonObjectConst object, const char* key) {
+  for (JsonObjectConst::iterator it = object.begin(); it != object.end(); ++it) {
+    if (strcmp(it->key().c_str(), key) == 0) {
+      return it->value();
+    }
+  }
+  return JsonVariantConst();
+}
+
+/**
+ * Empty when every key of the object is found by every adapter, at the member of the walk, else the key that isn't
+ * */
+std::string checkLookups(JsonObjectConst object, const std::vector<std::string>& queries) {
+  for (size_t i = 0; i < queries.size(); i++) {
+    const std::string& query = queries[i];
+    const char* key = query.c_str();
+    JsonVariantConst expected = walk(object, key);
+    if (object[key] != expected || object[query] != expected || object[flash(key)] != expected ||
+        object.containsKey(key) != !expected.isNull()) {
+      return query;
+    }
+    std::vector<char> copy(query.begin(), query.end());
+    copy.push_back('\0');
+    if (object[&copy[0]] != expected) { // INFO: not a literal, so strlen() isn't folded
+      return query;
+    }
+  }
+  return std::string();
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_adapters_agree() {
+  for (size_t i = 0; i < keyCount; i++) {
+    const char* key = keys[i];
+    KeyHash expected = hashKey(key);
+    std::string message = std::string("key \"") + key + "\"";
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, adaptString(key).hash(), message.c_str());
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, adaptString(std::string(key)).hash(), message.c_str());
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, adaptString(flash(key)).hash(), message.c_str());
+    // INFO: the sized adapters compare up to the size or the terminator, whichever comes first
+    std::string padded = std::string(key) + '\0' + "tail";
+    for (size_t n = strlen(key); n <= padded.size(); n++) {
+      TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, adaptString(padded.c_str(), n).hash(), message.c_str());
+      TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected, adaptString(flash(padded.c_str()), n).hash(), message.c_str());
+    }
+  }
+  // INFO: a null key is hashed as an empty one
+  TEST_ASSERT_EQUAL_UINT8(hashKey(""), adaptString((const char*)0).hash());
+  TEST_ASSERT_EQUAL_UINT8(hashKey(""), adaptString(flash(0)).hash());
+  TEST_ASSERT_EQUAL_UINT8(hashKey(""), adaptString((const char*)0, 4).hash());
+}
+
+void test_hash_spreads() {
+  // INFO: length, first and last character; the keys of a weather answer mostly differ
+  TEST_ASSERT_NOT_EQUAL(hashKey("temp_min"), hashKey("temp_max"));
+  TEST_ASSERT_NOT_EQUAL(hashKey("sensor1"), hashKey("sensor2"));
+  TEST_ASSERT_NOT_EQUAL(hashKey("ab"), hashKey("ba"));
+  TEST_ASSERT_EQUAL_UINT8(hashKey("aab"), hashKey("abb")); // INFO: a collision, told apart by equals()
+}
+
+void test_lookups() {
+  DynamicJsonDocument doc(4096);
+  for (size_t i = 0; i < keyCount; i++) {
+    doc[keys[i]] = int(i);
+  }
+  TEST_ASSERT_EQUAL_size_t(keyCount, doc.size());
+  std::vector<std::string> queries(keys, keys + keyCount);
+  queries.push_back("abc"); // INFO: missing keys, with the hash of a key or not
+  queries.push_back("aXb");
+  queries.push_back("sensor3");
+  queries.push_back("temp_mid");
+  queries.push_back("te");
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(doc.as<JsonObject>(), queries).c_str());
+  for (size_t i = 0; i < keyCount; i++) {
+    TEST_ASSERT_EQUAL_INT(int(i), doc[keys[i]].as<int>());
+  }
+  TEST_ASSERT_TRUE(doc["aXb"].isNull());
+}
+
+void test_every_source() {
+  // INFO: owned keys from the parsers and the std::string, linked keys from the const char*, keys in the input
+  std::vector<std::string> queries(keys, keys + keyCount);
+  std::string json = "{";
+  for (size_t i = 0; i < keyCount; i++) {
+    json += std::string(i ? "," : "") + "\"" + keys[i] + "\":" + std::to_string(i);
+  }
+  json += "}";
+
+  DynamicJsonDocument parsed(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(parsed, json).c_str());
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(parsed.as<JsonObject>(), queries).c_str());
+
+  std::istringstream stream(json);
+  DynamicJsonDocument streamed(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(streamed, stream).c_str());
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(streamed.as<JsonObject>(), queries).c_str());
+
+  std::string writable = json;
+  DynamicJsonDocument inPlace(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(inPlace, &writable[0]).c_str());
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(inPlace.as<JsonObject>(), queries).c_str());
+
+  std::string msgPack;
+  serializeMsgPack(parsed, msgPack);
+  DynamicJsonDocument unpacked(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(unpacked, msgPack).c_str());
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(unpacked.as<JsonObject>(), queries).c_str());
+
+  DynamicJsonDocument owned(4096);
+  DynamicJsonDocument linked(4096);
+  for (size_t i = 0; i < keyCount; i++) {
+    owned[std::string(keys[i])] = int(i);
+    linked[keys[i]] = int(i);
+  }
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(owned.as<JsonObject>(), queries).c_str());
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(linked.as<JsonObject>(), queries).c_str());
+
+  DynamicJsonDocument copy = owned; // INFO: the copies take the keys again
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(copy.as<JsonObject>(), queries).c_str());
+  DynamicJsonDocument nested(8192);
+  nested["inner"] = linked.as<JsonObject>();
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(nested["inner"].as<JsonObject>(), queries).c_str());
+}
+
+void test_remove_and_replace() {
+  DynamicJsonDocument doc(4096);
+  for (size_t i = 0; i < keyCount; i++) {
+    doc[keys[i]] = int(i);
+  }
+  doc.remove("temp_min");
+  doc.remove("aab");
+  TEST_ASSERT_TRUE(doc["temp_min"].isNull());
+  TEST_ASSERT_TRUE(doc["aab"].isNull());
+  TEST_ASSERT_EQUAL_INT(9, doc["temp_max"].as<int>());
+  TEST_ASSERT_EQUAL_INT(6, doc["abb"].as<int>());
+
+  doc["abb"] = "replaced"; // INFO: the key stays, so does its hash
+  doc["aab"] = "again";
+  TEST_ASSERT_EQUAL_STRING("replaced", doc["abb"].as<const char*>());
+  TEST_ASSERT_EQUAL_STRING("again", doc["aab"].as<const char*>());
+  TEST_ASSERT_EQUAL_size_t(keyCount - 1, doc.size());
+
+  // INFO: a duplicate key in the input replaces the value, like without the hashes
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "{\"aab\":1,\"abb\":2,\"aab\":3}").c_str());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("{\"aab\":3,\"abb\":2}", output.c_str());
+}
+
+void test_many_keys() {
+  // INFO: 100 keys like "sensor_42", many with the same hash
+  DynamicJsonDocument doc(16384);
+  std::vector<std::string> queries;
+  for (int i = 0; i < 100; i++) {
+    queries.push_back("sensor_" + std::to_string(i));
+    doc[queries.back()] = i;
+  }
+  for (int i = 100; i < 200; i++) {
+    queries.push_back("sensor_" + std::to_string(i));
+  }
+  TEST_ASSERT_EQUAL_STRING("", checkLookups(doc.as<JsonObject>(), queries).c_str());
+  for (int i = 0; i < 100; i++) {
+    TEST_ASSERT_EQUAL_INT(i, doc[queries[i]].as<int>());
+  }
+}
+
+void test_slot_size() {
+  // INFO: the hash takes the padding after the flags; these are the sizes without the hashes, on a 64-bit computer
+  if (sizeof(void*) != 8) {
+    TEST_IGNORE_MESSAGE("not a 64-bit computer");
+  }
+  TEST_ASSERT_EQUAL_size_t(ARDUINOJSON_COMPACT_SLOTS ? 16 : 32, sizeof(VariantSlot));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_adapters_agree);
+  RUN_TEST(test_hash_spreads);
+  RUN_TEST(test_lookups);
+  RUN_TEST(test_every_source);
+  RUN_TEST(test_remove_and_replace);
+  RUN_TEST(test_many_keys);
+  RUN_TEST(test_slot_size);
+  return UNITY_END();
+}
@@ -0,0 +1,100 @@
+#define ARDUINOJSON_ITERATIVE_DESERIALIZER 1
+
+#include <ArduinoJson.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * ARDUINOJSON_ITERATIVE_DESERIALIZER: the NestingLimit is the caller's, including above the stack of
+ * ARDUINOJSON_DEFAULT_NESTING_LIMIT frames, with and without a filter.
+ * */
+
+const uint8_t stackSize = ARDUINOJSON_DEFAULT_NESTING_LIMIT;
+
+DynamicJsonDocument doc(65536);
+
+void setUp() {}
+void tearDown() {}
+
+// [[...[42]...]] for arrays, {"a":{"a":...{"a":42}...}} for objects
+std::string nest(size_t depth, bool objects) {
+  std::string json;
+  for (size_t i = 0; i < depth; i++) {
+    json += objects ? "{\"a\":" : "[";
+  }
+  json += "42";
+  for (size_t i = 0; i < depth; i++) {
+    json += objects ? "}" : "]";
+  }
+  return json;
+}
+
+std::string serialize() {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+void test_default_limit() {
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, nest(stackSize, false)).c_str());
+  TEST_ASSERT_EQUAL_STRING(nest(stackSize, false).c_str(), serialize().c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep", deserializeJson(doc, nest(stackSize + 1, false)).c_str());
+}
+
+void test_limit_above_the_stack() {
+  const size_t depths[] = {stackSize + 1, 2 * stackSize, 2 * stackSize + 1, 255};
+  for (size_t i = 0; i < sizeof(depths) / sizeof(depths[0]); i++) {
+    for (int objects = 0; objects < 2; objects++) {
+      std::string json = nest(depths[i], objects);
+      DeserializationError err = deserializeJson(doc, json, DeserializationOption::NestingLimit(uint8_t(depths[i])));
+      TEST_ASSERT_EQUAL_STRING_MESSAGE("Ok", err.c_str(), json.c_str());
+      TEST_ASSERT_EQUAL_STRING(json.c_str(), serialize().c_str());
+    }
+  }
+}
+
+void test_limit_reached_above_the_stack() {
+  std::string json = nest(2 * stackSize + 1, true);
+  DeserializationError err = deserializeJson(doc, json, DeserializationOption::NestingLimit(2 * stackSize));
+  TEST_ASSERT_EQUAL_STRING("TooDeep", err.c_str());
+}
+
+void test_siblings_after_a_nested_stack() {
+  // the collections after the one that took a second stack are back on the first one
+  std::string deep = nest(stackSize + 3, false);
+  std::string json = "{\"deep\":" + deep + ",\"next\":[1,{\"b\":[2]}],\"again\":" + deep + "}";
+  DeserializationError err = deserializeJson(doc, json, DeserializationOption::NestingLimit(stackSize + 4));
+  TEST_ASSERT_EQUAL_STRING("Ok", err.c_str());
+  TEST_ASSERT_EQUAL_STRING(json.c_str(), serialize().c_str());
+  TEST_ASSERT_EQUAL_INT(2, doc["next"][1]["b"][0].as<int>());
+}
+
+void test_filter_above_the_stack() {
+  std::string deep = nest(stackSize + 5, true);
+  std::string json = "{\"skipped\":" + deep + ",\"kept\":" + deep + "}";
+  StaticJsonDocument<64> filter;
+  filter["kept"] = true;
+  DeserializationError err = deserializeJson(doc, json, DeserializationOption::Filter(filter),
+                                             DeserializationOption::NestingLimit(stackSize + 6));
+  TEST_ASSERT_EQUAL_STRING("Ok", err.c_str());
+  TEST_ASSERT_EQUAL_STRING(("{\"kept\":" + deep + "}").c_str(), serialize().c_str());
+}
+
+void test_errors_above_the_stack() {
+  std::string json = nest(stackSize + 2, false);
+  DeserializationOption::NestingLimit limit(stackSize + 2);
+  TEST_ASSERT_EQUAL_STRING("IncompleteInput", deserializeJson(doc, json.substr(0, json.size() - 1), limit).c_str());
+  json[json.find(']')] = '}'; // INFO: the innermost array is closed by a brace
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, json, limit).c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_default_limit);
+  RUN_TEST(test_limit_above_the_stack);
+  RUN_TEST(test_limit_reached_above_the_stack);
+  RUN_TEST(test_siblings_after_a_nested_stack);
+  RUN_TEST(test_filter_above_the_stack);
+  RUN_TEST(test_errors_above_the_stack);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * JsonFeeder: each input, cut at every byte and fed in two chunks, then one byte at a time, must give the error of
+ * deserializeJson(), and the same document when there is none.
+ * */
+
+const char* inputs[] = {
+  // the weather answer, shortened
+  "{\"coord\": {\"lon\": 8.68, \"lat\": 50.11}, \"weather\": [{\"id\": 500, \"main\": \"Rain\", "
+  "\"description\": \"light rain\", \"icon\": \"10d\"}], \"main\": {\"temp\": 284.2, \"pressure\": 1012, "
+  "\"humidity\": 81}, \"wind\": {\"speed\": 3.6, \"deg\": 240}, \"dt\": 1600000000, \"name\": \"Frankfurt am Main\", "
+  "\"cod\": 200}",
+  // scalars at the root
+  "-579", "-579\t", "-579 ", "-429496,7296", "42]", "3.25e-2", "1e", "-", "+12", "0x12",
+  "true", "true ", "false,", "null\n", "\"text\"", "\"text\" tail", "'single'",
+  // keywords are checked letter by letter
+  "tru", "[tru", "[tru]", "[trux]", "[tru3]", "[truee]", "{\"a\":fals", "nul", "[nul,1]", "[nope]",
+  // collections
+  "[]", "{}", "  [ 1 , 2.5 , -3 , true , null ]  ", "[1,2] trailing", "{\"a\":{\"b\":[{}, []]}}",
+  "{a:1, b_2:\"x\"}", "{\"a\":1,\"a\":2,\"b\":3}", "[[[[[[[[1]]]]]]]]",
+  // strings
+  "[\"a\\\"b\\\\c\\/d\\n\\t\"]", "[\"caf\xC3\xA9\"]", "[\"\xC3\"]", "[\"\xED\xA0\x80\"]", "[\"a\\x\"]",
+  "[\"a\\u0041\"]", "[\"\\u00e9\\uD83D\\uDE00\"]", "[\"\\u00g0\"]", "[\"\\u00\"]", "{\"k\\\"ey\":1}",
+  // errors
+  "", "   ", "[", "[1", "[1,", "[1,]", "[1 2]", "{", "{\"a\"", "{\"a\":", "{\"a\":1", "{\"a\" 1}", "{,}",
+  "{\"a\":1]", "[1}", "]", "<!DOCTYPE html>", "[\"unterminated", "[\"a\\", "\"", "[+]",
+  // comments (InvalidInput when they are disabled)
+  "/* c */ [1, /* c */ 2] // c", "// c\n{\"a\":1}", "[1 /* c", "[1 // c", "/", "[1 /x]", "/**/-5", "-5/**/",
+  // NaN and Infinity (InvalidInput when they are disabled)
+  "[NaN, -Infinity]", "nan", "Infinity",
+};
+
+StaticJsonDocument<2048> expectedDoc;
+StaticJsonDocument<2048> doc;
+
+void setUp() {}
+void tearDown() {}
+
+std::string serialize(const JsonDocument& d) {
+  std::string json;
+  serializeJson(d, json);
+  return json;
+}
+
+// INFO: what's left in the document after an error differs, and doesn't matter
+std::string describe(DeserializationError err, const JsonDocument& d) {
+  return err ? err.c_str() : serialize(d);
+}
+
+// Feeds input in chunks of chunkSize bytes, the first one being of firstSize bytes
+std::string feed(const char* input, size_t firstSize, size_t chunkSize) {
+  StaticJsonFeeder<> feeder(doc);
+  size_t length = strlen(input);
+  size_t size = firstSize < length ? firstSize : length;
+  for (size_t offset = 0;;) {
+    feeder.feed(input + offset, size);
+    offset += size;
+    if (offset == length)
+      break;
+    size = chunkSize < length - offset ? chunkSize : length - offset;
+  }
+  feeder.finish();
+  return describe(feeder.error(), doc);
+}
+
+void test_same_as_deserializeJson() {
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+    const char* input = inputs[i];
+    DeserializationError err = deserializeJson(expectedDoc, input);
+    std::string expected = describe(err, expectedDoc);
+    size_t length = strlen(input);
+    for (size_t cut = 0; cut <= length; cut++)
+      TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), feed(input, cut, length).c_str(), input);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), feed(input, 1, 1).c_str(), input);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), feed(input, 2, 3).c_str(), input);
+  }
+}
+
+void test_number_at_the_root() {
+  StaticJsonFeeder<> feeder(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::NeedMoreData, feeder.feed("-579", 4));
+  TEST_ASSERT_EQUAL(JsonFeeder::Failed, feeder.feed("\t", 1));
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", feeder.error().c_str());
+
+  StaticJsonFeeder<> ended(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::NeedMoreData, ended.feed("-579", 4));
+  TEST_ASSERT_EQUAL(JsonFeeder::Done, ended.finish());
+  TEST_ASSERT_EQUAL(-579, doc.as<int>());
+
+  StaticJsonFeeder<> terminated(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::Done, terminated.feed("-579\0garbage", 12)); // INFO: the NUL ends the input
+  TEST_ASSERT_EQUAL(-579, doc.as<int>());
+}
+
+void test_keyword_cut_by_the_end() {
+  StaticJsonFeeder<> feeder(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::NeedMoreData, feeder.feed("[tru", 4));
+  TEST_ASSERT_EQUAL(JsonFeeder::Failed, feeder.finish());
+  TEST_ASSERT_EQUAL_STRING("IncompleteInput", feeder.error().c_str());
+}
+
+void test_keyword_across_chunks() {
+  StaticJsonFeeder<> feeder(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::NeedMoreData, feeder.feed("[tr", 3));
+  TEST_ASSERT_EQUAL(JsonFeeder::NeedMoreData, feeder.feed("ue,fal", 6));
+  TEST_ASSERT_EQUAL(JsonFeeder::Done, feeder.feed("se]", 3));
+  TEST_ASSERT_EQUAL_STRING("[true,false]", serialize(doc).c_str());
+}
+
+void test_nesting_limit() {
+  StaticJsonFeeder<2> feeder(doc);
+  TEST_ASSERT_EQUAL(JsonFeeder::Failed, feeder.feed("[[[1]]]", 7));
+  TEST_ASSERT_EQUAL_STRING("TooDeep", feeder.error().c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep",
+                           deserializeJson(expectedDoc, "[[[1]]]", DeserializationOption::NestingLimit(2)).c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_same_as_deserializeJson);
+  RUN_TEST(test_number_at_the_root);
+  RUN_TEST(test_keyword_cut_by_the_end);
+  RUN_TEST(test_keyword_across_chunks);
+  RUN_TEST(test_nesting_limit);
+  return UNITY_END();
+}
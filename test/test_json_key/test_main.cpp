@@ -0,0 +1,126 @@
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * JsonKey: a literal with its size and its hash known at compile time. Every lookup with it must find what the same
+ * literal as a const char* finds, with or without ARDUINOJSON_HASH_KEYS, and the keys it adds are linked like those.
+ * */
+
+using ARDUINOJSON_NAMESPACE::hashKey;
+using ARDUINOJSON_NAMESPACE::makeKeyHash;
+
+const char* answer = "{\"coord\":{\"lon\":8.68,\"lat\":50.11},\"weather\":[{\"id\":500,\"main\":\"Rain\"},{\"id\":701,\"main\":"
+                     "\"Mist\"}],\"main\":{\"temp\":293.15,\"feels_like\":292.1,\"temp_min\":291.48,\"temp_max\":294.82},"
+                     "\"wind\":{\"speed\":3.6,\"deg\":240},\"dt\":1600000000,\"name\":\"Frankfurt am Main\",\"\":\"empty\"}";
+
+// INFO: built at compile time, in C++11
+constexpr JsonKey windKey("wind");
+constexpr JsonKey speedKey("speed");
+static_assert(windKey.size() == 4, "the size of the literal");
+static_assert(windKey.hash() == makeKeyHash(4, 'w', 'd'), "the hash of the literal");
+static_assert(JsonKey("").size() == 0 && JsonKey("").hash() == makeKeyHash(0, 0, 0), "the empty key");
+
+void setUp() {}
+void tearDown() {}
+
+void test_size_and_hash() {
+  TEST_ASSERT_EQUAL_STRING("wind", windKey.c_str());
+  TEST_ASSERT_EQUAL_UINT8(hashKey("wind"), windKey.hash());
+  TEST_ASSERT_EQUAL_UINT8(hashKey("temp_min"), JsonKey("temp_min").hash());
+  TEST_ASSERT_EQUAL_UINT8(hashKey("\xc3\xa9t\xc3\xa9"), JsonKey("\xc3\xa9t\xc3\xa9").hash()); // INFO: chars over 127
+  TEST_ASSERT_EQUAL_UINT8(hashKey(""), JsonKey("").hash());
+  TEST_ASSERT_EQUAL_size_t(strlen("feels_like"), JsonKey("feels_like").size());
+}
+
+void test_like_a_literal() {
+  DynamicJsonDocument doc(1024);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, answer).c_str());
+  TEST_ASSERT_TRUE(doc[windKey][speedKey] == doc["wind"]["speed"]);
+  TEST_ASSERT_EQUAL_FLOAT(3.6f, doc[windKey][speedKey].as<float>());
+  TEST_ASSERT_EQUAL_INT(240, doc[JsonKey("wind")][JsonKey("deg")].as<int>());
+  TEST_ASSERT_EQUAL_INT(701, doc[JsonKey("weather")][1][JsonKey("id")].as<int>());
+  TEST_ASSERT_EQUAL_STRING("empty", doc[JsonKey("")].as<const char*>());
+
+  // INFO: the prefixes and the keys that start them; "temp" is before "temp_min"
+  JsonObject main = doc[JsonKey("main")];
+  TEST_ASSERT_EQUAL_FLOAT(293.15f, main[JsonKey("temp")].as<float>());
+  TEST_ASSERT_EQUAL_FLOAT(291.48f, main[JsonKey("temp_min")].as<float>());
+  TEST_ASSERT_EQUAL_FLOAT(294.82f, main[JsonKey("temp_max")].as<float>());
+  TEST_ASSERT_TRUE(main[JsonKey("tem")].isNull());
+  TEST_ASSERT_TRUE(main[JsonKey("temp_")].isNull());
+  TEST_ASSERT_TRUE(main[JsonKey("temp_mid")].isNull()); // INFO: the hash of temp_min and temp_max
+  TEST_ASSERT_TRUE(main[JsonKey("temp_minimum")].isNull());
+  TEST_ASSERT_TRUE(doc[JsonKey("missing")][JsonKey("wind")].isNull());
+}
+
+void test_every_type() {
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, answer);
+  JsonObject object = doc.as<JsonObject>();
+  JsonObjectConst constObject = object;
+  JsonVariant variant = doc.as<JsonVariant>();
+  JsonVariantConst constVariant = variant;
+  TEST_ASSERT_EQUAL_INT(500, object[JsonKey("weather")][0][JsonKey("id")].as<int>());
+  TEST_ASSERT_EQUAL_STRING("Rain", constObject[JsonKey("weather")][0][JsonKey("main")].as<const char*>());
+  TEST_ASSERT_EQUAL_UINT32(1600000000UL, variant[JsonKey("dt")].as<unsigned long>());
+  TEST_ASSERT_EQUAL_STRING("Frankfurt am Main", constVariant[JsonKey("name")].as<const char*>());
+  TEST_ASSERT_EQUAL_FLOAT(8.68f, object.getMember(JsonKey("coord"))[JsonKey("lon")].as<float>());
+  TEST_ASSERT_TRUE(object.containsKey(JsonKey("coord")));
+  TEST_ASSERT_FALSE(object.containsKey(JsonKey("coor")));
+  TEST_ASSERT_TRUE(doc.containsKey(windKey));
+  TEST_ASSERT_TRUE(variant.containsKey(windKey));
+  TEST_ASSERT_TRUE(doc[windKey].containsKey(speedKey));
+}
+
+void test_set_and_remove() {
+  DynamicJsonDocument byKey(1024);
+  DynamicJsonDocument byLiteral(1024);
+  byKey[windKey][speedKey] = 3.6;
+  byKey[JsonKey("dt")] = 1600000000UL;
+  byLiteral["wind"]["speed"] = 3.6;
+  byLiteral["dt"] = 1600000000UL;
+  std::string expected, output;
+  serializeJson(byLiteral, expected);
+  serializeJson(byKey, output);
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+  // INFO: the keys are linked, like those of a const char*; compact slots copy every string
+  TEST_ASSERT_EQUAL_size_t(byLiteral.memoryUsage(), byKey.memoryUsage());
+  const char* key = byKey.as<JsonObjectConst>().begin()->key().c_str();
+  TEST_ASSERT_TRUE(key == windKey.c_str() || ARDUINOJSON_COMPACT_SLOTS);
+
+  byKey[windKey][speedKey] = 4.5; // INFO: the same member, not a new one
+  TEST_ASSERT_EQUAL_size_t(1, byKey[windKey].size());
+  TEST_ASSERT_EQUAL_FLOAT(4.5f, byKey["wind"]["speed"].as<float>());
+  byKey.remove(JsonKey("dt"));
+  byKey[windKey].remove(speedKey);
+  output.clear();
+  serializeJson(byKey, output);
+  TEST_ASSERT_EQUAL_STRING("{\"wind\":{}}", output.c_str());
+}
+
+void test_keys_from_elsewhere() {
+  // INFO: the keys of the document are owned, in the input, or linked
+  DynamicJsonDocument doc(1024);
+  std::string json = answer;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, &json[0]).c_str());
+  TEST_ASSERT_EQUAL_FLOAT(3.6f, doc[windKey][speedKey].as<float>());
+  doc[std::string("owned")] = 1;
+  const char* linked = "linked";
+  doc[linked] = 2;
+  TEST_ASSERT_EQUAL_INT(1, doc[JsonKey("owned")].as<int>());
+  TEST_ASSERT_EQUAL_INT(2, doc[JsonKey("linked")].as<int>());
+  TEST_ASSERT_TRUE(doc[JsonKey("linke")].isNull());
+  TEST_ASSERT_TRUE(doc[JsonKey("linkedd")].isNull());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_size_and_hash);
+  RUN_TEST(test_like_a_literal);
+  RUN_TEST(test_every_type);
+  RUN_TEST(test_set_and_remove);
+  RUN_TEST(test_keys_from_elsewhere);
+  return UNITY_END();
+}
@@ -0,0 +1,180 @@
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <sstream>
+#include <string>
+#include <unity.h>
+
+/**
+ * JsonLinesReader and JsonLinesWriter: one document per line, read in a single pass from strings and streams.
+ * */
+
+StaticJsonDocument<512> doc;
+
+std::string readAll(JsonLinesReader<std::string>& lines) {
+  std::string result;
+  while (!lines.atEnd()) {
+    DeserializationError err = lines.read();
+    if (err) {
+      result += err.c_str();
+    } else {
+      serializeJson(doc, result);
+    }
+    result += "|";
+  }
+  return result;
+}
+
+std::string readAll(const std::string& input) {
+  JsonLinesReader<std::string> lines(doc, input);
+  return readAll(lines);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_sequence() {
+  TEST_ASSERT_EQUAL_STRING("{\"a\":1}|[2]|\"three\"|", readAll("{\"a\":1}\n[2]\n\"three\"\n").c_str());
+  TEST_ASSERT_EQUAL_STRING("{\"a\":1}|[2]|", readAll("{\"a\":1}\r\n[2]").c_str()); // INFO: CRLF, no final line break
+  TEST_ASSERT_EQUAL_STRING("", readAll("").c_str());
+  TEST_ASSERT_EQUAL_STRING("", readAll("\n  \n\r\n").c_str());
+}
+
+void test_numbers_at_the_root() {
+  // INFO: deserializeJson() would lose the character after each number
+  TEST_ASSERT_EQUAL_STRING("1|-2.5|true|null|", readAll("1\n-2.5\ntrue\nnull\n").c_str());
+}
+
+void test_blank_lines_and_spaces() {
+  TEST_ASSERT_EQUAL_STRING("[1]|[2]|", readAll("\n\n  [1]  \n\t\n[2]\n\n").c_str());
+}
+
+void test_document_spanning_lines() {
+  TEST_ASSERT_EQUAL_STRING("{\"a\":[1,2]}|[3]|", readAll("{\n  \"a\": [\n    1,\n    2\n  ]\n}\n[3]\n").c_str());
+}
+
+void test_two_documents_on_a_line() {
+  TEST_ASSERT_EQUAL_STRING("InvalidInput|[3]|", readAll("[1] [2]\n[3]\n").c_str());
+}
+
+void test_resync_after_errors() {
+  const char* input = "[1]\n"
+                      "{\"truncated\": \n" // INFO: goes on with the next line, which is invalid and skipped
+                      "<html>garbage</html>\n"
+                      "[tru3]\n"
+                      "[4]\n";
+  TEST_ASSERT_EQUAL_STRING("[1]|InvalidInput|InvalidInput|[4]|", readAll(input).c_str());
+}
+
+void test_error_on_the_last_line() {
+  TEST_ASSERT_EQUAL_STRING("[1]|IncompleteInput|", readAll("[1]\n[2,").c_str());
+}
+
+void test_no_memory_skips_the_line() {
+  StaticJsonDocument<JSON_ARRAY_SIZE(2)> small;
+  std::string input = "[1,2]\n[1,2,3,4,5,6,7,8]\n[3]\n";
+  JsonLinesReader<std::string> lines(small, input);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("NoMemory", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_INT(3, small[0].as<int>());
+  TEST_ASSERT_TRUE(lines.atEnd());
+}
+
+void test_filter_and_nesting_limit() {
+  StaticJsonDocument<64> filter;
+  filter["id"] = true;
+  std::string input = "{\"id\":1,\"skip\":[1,2]}\n[[[1]]]\n{\"id\":3}\n";
+  JsonLinesReader<std::string> lines(doc, input);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read(DeserializationOption::Filter(filter)).c_str());
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1}", doc.as<std::string>().c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep", lines.read(DeserializationOption::NestingLimit(2)).c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_INT(3, doc["id"].as<int>());
+}
+
+void test_char_pointer_input() {
+  char input[] = "{\"name\":\"a\"}\n{\"name\":\"b\"}\n";
+  JsonLinesReader<char*> lines(doc, input);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("a", doc["name"].as<const char*>());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("b", doc["name"].as<const char*>());
+  TEST_ASSERT_TRUE(lines.atEnd());
+}
+
+void test_istream_input() {
+  std::istringstream input("[1]\n2\n{\"a\":3}\n");
+  JsonLinesReader<std::istream> lines(doc, input);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_INT(2, doc.as<int>());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_INT(3, doc["a"].as<int>());
+  TEST_ASSERT_TRUE(lines.atEnd());
+  TEST_ASSERT_TRUE(input.eof());
+}
+
+void test_istream_without_buffer() {
+  std::istringstream empty;
+  std::istream input(NULL); // INFO: rdbuf() is null
+  TEST_ASSERT_EQUAL_STRING(deserializeJson(doc, empty).c_str(), deserializeJson(doc, input).c_str());
+  TEST_ASSERT_TRUE(input.eof());
+  TEST_ASSERT_TRUE(input.fail());
+
+  std::istream none(NULL);
+  JsonLinesReader<std::istream> lines(doc, none);
+  TEST_ASSERT_TRUE(lines.atEnd());
+}
+
+void test_writer_round_trip() {
+  std::ostringstream output;
+  {
+    JsonLinesWriter<std::ostream> writer(output);
+    StaticJsonDocument<128> item;
+    item["text"] = "line\nbreak"; // INFO: escaped, so the document keeps its line
+    writer.write(item);
+    item.clear();
+    item.add(1);
+    writer.write(item);
+    WeatherReport report = WeatherReport();
+    report.dt = 7;
+    report.weatherCount = 1;
+    report.weather[0].id = 800;
+    writer.write(report);
+    TEST_ASSERT_TRUE(output.str().size() < writer.bytesWritten()); // INFO: the end is still in the buffer
+    writer.flush();
+    TEST_ASSERT_EQUAL_size_t(writer.bytesWritten(), output.str().size());
+  }
+  TEST_ASSERT_EQUAL_STRING("{\"text\":\"line\\nbreak\"}\n[1]\n{\"dt\":7,\"wind\":{\"speed\":0},\"weather\":[{\"id\":800}]}\n",
+                           output.str().c_str());
+
+  std::string written = output.str();
+  JsonLinesReader<std::string> lines(doc, written);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_EQUAL_STRING("line\nbreak", doc["text"].as<const char*>());
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  WeatherReport report = WeatherReport();
+  std::string third = written.substr(written.find("{\"dt\""));
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, third).c_str());
+  TEST_ASSERT_EQUAL_UINT(7, report.dt);
+  TEST_ASSERT_EQUAL_STRING("Ok", lines.read().c_str());
+  TEST_ASSERT_TRUE(lines.atEnd());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_sequence);
+  RUN_TEST(test_numbers_at_the_root);
+  RUN_TEST(test_blank_lines_and_spaces);
+  RUN_TEST(test_document_spanning_lines);
+  RUN_TEST(test_two_documents_on_a_line);
+  RUN_TEST(test_resync_after_errors);
+  RUN_TEST(test_error_on_the_last_line);
+  RUN_TEST(test_no_memory_skips_the_line);
+  RUN_TEST(test_filter_and_nesting_limit);
+  RUN_TEST(test_char_pointer_input);
+  RUN_TEST(test_istream_input);
+  RUN_TEST(test_istream_without_buffer);
+  RUN_TEST(test_writer_round_trip);
+  return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#include <ArduinoJson.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * The bin and ext values of deserializeMsgPack(): serializeMsgPack() writes them back unchanged, serializeJson()
+ * writes null instead of the binary bytes.
+ * */
+
+// {"id":1,"bin":<bin8 01 02 03>,"ext":<fixext4 type 5>,"str":"ok"}
+const uint8_t message[] = {
+  0x84,
+  0xa2, 'i', 'd', 0x01,
+  0xa3, 'b', 'i', 'n', 0xc4, 0x03, 0x01, 0x02, 0x03,
+  0xa3, 'e', 'x', 't', 0xd6, 0x05, 0xde, 0xad, 0xbe, 0xef,
+  0xa3, 's', 't', 'r', 0xa2, 'o', 'k'
+};
+
+const char* expectedJson = "{\"id\":1,\"bin\":null,\"ext\":null,\"str\":\"ok\"}";
+
+void setUp() {}
+void tearDown() {}
+
+void test_copied_input() {
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, (const char*)message, sizeof(message)).c_str());
+  std::string json;
+  serializeJson(doc, json);
+  TEST_ASSERT_EQUAL_STRING(expectedJson, json.c_str());
+  TEST_ASSERT_EQUAL_size_t(json.size(), measureJson(doc));
+}
+
+void test_input_in_place() {
+  char buffer[sizeof(message)];
+  memcpy(buffer, message, sizeof(message));
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, buffer, sizeof(buffer)).c_str());
+  std::string json;
+  serializeJson(doc, json);
+  TEST_ASSERT_EQUAL_STRING(expectedJson, json.c_str());
+}
+
+void test_pretty() {
+  StaticJsonDocument<256> doc;
+  deserializeMsgPack(doc, (const char*)message, sizeof(message));
+  std::string json;
+  serializeJsonPretty(doc["bin"], json);
+  TEST_ASSERT_EQUAL_STRING("null", json.c_str());
+  json.clear();
+  serializeJsonPretty(doc["ext"], json);
+  TEST_ASSERT_EQUAL_STRING("null", json.c_str());
+}
+
+void test_msgpack_round_trip() {
+  StaticJsonDocument<256> doc;
+  deserializeMsgPack(doc, (const char*)message, sizeof(message));
+  uint8_t output[64];
+  TEST_ASSERT_EQUAL_size_t(sizeof(message), serializeMsgPack(doc, output, sizeof(output)));
+  TEST_ASSERT_EQUAL_MEMORY(message, output, sizeof(message));
+}
+
+void test_every_header() {
+  // bin8, bin16, bin32, ext8, ext16, ext32, fixext1, 2, 4, 8, 16
+  const uint8_t headers[][7] = {
+    {2, 0xc4, 0x00}, {3, 0xc5, 0x00, 0x00}, {5, 0xc6, 0x00, 0x00, 0x00, 0x00},
+    {3, 0xc7, 0x00, 0x01}, {4, 0xc8, 0x00, 0x00, 0x01}, {6, 0xc9, 0x00, 0x00, 0x00, 0x00, 0x01},
+  };
+  for (size_t i = 0; i < sizeof(headers) / sizeof(headers[0]); i++) {
+    StaticJsonDocument<64> doc;
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, (const char*)headers[i] + 1, headers[i][0]).c_str());
+    std::string json;
+    serializeJson(doc, json);
+    TEST_ASSERT_EQUAL_STRING("null", json.c_str());
+  }
+  for (uint8_t code = 0xd4; code <= 0xd8; code++) {
+    uint8_t fixext[18] = {code, 0x01};
+    StaticJsonDocument<64> doc;
+    size_t size = 2 + (size_t(1) << (code - 0xd4));
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, (const char*)fixext, size).c_str());
+    std::string json;
+    serializeJson(doc, json);
+    TEST_ASSERT_EQUAL_STRING("null", json.c_str());
+  }
+}
+
+void test_serialized_json_is_unchanged() {
+  StaticJsonDocument<64> doc;
+  doc["raw"] = serialized("[1,2]");
+  std::string json;
+  serializeJson(doc, json);
+  TEST_ASSERT_EQUAL_STRING("{\"raw\":[1,2]}", json.c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_copied_input);
+  RUN_TEST(test_input_in_place);
+  RUN_TEST(test_pretty);
+  RUN_TEST(test_msgpack_round_trip);
+  RUN_TEST(test_every_header);
+  RUN_TEST(test_serialized_json_is_unchanged);
+  return UNITY_END();
+}
@@ -0,0 +1,184 @@
+#include <ArduinoJson.h>
+#include <sstream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * deserializeMsgPack() with a filter: the result must be that of deserializeJson() with the same filter on the same
+ * values, from every kind of input, and the skipped values must take no memory.
+ * */
+
+const char* forecast = "{\"cod\":\"200\",\"cnt\":3,\"list\":["
+                       "{\"dt\":1600000000,\"main\":{\"temp\":293.15,\"humidity\":82},\"weather\":[{\"id\":500,\"main\":\"Rain\",\"description\":\"light rain\"}],\"wind\":{\"speed\":3.6,\"deg\":240}},"
+                       "{\"dt\":1600010800,\"main\":{\"temp\":291.5,\"humidity\":90},\"weather\":[{\"id\":701,\"main\":\"Mist\",\"description\":\"mist\"},{\"id\":800}],\"wind\":{\"speed\":1.5,\"deg\":250}},"
+                       "{\"dt\":1600021600,\"main\":{\"temp\":-1e300,\"humidity\":null},\"weather\":[],\"wind\":{\"speed\":0,\"deg\":-1}}],"
+                       "\"city\":{\"name\":\"Frankfurt am Main\",\"coord\":{\"lat\":50.11,\"lon\":8.68},\"population\":18446744073709551615}}";
+
+const char* weatherFilter = "{\"list\":[{\"dt\":true,\"weather\":[{\"id\":true}]}],\"city\":{\"name\":true}}";
+
+const char* filtered = "{\"list\":[{\"dt\":1600000000,\"weather\":[{\"id\":500}]},{\"dt\":1600010800,\"weather\":[{\"id\":701},"
+                       "{\"id\":800}]},{\"dt\":1600021600,\"weather\":[]}],\"city\":{\"name\":\"Frankfurt am Main\"}}";
+
+StaticJsonDocument<512> filter;
+
+std::string msgPackOf(const char* json) {
+  DynamicJsonDocument doc(4096);
+  deserializeJson(doc, json);
+  std::string output;
+  serializeMsgPack(doc, output);
+  return output;
+}
+
+template <typename TInput>
+std::string filteredFrom(TInput input) {
+  DynamicJsonDocument doc(4096);
+  DeserializationError error = deserializeMsgPack(doc, input, DeserializationOption::Filter(filter));
+  std::string output = error.c_str();
+  output += " ";
+  serializeJson(doc, output);
+  return output;
+}
+
+void setUp() {
+  deserializeJson(filter, weatherFilter);
+}
+
+void tearDown() {}
+
+void test_like_json() {
+  DynamicJsonDocument json(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(json, forecast, DeserializationOption::Filter(filter)).c_str());
+  std::string expected = "Ok ";
+  serializeJson(json, expected);
+  TEST_ASSERT_EQUAL_STRING(("Ok " + std::string(filtered)).c_str(), expected.c_str());
+
+  std::string msgPack = msgPackOf(forecast);
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), filteredFrom(msgPack).c_str());
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), filteredFrom(msgPack.c_str()).c_str()); // INFO: const char*, no size
+  std::istringstream input(msgPack);
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), filteredFrom<std::istream&>(input).c_str());
+
+  std::string copy = msgPack;
+  char* writable = &copy[0];
+  DynamicJsonDocument doc(4096);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, writable, copy.size(), DeserializationOption::Filter(filter)).c_str());
+  TEST_ASSERT_EQUAL_STRING("Frankfurt am Main", doc["city"]["name"].as<const char*>());
+  const char* name = doc["city"]["name"];
+  // INFO: zero-copy, like without a filter; compact slots copy every string
+  TEST_ASSERT_TRUE((name >= writable && name < writable + copy.size()) || ARDUINOJSON_COMPACT_SLOTS);
+}
+
+void test_memory() {
+  DynamicJsonDocument json(4096);
+  deserializeJson(json, forecast, DeserializationOption::Filter(filter));
+  std::string msgPack = msgPackOf(forecast);
+  DynamicJsonDocument doc(4096);
+  deserializeMsgPack(doc, msgPack, DeserializationOption::Filter(filter));
+  TEST_ASSERT_EQUAL_size_t(json.memoryUsage(), doc.memoryUsage()); // INFO: the rejected keys are reclaimed
+
+  DynamicJsonDocument full(4096);
+  deserializeMsgPack(full, msgPack);
+  TEST_ASSERT_TRUE(doc.memoryUsage() < full.memoryUsage() / 2);
+}
+
+void test_truncated() {
+  std::string msgPack = msgPackOf(forecast);
+  for (size_t n = 0; n < msgPack.size(); n++) {
+    std::string prefix = msgPack.substr(0, n);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("IncompleteInput ", filteredFrom(prefix).substr(0, 16).c_str(), "string");
+    std::istringstream input(prefix);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("IncompleteInput ", filteredFrom<std::istream&>(input).substr(0, 16).c_str(), "stream");
+  }
+}
+
+void test_skip_every_type() {
+  // {"skip":[<bin8 3>,<bin16 2>,<bin32 1>,<fixext1>,<fixext16>,<ext8 3>,<ext16 1>,<ext32 0>,<str8 2>,<str16 1>,<str32 0>,
+  //  <float32>,<float64>,<uint64>,<int64>,<uint16>,<int32>,nil,false,true,-1,{"a":{}}],"keep":1}
+  const uint8_t message[] = {
+    0x82, 0xa4, 's', 'k', 'i', 'p', 0xdc, 0x00, 0x16,
+    0xc4, 0x03, 1, 2, 3,
+    0xc5, 0x00, 0x02, 1, 2,
+    0xc6, 0x00, 0x00, 0x00, 0x01, 1,
+    0xd4, 0x01, 0xff,
+    0xd8, 0x01, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0xc7, 0x03, 0x01, 1, 2, 3,
+    0xc8, 0x00, 0x01, 0x01, 1,
+    0xc9, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0xd9, 0x02, 'a', 'b',
+    0xda, 0x00, 0x01, 'c',
+    0xdb, 0x00, 0x00, 0x00, 0x00,
+    0xca, 0x40, 0x49, 0x0f, 0xdb,
+    0xcb, 0x40, 0x09, 0x21, 0xfb, 0x54, 0x44, 0x2d, 0x18,
+    0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xd3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xcd, 0x12, 0x34,
+    0xd2, 0xff, 0xff, 0xff, 0xfe,
+    0xc0, 0xc2, 0xc3, 0xff,
+    0x81, 0xa1, 'a', 0x80,
+    0xa4, 'k', 'e', 'e', 'p', 0x01
+  };
+  StaticJsonDocument<64> keep;
+  keep["keep"] = true;
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, (const char*)message, sizeof(message),
+                                                    DeserializationOption::Filter(keep)).c_str());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("{\"keep\":1}", output.c_str());
+
+  std::istringstream input(std::string((const char*)message, sizeof(message)));
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, input, DeserializationOption::Filter(keep)).c_str());
+  TEST_ASSERT_EQUAL_INT(1, doc["keep"].as<int>());
+
+  StaticJsonDocument<8> all;
+  all.set(true);
+  StaticJsonDocument<1024> everything;
+  // INFO: without long long, the 64-bit integers are only NotSupported when they're kept
+  DeserializationError error = deserializeMsgPack(everything, (const char*)message, sizeof(message),
+                                                  DeserializationOption::Filter(all));
+  TEST_ASSERT_EQUAL_STRING(ARDUINOJSON_USE_LONG_LONG ? "Ok" : "NotSupported", error.c_str());
+  if (!error) {
+    TEST_ASSERT_EQUAL_size_t(22, everything["skip"].size()); // INFO: the same bytes, not skipped, make 22 values
+  }
+}
+
+void test_nesting_limit() {
+  std::string msgPack = msgPackOf("{\"skip\":[[[[1]]]],\"keep\":1}");
+  StaticJsonDocument<64> keep;
+  keep["keep"] = true;
+  StaticJsonDocument<256> doc;
+  // INFO: the skipped containers count too
+  TEST_ASSERT_EQUAL_STRING("TooDeep", deserializeMsgPack(doc, msgPack, DeserializationOption::Filter(keep),
+                                                         DeserializationOption::NestingLimit(4)).c_str());
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, msgPack, DeserializationOption::Filter(keep),
+                                                    DeserializationOption::NestingLimit(5)).c_str());
+  TEST_ASSERT_EQUAL_INT(1, doc["keep"].as<int>());
+}
+
+void test_filter_on_the_root() {
+  std::string msgPack = msgPackOf(forecast);
+  StaticJsonDocument<256> doc;
+  StaticJsonDocument<8> nothing;
+  nothing.set(false);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, msgPack, DeserializationOption::Filter(nothing)).c_str());
+  TEST_ASSERT_TRUE(doc.isNull());
+  TEST_ASSERT_EQUAL_size_t(0, doc.memoryUsage());
+
+  StaticJsonDocument<64> arrayFilter; // INFO: an array filter on an object keeps nothing, as in JSON
+  arrayFilter.add(true);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, msgPack, DeserializationOption::Filter(arrayFilter)).c_str());
+  TEST_ASSERT_TRUE(doc.isNull());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_like_json);
+  RUN_TEST(test_memory);
+  RUN_TEST(test_truncated);
+  RUN_TEST(test_skip_every_type);
+  RUN_TEST(test_nesting_limit);
+  RUN_TEST(test_filter_on_the_root);
+  return UNITY_END();
+}
@@ -0,0 +1,201 @@
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <sstream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * MsgPackWriter and serializeMsgPack() of bound structs: the bytes must be those of serializeMsgPack() on the same
+ * values in a document, and the chunked arrays must concatenate to the elements that were written.
+ * */
+
+const char* weatherAnswer = "{\"dt\":1600000000,\"wind\":{\"speed\":3.5},\"weather\":[{\"id\":500},{\"id\":701}]}";
+
+std::string documentMsgPack(const char* json) {
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, json);
+  std::string output;
+  serializeMsgPack(doc, output);
+  return output;
+}
+
+std::string asJson(const std::string& msgPack) {
+  DynamicJsonDocument doc(1024);
+  DeserializationError error = deserializeMsgPack(doc, msgPack);
+  std::string output = error.c_str();
+  output += " ";
+  serializeJson(doc, output);
+  return output;
+}
+
+/**
+ * Reads the arrays of a chunked output and prints their elements as one JSON array, or what's wrong with them
+ * */
+std::string concatenatedChunks(const std::string& msgPack, size_t capacity) {
+  std::istringstream input(msgPack);
+  std::string output = "[";
+  do {
+    DynamicJsonDocument chunk(1024);
+    DeserializationError error = deserializeMsgPack(chunk, input);
+    if (error) {
+      return error.c_str();
+    }
+    if (!chunk.is<JsonArray>()) {
+      return "not an array";
+    }
+    if (chunk.size() > 1 && measureMsgPack(chunk) - 1 > capacity) { // INFO: the elements, without the header
+      return "a chunk larger than the buffer";
+    }
+    for (size_t i = 0; i < chunk.size(); i++) {
+      if (output.size() > 1) {
+        output += ",";
+      }
+      serializeJson(chunk[i], output);
+    }
+  } while (input.peek() != EOF);
+  return output + "]";
+}
+
+WeatherReport parsedReport() {
+  WeatherReport report = WeatherReport();
+  deserializeJson(report, weatherAnswer);
+  return report;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_scalars() {
+  std::string output;
+  {
+    MsgPackWriter<std::string> writer(output);
+    writer.beginArray(11);
+    writer.write(true);
+    writer.write(false);
+    writer.writeNull();
+    writer.write(42);
+    writer.write(-1);
+    writer.write(uint8_t(200));
+    writer.write(70000L);
+    writer.write(-40000);
+    writer.write(3.5);
+    writer.write(0.5f);
+    writer.write("light rain");
+  }
+  TEST_ASSERT_TRUE(documentMsgPack("[true,false,null,42,-1,200,70000,-40000,3.5,0.5,\"light rain\"]") == output);
+}
+
+void test_map() {
+  std::string output;
+  MsgPackWriter<std::string> writer(output);
+  writer.beginMap(2);
+  writer.write("dt");
+  writer.write(1600000000UL);
+  writer.write("weather");
+  writer.beginArray(0);
+  TEST_ASSERT_TRUE(documentMsgPack("{\"dt\":1600000000,\"weather\":[]}") == output);
+  TEST_ASSERT_EQUAL_size_t(output.size(), writer.bytesWritten());
+}
+
+void test_documents_and_variants() {
+  DynamicJsonDocument doc(1024);
+  deserializeJson(doc, weatherAnswer);
+  std::string output;
+  MsgPackWriter<std::string> writer(output);
+  writer.beginArray(3);
+  writer.write(doc);
+  writer.write(doc["wind"]);
+  writer.write(doc["weather"].as<JsonArrayConst>());
+  std::string expected = "[" + std::string(weatherAnswer) + ",{\"speed\":3.5},[{\"id\":500},{\"id\":701}]]";
+  TEST_ASSERT_EQUAL_STRING(("Ok " + expected).c_str(), asJson(output).c_str());
+  TEST_ASSERT_TRUE(documentMsgPack(expected.c_str()) == output);
+}
+
+void test_bound_struct() {
+  WeatherReport report = parsedReport();
+  std::string output;
+  size_t n = serializeMsgPack(report, output);
+  TEST_ASSERT_EQUAL_size_t(output.size(), n);
+  TEST_ASSERT_EQUAL_size_t(n, measureMsgPack(report));
+  TEST_ASSERT_TRUE(documentMsgPack(weatherAnswer) == output);
+
+  std::string written;
+  MsgPackWriter<std::string> writer(written);
+  writer.write(report);
+  TEST_ASSERT_TRUE(output == written);
+
+  char buffer[64];
+  TEST_ASSERT_EQUAL_size_t(n, serializeMsgPack(report, buffer, sizeof(buffer)));
+  TEST_ASSERT_EQUAL_MEMORY(output.data(), buffer, n);
+}
+
+void test_chunks_at_every_size() {
+  WeatherReport report = parsedReport();
+  std::string expected = "[1,\"Frankfurt am Main, a name longer than some of the buffers\",3.5,null,true," +
+                         std::string(weatherAnswer) + ",-7200,\"01d\"]";
+  for (size_t capacity = 1; capacity <= 128; capacity++) {
+    uint8_t buffer[128];
+    std::string output;
+    MsgPackWriter<std::string> writer(output);
+    writer.beginArray(buffer, capacity);
+    writer.write(1);
+    writer.write("Frankfurt am Main, a name longer than some of the buffers");
+    writer.write(3.5);
+    writer.writeNull();
+    writer.write(true);
+    writer.write(report);
+    writer.write(-7200);
+    writer.write("01d");
+    writer.endArray();
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), concatenatedChunks(output, capacity).c_str());
+    if (capacity == 128) {
+      TEST_ASSERT_TRUE(documentMsgPack(expected.c_str()) == output); // INFO: everything fits, one array
+    }
+  }
+}
+
+void test_empty_chunked_array() {
+  uint8_t buffer[16];
+  std::string output;
+  MsgPackWriter<std::string> writer(output);
+  writer.beginArray(buffer, sizeof(buffer));
+  writer.endArray();
+  TEST_ASSERT_EQUAL_size_t(1, output.size());
+  TEST_ASSERT_EQUAL_UINT8(0x90, uint8_t(output[0]));
+
+  writer.beginArray(buffer, 1); // INFO: every element is sent alone, no empty array after them
+  writer.write("too long");
+  writer.write("for the buffer");
+  writer.endArray();
+  TEST_ASSERT_EQUAL_STRING("[\"too long\",\"for the buffer\"]", concatenatedChunks(output.substr(1), 1).c_str());
+}
+
+void test_buffered_stream() {
+  std::ostringstream os;
+  {
+    MsgPackWriter<std::ostream> writer(os);
+    writer.beginArray(2);
+    writer.write(parsedReport());
+    writer.write("end");
+    writer.flush();
+    TEST_ASSERT_EQUAL_size_t(os.str().size(), writer.bytesWritten());
+    writer.write(1); // INFO: sent by the destructor
+  }
+  std::string expected = documentMsgPack(("[" + std::string(weatherAnswer) + ",\"end\"]").c_str());
+  expected += '\x01';
+  TEST_ASSERT_TRUE(expected == os.str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_scalars);
+  RUN_TEST(test_map);
+  RUN_TEST(test_documents_and_variants);
+  RUN_TEST(test_bound_struct);
+  RUN_TEST(test_chunks_at_every_size);
+  RUN_TEST(test_empty_chunked_array);
+  RUN_TEST(test_buffered_stream);
+  return UNITY_END();
+}
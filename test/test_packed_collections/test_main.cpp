@@ -0,0 +1,172 @@
+#include <ArduinoJson.h>
+#include <string>
+#include <unity.h>
+
+using ARDUINOJSON_NAMESPACE::CollectionData;
+using ARDUINOJSON_NAMESPACE::VariantData;
+
+/**
+ * Packed collections: the parsers leave the slots of arrays and objects contiguous, so that indexing is O(1), and
+ * anything that breaks the sequence must fall back to the linked list without changing what the document holds.
+ * */
+
+const char* objects = "[{\"id\":0,\"tags\":[\"a\",\"b\"]},{\"id\":1,\"tags\":[]},{\"id\":2,\"tags\":[\"c\"]},"
+                      "{\"id\":3,\"tags\":[\"d\",\"e\",\"f\"]},{\"id\":4,\"tags\":[{\"deep\":[4]}]}]";
+
+const CollectionData* collectionOf(const VariantData* variant) {
+  return variant->isArray() ? variant->asArray() : variant->asObject();
+}
+
+/**
+ * True if the collection, and every collection under it, is packed
+ * */
+bool allPacked(const VariantData* variant) {
+  if (!variant->isArray() && !variant->isObject()) {
+    return true;
+  }
+  const CollectionData* collection = collectionOf(variant);
+  if (!collection->isPacked()) {
+    return false;
+  }
+  for (size_t i = 0; i < collection->size(); i++) { // INFO: getElement() also gives the values of an object
+    if (!allPacked(collection->getElement(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Every way of reaching the elements must agree: operator[], the iterator, and the serializer
+ * */
+void checkElements(JsonArrayConst array, const char* json) {
+  size_t index = 0;
+  for (JsonArrayConst::iterator it = array.begin(); it != array.end(); ++it, ++index) {
+    TEST_ASSERT_TRUE(*it == array[index]);
+    TEST_ASSERT_EQUAL_INT(index, array[index]["id"].as<int>());
+  }
+  TEST_ASSERT_EQUAL_size_t(index, array.size());
+  TEST_ASSERT_TRUE(array[index].isNull());
+  std::string output;
+  serializeJson(array, output);
+  TEST_ASSERT_EQUAL_STRING(json, output.c_str());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_scalar_array() {
+  StaticJsonDocument<512> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "[10,11,12,13,14,15,16,17,18,19]").c_str());
+  TEST_ASSERT_TRUE(doc.data().asArray()->isPacked());
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL_INT(10 + i, doc[i].as<int>());
+  }
+  TEST_ASSERT_TRUE(doc[10].isNull());
+}
+
+void test_array_of_objects() {
+#if ARDUINOJSON_PACK_COLLECTIONS
+  StaticJsonDocument<1024> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, objects).c_str());
+  TEST_ASSERT_TRUE(allPacked(&doc.data()));
+  checkElements(doc.as<JsonArrayConst>(), objects);
+  TEST_ASSERT_EQUAL_STRING("f", doc[3]["tags"][2].as<const char*>());
+  TEST_ASSERT_EQUAL_INT(4, doc[4]["tags"][0]["deep"][0].as<int>());
+#endif
+}
+
+void test_msgpack() {
+#if ARDUINOJSON_PACK_COLLECTIONS
+  StaticJsonDocument<1024> doc;
+  deserializeJson(doc, objects);
+  std::string msgPack;
+  serializeMsgPack(doc, msgPack);
+
+  StaticJsonDocument<1024> copy;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(copy, msgPack).c_str());
+  TEST_ASSERT_TRUE(allPacked(&copy.data()));
+  checkElements(copy.as<JsonArrayConst>(), objects);
+#endif
+}
+
+void test_full_pool_stays_linked() {
+  // INFO: the smallest pool that holds the document leaves no room for the scratch slots of pack()
+  size_t capacity = 0;
+  DeserializationError error = DeserializationError::NoMemory;
+  while (error == DeserializationError::NoMemory) {
+    capacity += 8;
+    DynamicJsonDocument doc(capacity);
+    error = deserializeJson(doc, objects);
+    if (!error) {
+      TEST_ASSERT_FALSE(doc.data().asArray()->isPacked());
+      checkElements(doc.as<JsonArrayConst>(), objects);
+    }
+  }
+  TEST_ASSERT_EQUAL_STRING("Ok", error.c_str());
+}
+
+void test_duplicate_keys() {
+  StaticJsonDocument<512> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, "{\"a\":1,\"b\":[2],\"a\":3,\"c\":4}").c_str());
+  TEST_ASSERT_EQUAL_INT(3, doc["a"].as<int>());
+  TEST_ASSERT_EQUAL_INT(2, doc["b"][0].as<int>());
+  TEST_ASSERT_EQUAL_INT(4, doc["c"].as<int>());
+  TEST_ASSERT_EQUAL_size_t(3, doc.size());
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("{\"a\":3,\"b\":[2],\"c\":4}", output.c_str());
+}
+
+void test_modifications_fall_back_to_the_list() {
+  StaticJsonDocument<1024> doc;
+  deserializeJson(doc, "[0,1,2,3,4]");
+  JsonArray array = doc.as<JsonArray>();
+
+  array.remove(0); // INFO: the head, still contiguous
+  TEST_ASSERT_TRUE(doc.data().asArray()->isPacked());
+  TEST_ASSERT_EQUAL_INT(1, array[0].as<int>());
+
+  array.remove(1); // INFO: in the middle
+  TEST_ASSERT_FALSE(doc.data().asArray()->isPacked());
+  TEST_ASSERT_EQUAL_INT(3, array[1].as<int>());
+  TEST_ASSERT_EQUAL_size_t(3, array.size());
+
+  StaticJsonDocument<1024> other;
+  deserializeJson(other, "[[0,1],[2]]");
+  JsonArray first = other[0];
+  other[1].add(3); // INFO: now the next slot of the pool belongs to the second array
+  first.add(9);
+  TEST_ASSERT_FALSE(other.data().getElement(0)->asArray()->isPacked());
+  TEST_ASSERT_EQUAL_INT(9, first[2].as<int>());
+  TEST_ASSERT_TRUE(first[3].isNull());
+  first[4] = 5; // INFO: getOrAddElement() past the end of a linked array
+  std::string output;
+  serializeJson(other, output);
+  TEST_ASSERT_EQUAL_STRING("[[0,1,9,null,5],[2,3]]", output.c_str());
+}
+
+void test_add_to_a_packed_array() {
+  StaticJsonDocument<1024> doc;
+  deserializeJson(doc, "[0,1]");
+  JsonArray array = doc.as<JsonArray>();
+  array[3] = 3; // INFO: getOrAddElement() past the end of a packed array
+  array.add(4);
+  TEST_ASSERT_TRUE(doc.data().asArray()->isPacked()); // INFO: the new slots follow the last one
+  std::string output;
+  serializeJson(doc, output);
+  TEST_ASSERT_EQUAL_STRING("[0,1,null,3,4]", output.c_str());
+  TEST_ASSERT_EQUAL_INT(4, array[4].as<int>());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_scalar_array);
+  RUN_TEST(test_array_of_objects);
+  RUN_TEST(test_msgpack);
+  RUN_TEST(test_full_pool_stays_linked);
+  RUN_TEST(test_duplicate_keys);
+  RUN_TEST(test_modifications_fall_back_to_the_list);
+  RUN_TEST(test_add_to_a_packed_array);
+  return UNITY_END();
+}
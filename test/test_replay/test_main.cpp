@@ -0,0 +1,141 @@
+#include "../../tools/replay/ReplayArchive.h"
+#include <WeatherSnapshot.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+/**
+ * tools/replay: an archive of answers must parse to the same reports whatever the threads and the chunks, in the order
+ * of the archive, and the reports must survive a WeatherSnapshot.
+ * The pump decision itself needs TimeLib, which doesn't build here; weatherIsGood() stands in for it.
+ * */
+
+const char* archive = "{\"dt\":1600000000,\"wind\":{\"speed\":1.5},\"weather\":[{\"id\":800}]}\n"
+                      "\n"
+                      "{\"dt\":1600003600,\"wind\":{\"speed\":3},\"weather\":[{\"id\":500},{\"id\":801}]}\r\n"
+                      "  \t\n"
+                      "{\"dt\":1600007200,\"weather\":[{\"id\":801}]}\n" // INFO: no wind, must not keep the speed of the line before
+                      "<html>503</html>\n"
+                      "{\"dt\":1600010800,\"wind\":{\"speed\":0.5},\"weather\":[{\"id\":800},{\"id\":800},{\"id\":800},{\"id\":800},{\"id\":500}]}\n"
+                      "{\"dt\":1600014400,\"wind\":{\"speed\":1},\"weather\":[]}"; // INFO: no final line break
+
+std::string content;
+std::vector<Line> lines;
+
+void setUp() {
+  content = archive;
+  lines = splitLines(content);
+}
+
+void tearDown() {}
+
+void test_split_lines() {
+  TEST_ASSERT_EQUAL_size_t(6, lines.size());
+  const size_t numbers[] = {1, 3, 5, 6, 7, 8};
+  for (size_t i = 0; i < lines.size(); i++) {
+    TEST_ASSERT_EQUAL_size_t(numbers[i], lines[i].number);
+    TEST_ASSERT_TRUE(lines[i].json[lines[i].length] == '\n' || i == lines.size() - 1);
+  }
+  TEST_ASSERT_EQUAL_size_t(0, splitLines("").size());
+  TEST_ASSERT_EQUAL_size_t(0, splitLines("\n\r\n \n").size());
+}
+
+void test_replay_archive() {
+  std::vector<Parsed> results(lines.size());
+  for (size_t i = 0; i < results.size(); i++) { // INFO: like --bench, which parses into the results of the previous run
+    results[i].report.wind.speed = 9;
+    results[i].report.weatherCount = 1;
+    results[i].report.weather[0].id = 500;
+  }
+  parseLines(lines, results, 1, 256, [](size_t, size_t) {});
+  TEST_ASSERT_EQUAL_size_t(lines.size(), results.size());
+
+  TEST_ASSERT_FALSE(results[0].error);
+  TEST_ASSERT_EQUAL_UINT32(1600000000UL, results[0].report.dt);
+  TEST_ASSERT_EQUAL_FLOAT(1.5f, results[0].report.wind.speed);
+  TEST_ASSERT_TRUE(weatherIsGood(results[0].report));
+
+  TEST_ASSERT_FALSE(results[1].error); // INFO: the CR before the line break is a space for the parser
+  TEST_ASSERT_FALSE(weatherIsGood(results[1].report));
+
+  TEST_ASSERT_FALSE(results[2].error);
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, results[2].report.wind.speed);
+  TEST_ASSERT_TRUE(weatherIsGood(results[2].report));
+
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", results[3].error.c_str());
+
+  TEST_ASSERT_FALSE(results[4].error);
+  TEST_ASSERT_EQUAL_UINT8(5, results[4].report.weatherCount);
+  TEST_ASSERT_FALSE(weatherIsGood(results[4].report)); // INFO: the 5th state is rain, and isn't stored
+
+  TEST_ASSERT_FALSE(results[5].error);
+  TEST_ASSERT_EQUAL_UINT8(0, results[5].report.weatherCount);
+  TEST_ASSERT_TRUE(weatherIsGood(results[5].report));
+}
+
+void test_threads_and_chunks_give_the_same_reports() {
+  std::vector<Parsed> reference;
+  parseLines(lines, reference, 1, 256, [](size_t, size_t) {});
+
+  const unsigned threadCounts[] = {1, 2, 3, 8};
+  const size_t chunks[] = {1, 2, 4, 100};
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+      std::vector<Parsed> results;
+      size_t decided = 0;
+      parseLines(lines, results, threadCounts[t], chunks[c], [&](size_t begin, size_t end) {
+        TEST_ASSERT_EQUAL_size_t(decided, begin); // INFO: the chunks come in the order of the archive, each once
+        TEST_ASSERT_TRUE(end > begin && end - begin <= chunks[c]);
+        for (size_t i = begin; i < end; i++) {
+          TEST_ASSERT_EQUAL_UINT32(reference[i].report.dt, results[i].report.dt); // INFO: already parsed when decided
+        }
+        decided = end;
+      });
+      TEST_ASSERT_EQUAL_size_t(lines.size(), decided);
+      for (size_t i = 0; i < lines.size(); i++) {
+        TEST_ASSERT_TRUE(reference[i].error == results[i].error);
+        TEST_ASSERT_EQUAL_UINT32(reference[i].report.dt, results[i].report.dt);
+        TEST_ASSERT_EQUAL_FLOAT(reference[i].report.wind.speed, results[i].report.wind.speed);
+        TEST_ASSERT_EQUAL_UINT8(reference[i].report.weatherCount, results[i].report.weatherCount);
+        TEST_ASSERT_EQUAL(weatherIsGood(reference[i].report), weatherIsGood(results[i].report));
+      }
+    }
+  }
+}
+
+void test_replayed_reports_through_a_snapshot() {
+  std::vector<Parsed> results;
+  parseLines(lines, results, 2, 2, [](size_t, size_t) {});
+  std::vector<WeatherReport> reports;
+  for (size_t i = 0; i < results.size(); i++) {
+    if (!results[i].error) {
+      reports.push_back(results[i].report);
+    }
+  }
+  TEST_ASSERT_EQUAL_size_t(5, reports.size());
+
+  uint8_t snapshot[weatherSnapshotHeaderSize + 5 * weatherSnapshotRecordSize];
+  TEST_ASSERT_EQUAL_size_t(sizeof(snapshot), writeWeatherSnapshot(&reports[0], uint16_t(reports.size()), snapshot, sizeof(snapshot)));
+  WeatherSnapshotView view(snapshot, sizeof(snapshot));
+  TEST_ASSERT_EQUAL(SNAPSHOT_OK, view.check());
+  TEST_ASSERT_EQUAL_UINT16(reports.size(), view.count());
+  for (uint16_t i = 0; i < view.count(); i++) {
+    WeatherReport loaded = view.get(i);
+    TEST_ASSERT_EQUAL_UINT32(reports[i].dt, loaded.dt);
+    TEST_ASSERT_EQUAL_FLOAT(reports[i].wind.speed, loaded.wind.speed);
+    TEST_ASSERT_EQUAL_UINT8(reports[i].weatherCount, loaded.weatherCount);
+    for (uint8_t c = 0; c < loaded.storedWeatherCount(); c++) {
+      TEST_ASSERT_EQUAL_INT(reports[i].weather[c].id, loaded.weather[c].id);
+    }
+    TEST_ASSERT_EQUAL(weatherIsGood(reports[i]), weatherIsGood(loaded)); // INFO: the same decision after a reboot
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_split_lines);
+  RUN_TEST(test_replay_archive);
+  RUN_TEST(test_threads_and_chunks_give_the_same_reports);
+  RUN_TEST(test_replayed_reports_through_a_snapshot);
+  return UNITY_END();
+}
@@ -0,0 +1,178 @@
+#define ARDUINOJSON_SHORTEST_FLOATS 1
+
+#include <ArduinoJson.h>
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * ARDUINOJSON_SHORTEST_FLOATS: what serializeJson() writes must read back as
+ * the same float, with as few digits as printf() needs.
+ * */
+
+using ARDUINOJSON_NAMESPACE::ShortestFloat;
+using ARDUINOJSON_NAMESPACE::TextFormatter;
+using ARDUINOJSON_NAMESPACE::Writer;
+
+const double doubles[] = {
+  0.1, 0.2, 0.3, 1.0 / 3, 2.0 / 3, 3.14, 293.15, 1012, 100.25, 1.5e-7,
+  1e20, 1e21, 1e22, 1e23, 9007199254740991.0, 9007199254740992.0,
+  123456789012345680.0, 4.35, 0.000001, 1e-7,
+  5e-324,                   // smallest denormal
+  2.2250738585072009e-308,  // largest denormal
+  2.2250738585072014e-308,  // smallest normal
+  1.7976931348623157e308,   // largest
+  4.9406564584124654e-324 * 3, 8.41e21, 5.0e-310, 1.2345678901234567e-300
+};
+
+const float floats[] = {
+  0.1f, 0.2f, 0.3f, 1.0f / 3, 3.14f, 293.15f, 3.6f, 100.25f, 1.5e-7f,
+  16777216.0f, 16777217.0f, 1e10f, 3.4e38f, 7.038531e-26f,
+  1.4e-45f,        // smallest denormal
+  1.1754942e-38f,  // largest denormal
+  FLT_MIN, FLT_MAX, 8.589973e9f, 1.0e-5f
+};
+
+static std::string serializeFloat(float value) {
+  std::string output;
+  TextFormatter<Writer<std::string> > formatter((Writer<std::string>(output)));
+  formatter.writeFloat(value);
+  return output;
+}
+
+static std::string serializeDouble(double value) {
+  std::string output;
+  TextFormatter<Writer<std::string> > formatter((Writer<std::string>(output)));
+  formatter.writeFloat(value);
+  return output;
+}
+
+// The fewest significant digits that read back as value, found with printf()
+static int shortestLength(double value) {
+  char buffer[32];
+  for (int digits = 1; digits < 17; digits++) {
+    sprintf(buffer, "%.*e", digits - 1, value);
+    if (strtod(buffer, 0) == value) return digits;
+  }
+  return 17;
+}
+
+static int shortestLength(float value) {
+  char buffer[32];
+  for (int digits = 1; digits < 9; digits++) {
+    sprintf(buffer, "%.*e", digits - 1, value);
+    if (strtof(buffer, 0) == value) return digits;
+  }
+  return 9;
+}
+
+// xorshift64, so that every run checks the same values
+static uint64_t nextRandom() {
+  static uint64_t state = 88172645463325252ULL;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+template <typename T>
+static void checkDigits(T value) {
+  ShortestFloat<T> shortest(value);
+  TEST_ASSERT_EQUAL_INT(shortestLength(value), shortest.length);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_known_outputs() {
+  TEST_ASSERT_EQUAL_STRING("0.1", serializeDouble(0.1).c_str());
+  TEST_ASSERT_EQUAL_STRING("293.15", serializeDouble(293.15).c_str());
+  TEST_ASSERT_EQUAL_STRING("-1.5e-7", serializeDouble(-1.5e-7).c_str());
+  TEST_ASSERT_EQUAL_STRING("5e-324", serializeDouble(5e-324).c_str());
+  TEST_ASSERT_EQUAL_STRING("0", serializeDouble(0.0).c_str());
+  TEST_ASSERT_EQUAL_STRING("1e23", serializeDouble(1e23).c_str());  // a tie
+  TEST_ASSERT_EQUAL_STRING("3.6", serializeFloat(3.6f).c_str());
+  TEST_ASSERT_EQUAL_STRING("293.15", serializeFloat(293.15f).c_str());
+}
+
+void test_double_edge_cases() {
+  for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+    std::string text = serializeDouble(doubles[i]);
+    TEST_ASSERT_TRUE_MESSAGE(strtod(text.c_str(), 0) == doubles[i], text.c_str());
+    text = serializeDouble(-doubles[i]);
+    TEST_ASSERT_TRUE_MESSAGE(strtod(text.c_str(), 0) == -doubles[i], text.c_str());
+    checkDigits(doubles[i]);
+  }
+}
+
+void test_float_edge_cases() {
+  for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    std::string text = serializeFloat(floats[i]);
+    TEST_ASSERT_TRUE_MESSAGE(strtof(text.c_str(), 0) == floats[i], text.c_str());
+    checkDigits(floats[i]);
+  }
+}
+
+/**
+ * Through the document, the way the firmware uses it: JsonFloat is a double,
+ * or a float with ARDUINOJSON_USE_DOUBLE=0
+ * */
+void test_document_round_trip() {
+  StaticJsonDocument<64> doc;
+  for (size_t i = 0; i < sizeof(floats) / sizeof(floats[0]); i++) {
+    JsonFloat value = floats[i];
+    doc.set(value);
+    std::string text;
+    serializeJson(doc, text);
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, text).c_str());
+    TEST_ASSERT_TRUE_MESSAGE(doc.as<JsonFloat>() == value, text.c_str());
+  }
+  for (size_t i = 0; i < sizeof(doubles) / sizeof(doubles[0]); i++) {
+    JsonFloat value = JsonFloat(doubles[i]);
+    if (value == 0 || isinf(value)) continue;  // out of the range of a float
+    doc.set(value);
+    std::string text;
+    serializeJson(doc, text);
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, text).c_str());
+    TEST_ASSERT_TRUE_MESSAGE(doc.as<JsonFloat>() == value, text.c_str());
+  }
+}
+
+void test_random_doubles() {
+  for (int i = 0; i < 100000; i++) {
+    uint64_t bits = nextRandom() & 0x7FFFFFFFFFFFFFFFULL;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value == 0 || isinf(value) || isnan(value)) continue;
+    std::string text = serializeDouble(value);
+    TEST_ASSERT_TRUE_MESSAGE(strtod(text.c_str(), 0) == value, text.c_str());
+    checkDigits(value);
+  }
+}
+
+void test_random_floats() {
+  for (int i = 0; i < 100000; i++) {
+    uint32_t bits = uint32_t(nextRandom()) & 0x7FFFFFFF;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    if (value == 0 || isinf(value) || isnan(value)) continue;
+    std::string text = serializeFloat(value);
+    TEST_ASSERT_TRUE_MESSAGE(strtof(text.c_str(), 0) == value, text.c_str());
+    checkDigits(value);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_known_outputs);
+  RUN_TEST(test_double_edge_cases);
+  RUN_TEST(test_float_edge_cases);
+  RUN_TEST(test_document_round_trip);
+  RUN_TEST(test_random_doubles);
+  RUN_TEST(test_random_floats);
+  return UNITY_END();
+}
@@ -0,0 +1,143 @@
+#include <ArduinoJson.h>
+#include <WeatherContentType.h>
+#include <sstream>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * sniffJson(): the full check on strings and buffers, the first-character check on streams, and the Content-Type
+ * check the firmware runs with it.
+ * */
+
+const char* weatherAnswer = "{\"coord\": {\"lon\": 8.68, \"lat\": 50.11}, "
+  "\"weather\": [{\"id\": 500, \"main\": \"Rain\", \"description\": \"light rain\", \"icon\": \"10d\"}], "
+  "\"wind\": {\"speed\": 3.6, \"deg\": 240}, \"dt\": 1600000000, \"name\": \"Frankfurt am Main\", \"cod\": 200}";
+
+// what a FRITZ!Box answers while the Internet access is blocked, shortened
+const char* portalPage = "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>FRITZ!Box</title></head>"
+  "<body><h1>Internetzugang gesperrt</h1><p>{\"not\": \"json\"}</p></body></html>";
+
+struct Case {
+  const char* input;
+  const char* buffer;  // the result for strings and buffers
+  const char* stream;  // the result for streams
+};
+
+const Case cases[] = {
+  // accepted by both
+  {"[1,2,3]", "Ok", "Ok"},
+  {"  \r\n\t{\"a\":1}", "Ok", "Ok"},
+  {"\"text\"", "Ok", "Ok"},
+  {"-42", "Ok", "Ok"},
+  {"true", "Ok", "Ok"},
+  {"null", "Ok", "Ok"},
+  {"{\"a\":\"}]\"}", "Ok", "Ok"},           // brackets in a string
+  {"{\"a\":\"\\\"}\"}", "Ok", "Ok"},        // escaped quote
+  {"{\"a\":[{},[[]]]} trailing", "Ok", "Ok"}, // only the first value counts
+  // rejected by both
+  {"", "IncompleteInput", "IncompleteInput"},
+  {"   ", "IncompleteInput", "IncompleteInput"},
+  {"<html></html>", "InvalidInput", "InvalidInput"},
+  {"]", "InvalidInput", "InvalidInput"},
+  {"}", "InvalidInput", "InvalidInput"},
+  {"xyz", "InvalidInput", "InvalidInput"},
+  {"HTTP/1.1 200 OK", "InvalidInput", "InvalidInput"},
+  // only the buffers look past the first character
+  {"{\"a\":1]", "InvalidInput", "Ok"},
+  {"[1,{\"b\":2]}", "InvalidInput", "Ok"},
+  {"{\"a\":[1,2", "IncompleteInput", "Ok"},
+  {"[\"unterminated", "IncompleteInput", "Ok"},
+  {"{\"a\":\"\\", "IncompleteInput", "Ok"},
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_strings_and_buffers() {
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    const Case& c = cases[i];
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(c.buffer, sniffJson(c.input).c_str(), c.input);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(c.buffer, sniffJson(c.input, strlen(c.input)).c_str(), c.input);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(c.buffer, sniffJson(std::string(c.input)).c_str(), c.input);
+    std::string writable = c.input;
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(c.buffer, sniffJson(&writable[0]).c_str(), c.input);
+    TEST_ASSERT_EQUAL_STRING(c.input, writable.c_str()); // INFO: unlike deserializeJson(), it doesn't write in the input
+  }
+}
+
+void test_streams() {
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    const Case& c = cases[i];
+    std::istringstream stream(c.input);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(c.stream, sniffJson(stream).c_str(), c.input);
+  }
+}
+
+void test_stream_keeps_the_value() {
+  std::istringstream stream("  \n{\"dt\":1600000000}");
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(stream).c_str());
+  TEST_ASSERT_EQUAL_INT('{', stream.peek()); // INFO: only the spaces were consumed
+  StaticJsonDocument<64> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, stream).c_str());
+  TEST_ASSERT_EQUAL_UINT32(1600000000, doc["dt"].as<uint32_t>());
+}
+
+void test_unbalanced_stream_fails_later() {
+  std::istringstream stream("{\"a\":1]");
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(stream).c_str());
+  StaticJsonDocument<64> doc;
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(doc, stream).c_str());
+}
+
+void test_portal_page() {
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", sniffJson(portalPage).c_str());
+  std::istringstream stream(portalPage);
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", sniffJson(stream).c_str());
+}
+
+void test_weather_answer() {
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(weatherAnswer).c_str());
+  std::istringstream stream(weatherAnswer);
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(stream).c_str());
+  // every cut of the answer is incomplete for the buffers
+  std::string answer = weatherAnswer;
+  for (size_t size = 0; size < answer.size(); size++) {
+    TEST_ASSERT_EQUAL_STRING("IncompleteInput", sniffJson(answer.c_str(), size).c_str());
+  }
+}
+
+void test_nesting_limit() {
+  const char* deep = "[[[1]]]";
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(deep, DeserializationOption::NestingLimit(3)).c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep", sniffJson(deep, DeserializationOption::NestingLimit(2)).c_str());
+  TEST_ASSERT_EQUAL_STRING("TooDeep", sniffJson(deep, 7, DeserializationOption::NestingLimit(2)).c_str());
+  // INFO: streams stop before the first bracket
+  std::istringstream stream(deep);
+  TEST_ASSERT_EQUAL_STRING("Ok", sniffJson(stream).c_str());
+}
+
+void test_content_type() {
+  TEST_ASSERT_TRUE(weatherIsJsonContentType("application/json"));
+  TEST_ASSERT_TRUE(weatherIsJsonContentType("application/json; charset=utf-8"));
+  TEST_ASSERT_TRUE(weatherIsJsonContentType("Application/JSON"));
+  TEST_ASSERT_TRUE(weatherIsJsonContentType(""));
+  TEST_ASSERT_TRUE(weatherIsJsonContentType(NULL));
+  TEST_ASSERT_FALSE(weatherIsJsonContentType("text/html"));
+  TEST_ASSERT_FALSE(weatherIsJsonContentType("text/html; charset=utf-8"));
+  TEST_ASSERT_FALSE(weatherIsJsonContentType("application/jsonp"));
+  TEST_ASSERT_FALSE(weatherIsJsonContentType("application/js"));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_strings_and_buffers);
+  RUN_TEST(test_streams);
+  RUN_TEST(test_stream_keeps_the_value);
+  RUN_TEST(test_unbalanced_stream_fails_later);
+  RUN_TEST(test_portal_page);
+  RUN_TEST(test_weather_answer);
+  RUN_TEST(test_nesting_limit);
+  RUN_TEST(test_content_type);
+  return UNITY_END();
+}
@@ -0,0 +1,194 @@
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <sstream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+/**
+ * The string runs of the readers in RAM: a run of plain characters is copied, or skipped, at once, a word at a time in
+ * a bounded input, so the results must be those of a std::istream, which reads one character at a time, at every
+ * length, alignment and capacity.
+ * */
+
+/**
+ * Characters that end a run, or not: quotes, backslashes, escapes, UTF-8 and a byte that's never UTF-8
+ * */
+const char* pieces[] = {"a", "b", "light rain", "'", "\\\"", "\\\\", "\\n", "\\u00e9", "\\", "\xc3\xa9", "\xe2\x82\xac",
+                        "\xff", "\xc3", "01234567", "0123456789abcdef"};
+
+uint32_t seed = 1;
+
+uint32_t nextRandom() {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+std::string randomString() {
+  std::string s;
+  for (uint32_t n = nextRandom() % 12; n > 0; n--) {
+    s += pieces[nextRandom() % (sizeof(pieces) / sizeof(pieces[0]))];
+  }
+  return s;
+}
+
+std::string result(DeserializationError error, const JsonDocument& doc) {
+  std::string output = error.c_str();
+  output += " ";
+  serializeJson(doc, output);
+  return output;
+}
+
+/**
+ * The JSON, from an istream, then from every reader in RAM; the writable buffers start at every offset of a word. They
+ * don't copy the strings, so they need less memory: at a given capacity, they're compared with each other.
+ * */
+void checkReaders(const std::string& json, size_t capacity) {
+  DynamicJsonDocument doc(capacity);
+  std::istringstream input(json);
+  std::string expected = result(deserializeJson(doc, input), doc);
+
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), result(deserializeJson(doc, json), doc).c_str(), json.c_str());
+  if (json.find('\0') == std::string::npos) {
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), result(deserializeJson(doc, json.c_str()), doc).c_str(), json.c_str());
+  }
+  std::vector<char> exact(json.begin(), json.end()); // INFO: nothing after the input, for the sanitizers
+  if (!exact.empty()) {
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), result(deserializeJson(doc, (const char*)&exact[0], exact.size()), doc).c_str(),
+                                     json.c_str());
+  }
+  char buffer[2048 + sizeof(size_t)];
+  for (size_t offset = 0; offset < sizeof(size_t) && json.size() < 2048; offset++) {
+    char* writable = buffer + offset;
+    memcpy(writable, json.data(), json.size());
+    writable[json.size()] = '\0';
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), result(deserializeJson(doc, (const char*)writable, json.size()), doc).c_str(),
+                                     json.c_str());
+    std::string inPlace = result(deserializeJson(doc, writable, json.size()), doc);
+    if (capacity >= 4096) {
+      TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(), inPlace.c_str(), json.c_str());
+    }
+    if (json.find('\0') == std::string::npos) {
+      memcpy(writable, json.data(), json.size());
+      TEST_ASSERT_EQUAL_STRING_MESSAGE(inPlace.c_str(), result(deserializeJson(doc, writable), doc).c_str(), json.c_str());
+    }
+  }
+}
+
+void setUp() {
+  seed = 1;
+}
+
+void tearDown() {}
+
+void test_every_length() {
+  for (size_t n = 0; n < 300; n++) {
+    std::string plain(n, 'x');
+    checkReaders("[\"" + plain + "\",\"" + plain + "\\n" + plain + "\"]", 4096);
+    checkReaders("{\"" + plain + "\":'" + plain + "\"'}", 4096);
+    checkReaders("[\"" + plain, 4096); // INFO: IncompleteInput, the run reaches the end
+  }
+}
+
+void test_random_strings() {
+  for (int i = 0; i < 3000; i++) {
+    std::string json = "[\"" + randomString() + "\",{\"" + randomString() + "\":\"" + randomString() + "\"},'" +
+                       randomString() + "']";
+    checkReaders(json, 4096);
+    checkReaders(json.substr(0, nextRandom() % json.size()), 4096);
+  }
+}
+
+void test_null_characters() {
+  // INFO: a NUL ends the input, even in a bounded one
+  checkReaders(std::string("[\"abc\0def\"]", 11), 256);
+  checkReaders(std::string("[\"abcdefghijklmnop\0\"]", 21), 256);
+  checkReaders(std::string("{\"a\0b\":1}", 9), 256);
+}
+
+void test_every_capacity() {
+  // INFO: NoMemory must come at the same place, in the middle of a run or not
+  std::string json = "[\"a light rain, later a heavy rain\",\"mist\",{\"description\":\"scattered \\\"clouds\\\" all day long\"}]";
+  for (size_t capacity = 0; capacity < 320; capacity++) {
+    checkReaders(json, capacity);
+  }
+}
+
+void test_filter() {
+  // INFO: the skipped strings are scanned with the runs too
+  StaticJsonDocument<64> filter;
+  filter["keep"] = true;
+  for (int i = 0; i < 1000; i++) {
+    std::string json = "{\"skip\":\"" + randomString() + "\",\"keep\":\"" + randomString() + "\",\"" + randomString() +
+                       "\":['" + randomString() + "']}";
+    DynamicJsonDocument doc(1024);
+    std::istringstream input(json);
+    std::string expected = result(deserializeJson(doc, input, DeserializationOption::Filter(filter)), doc);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(),
+                                     result(deserializeJson(doc, json, DeserializationOption::Filter(filter)), doc).c_str(),
+                                     json.c_str());
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected.c_str(),
+                                     result(deserializeJson(doc, json.c_str(), DeserializationOption::Filter(filter)), doc).c_str(),
+                                     json.c_str());
+  }
+}
+
+void test_in_place() {
+  char input[] = "{\"description\":\"light \\\"rain\\\"\",\"icon\":\"10d\"}";
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, input).c_str());
+  TEST_ASSERT_EQUAL_STRING("light \"rain\"", doc["description"].as<const char*>());
+  TEST_ASSERT_EQUAL_STRING("10d", doc["icon"].as<const char*>());
+  const char* icon = doc["icon"];
+  // INFO: the strings stay in the input; compact slots copy every string
+  TEST_ASSERT_TRUE((icon > input && icon < input + sizeof(input)) || ARDUINOJSON_COMPACT_SLOTS);
+}
+
+void test_bound_struct() {
+  std::string json = "{\"dt\":1600000000,\"name\":\"" + std::string(500, 'x') + "\",\"weather\":[{\"id\":500,\"main\":\"" +
+                     "a long \\\"description\\\" to skip\"}],\"wind\":{\"speed\":3.5}}";
+  WeatherReport fromStream = WeatherReport();
+  std::istringstream input(json);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(fromStream, input).c_str());
+  WeatherReport fromString = WeatherReport();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(fromString, json).c_str());
+  TEST_ASSERT_EQUAL_MEMORY(&fromStream, &fromString, sizeof(WeatherReport));
+  TEST_ASSERT_EQUAL_INT(500, fromString.weather[0].id);
+}
+
+void test_msgpack() {
+  // INFO: str8, str16, bin8 and bin16, copied at once from RAM
+  DynamicJsonDocument doc(8192);
+  doc.add(std::string(31, 'a'));
+  doc.add(std::string(200, 'b'));
+  doc.add(std::string(3000, 'c'));
+  std::string msgPack;
+  serializeMsgPack(doc, msgPack);
+  msgPack[0] = char(0x95);
+  const uint8_t bins[] = {0xc4, 0x03, 1, 2, 3, 0xc5, 0x01, 0x00};
+  msgPack.append((const char*)bins, sizeof(bins));
+  msgPack.append(256, '\x07');
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, msgPack).c_str());
+  for (size_t capacity = 0; capacity < 3600; capacity += 7) {
+    DynamicJsonDocument fromStream(capacity);
+    std::istringstream input(msgPack);
+    std::string expected = result(deserializeMsgPack(fromStream, input), fromStream);
+    DynamicJsonDocument fromString(capacity);
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), result(deserializeMsgPack(fromString, msgPack), fromString).c_str());
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_every_length);
+  RUN_TEST(test_random_strings);
+  RUN_TEST(test_null_characters);
+  RUN_TEST(test_every_capacity);
+  RUN_TEST(test_filter);
+  RUN_TEST(test_in_place);
+  RUN_TEST(test_bound_struct);
+  RUN_TEST(test_msgpack);
+  return UNITY_END();
+}
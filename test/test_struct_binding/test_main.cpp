@@ -0,0 +1,177 @@
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * Bound structs: deserializeJson() into WeatherReport, and the serializers.
+ * */
+
+const char* weatherAnswer = "{\"coord\": {\"lon\": 8.68, \"lat\": 50.11}, "
+  "\"weather\": [{\"id\": 500, \"main\": \"Rain\", \"description\": \"light rain\", \"icon\": \"10d\"}, "
+  "{\"id\": 701, \"main\": \"Mist\", \"description\": \"mist\", \"icon\": \"50d\"}], "
+  "\"base\": \"stations\", \"main\": {\"temp\": 293.15, \"pressure\": 1012, \"humidity\": 82}, "
+  "\"visibility\": 10000, \"wind\": {\"speed\": 3.6, \"deg\": 240}, \"dt\": 1600000000, "
+  "\"sys\": {\"type\": 1, \"country\": \"DE\"}, \"timezone\": 7200, \"name\": \"Frankfurt am Main\", \"cod\": 200}";
+
+struct Sensor {
+  char name[8];
+  bool enabled;
+  int readings[3];
+  uint8_t readingCount;
+};
+JSON_BINDING(Sensor,
+  JSON_FIELD(Sensor, name),
+  JSON_FIELD(Sensor, enabled),
+  JSON_ARRAY_FIELD(Sensor, readings, readingCount))
+
+void setUp() {}
+void tearDown() {}
+
+void test_weather_answer() {
+  WeatherReport report = WeatherReport();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, weatherAnswer).c_str());
+  TEST_ASSERT_EQUAL_UINT(1600000000, report.dt);
+  TEST_ASSERT_TRUE(report.wind.speed == 3.6f);
+  TEST_ASSERT_EQUAL_UINT(2, report.weatherCount);
+  TEST_ASSERT_EQUAL_INT(500, report.weather[0].id);
+  TEST_ASSERT_EQUAL_INT(701, report.weather[1].id);
+}
+
+void test_more_conditions_than_the_array_holds() {
+  WeatherReport report = WeatherReport();
+  const char* json = "{\"weather\":[{\"id\":500},{\"id\":501},{\"id\":502},{\"id\":503},{\"id\":504,\"main\":\"x\"},[1,{}]],\"dt\":7}";
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, json).c_str());
+  TEST_ASSERT_EQUAL_UINT(6, report.weatherCount); // INFO: the skipped ones are counted too
+  TEST_ASSERT_EQUAL_UINT(4, report.storedWeatherCount());
+  TEST_ASSERT_EQUAL_INT(503, report.weather[3].id);
+  TEST_ASSERT_EQUAL_UINT(7, report.dt); // the members after the array are still read
+}
+
+void test_count_saturates() {
+  std::string json = "{\"readings\":[0";
+  for (int i = 1; i < 300; i++) {
+    json += ",0";
+  }
+  json += "]}";
+  Sensor sensor = Sensor();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(sensor, json).c_str());
+  TEST_ASSERT_EQUAL_UINT(255, sensor.readingCount); // INFO: still more than the 3 stored
+
+  char output[128];
+  serializeJson(sensor, output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("{\"name\":\"\",\"enabled\":false,\"readings\":[0,0,0]}", output);
+}
+
+void test_skipped_conditions_are_not_good_weather() {
+  WeatherReport report = WeatherReport();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, "{\"weather\":[{\"id\":800},{\"id\":801}]}").c_str());
+  TEST_ASSERT_TRUE(weatherIsGood(report));
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, "{\"weather\":[{\"id\":800},{\"id\":801},{\"id\":500}]}").c_str());
+  TEST_ASSERT_FALSE(weatherIsGood(report));
+  const char* json = "{\"weather\":[{\"id\":800},{\"id\":801},{\"id\":802},{\"id\":803},{\"id\":500}]}";
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(report, json).c_str());
+  TEST_ASSERT_FALSE(weatherIsGood(report)); // INFO: the rain isn't stored, but it must not turn the pump on
+}
+
+void test_skipped_elements_are_still_checked() {
+  WeatherReport report = WeatherReport();
+  const char* json = "{\"weather\":[{\"id\":1},{\"id\":2},{\"id\":3},{\"id\":4},{\"id\":5]}";
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(report, json).c_str());
+}
+
+void test_keywords() {
+  Sensor sensor = Sensor();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(sensor, "{\"enabled\":true}").c_str());
+  TEST_ASSERT_TRUE(sensor.enabled);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(sensor, "{\"enabled\":false,\"name\":null}").c_str());
+  TEST_ASSERT_FALSE(sensor.enabled);
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(sensor, "{\"enabled\":trux}").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(sensor, "{\"enabled\":fals3}").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(sensor, "{\"enabled\":nulll}").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidInput", deserializeJson(sensor, "{\"enabled\":tru}").c_str());
+  TEST_ASSERT_EQUAL_STRING("IncompleteInput", deserializeJson(sensor, "{\"enabled\":tru").c_str());
+}
+
+void test_keywords_like_a_document() {
+  // INFO: both deserializers share JsonTokenizer, so they must agree
+  const char* inputs[] = {"{\"enabled\":true}", "{\"enabled\":tru3}", "{\"enabled\":trux}", "{\"enabled\":nul}",
+                          "{\"enabled\":truee}", "{\"enabled\":fa", "{\"enabled\":12x}", "{\"enabled\":-}"};
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++) {
+    Sensor sensor = Sensor();
+    StaticJsonDocument<128> doc;
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(deserializeJson(doc, inputs[i]).c_str(), deserializeJson(sensor, inputs[i]).c_str(),
+                                     inputs[i]);
+  }
+}
+
+void test_long_string_gives_no_memory() {
+  Sensor sensor = Sensor();
+  TEST_ASSERT_EQUAL_STRING("NoMemory", deserializeJson(sensor, "{\"name\":\"too long name\"}").c_str());
+}
+
+void test_serialize() {
+  Sensor sensor = {"s1", true, {1, 2, 0}, 2};
+  char output[128];
+  TEST_ASSERT_EQUAL_UINT(45, serializeJson(sensor, output, sizeof(output)));
+  TEST_ASSERT_EQUAL_STRING("{\"name\":\"s1\",\"enabled\":true,\"readings\":[1,2]}", output);
+  TEST_ASSERT_EQUAL_UINT(45, measureJson(sensor));
+}
+
+void test_serialize_pretty() {
+  Sensor sensor = {"s1", false, {1, 2, 0}, 2};
+  char output[128];
+  size_t n = serializeJsonPretty(sensor, output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("{\r\n  \"name\": \"s1\",\r\n  \"enabled\": false,\r\n  \"readings\": [\r\n    1,\r\n    2\r\n  ]\r\n}", output);
+  TEST_ASSERT_EQUAL_UINT(strlen(output), n);
+
+  // same layout as a JsonDocument
+  StaticJsonDocument<256> doc;
+  deserializeJson(doc, static_cast<const char*>(output)); // INFO: a char* would be modified in place
+  char fromDocument[128];
+  serializeJsonPretty(doc, fromDocument, sizeof(fromDocument));
+  TEST_ASSERT_EQUAL_STRING(fromDocument, output);
+
+  sensor.readingCount = 0;
+  serializeJsonPretty(sensor, output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("{\r\n  \"name\": \"s1\",\r\n  \"enabled\": false,\r\n  \"readings\": []\r\n}", output);
+}
+
+void test_nested_struct_pretty() {
+  WeatherReport report = WeatherReport();
+  report.dt = 1;
+  report.wind.speed = 2;
+  report.weatherCount = 1;
+  report.weather[0].id = 800;
+  char output[160];
+  serializeJsonPretty(report, output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("{\r\n  \"dt\": 1,\r\n  \"wind\": {\r\n    \"speed\": 2\r\n  },\r\n  \"weather\": [\r\n    {\r\n      \"id\": 800\r\n    }\r\n  ]\r\n}", output);
+}
+
+void test_round_trip() {
+  WeatherReport report = WeatherReport();
+  deserializeJson(report, weatherAnswer);
+  char output[128];
+  serializeJson(report, output, sizeof(output));
+  WeatherReport copy = WeatherReport();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(copy, output).c_str());
+  TEST_ASSERT_EQUAL_MEMORY(&report, &copy, sizeof(report));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_weather_answer);
+  RUN_TEST(test_more_conditions_than_the_array_holds);
+  RUN_TEST(test_count_saturates);
+  RUN_TEST(test_skipped_conditions_are_not_good_weather);
+  RUN_TEST(test_skipped_elements_are_still_checked);
+  RUN_TEST(test_keywords);
+  RUN_TEST(test_keywords_like_a_document);
+  RUN_TEST(test_long_string_gives_no_memory);
+  RUN_TEST(test_serialize);
+  RUN_TEST(test_serialize_pretty);
+  RUN_TEST(test_nested_struct_pretty);
+  RUN_TEST(test_round_trip);
+  return UNITY_END();
+}
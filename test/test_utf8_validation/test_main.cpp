@@ -0,0 +1,185 @@
+#define ARDUINOJSON_VALIDATE_UTF8 1
+
+#include <ArduinoJson.h>
+#include <sstream>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * ARDUINOJSON_VALIDATE_UTF8: the validator, and each way a string reaches it (char buffers, std::string, streams,
+ * bound structs, MsgPack).
+ * */
+
+using ARDUINOJSON_NAMESPACE::Utf8::Validator;
+using ARDUINOJSON_NAMESPACE::Utf8::isValid;
+
+const char* validSequences[] = {
+  "plain ASCII",
+  "\xC2\x80",              // U+0080, the first two-byte
+  "\xC3\xA9t\xC3\xA9",     // "été"
+  "\xDF\xBF",              // U+07FF
+  "\xE0\xA0\x80",          // U+0800, the first three-byte
+  "\xE2\x82\xAC",          // euro sign
+  "\xED\x9F\xBF",          // U+D7FF, just below the surrogates
+  "\xEE\x80\x80",          // U+E000, just above the surrogates
+  "\xEF\xBF\xBF",          // U+FFFF
+  "\xF0\x90\x80\x80",      // U+10000, the first four-byte
+  "\xF0\x9F\x8C\xA7",      // cloud with rain
+  "\xF4\x8F\xBF\xBF",      // U+10FFFF, the last code point
+};
+
+const char* invalidSequences[] = {
+  // overlong forms
+  "\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xF0\x80\x80\x80", "\xF0\x8F\xBF\xBF",
+  // surrogates
+  "\xED\xA0\x80", "\xED\xAD\xBF", "\xED\xB0\x80", "\xED\xBF\xBF",
+  // above U+10FFFF
+  "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xF7\xBF\xBF\xBF", "\xFE", "\xFF",
+  // continuation bytes without a lead byte
+  "\x80", "a\xBF",
+  // a sequence cut by the next character
+  "\xC3" "a", "\xE2\x82" "a", "\xF0\x9F\x8C" "a",
+};
+
+// a multi-byte sequence cut at the end of the string
+const char* truncatedSequences[] = {
+  "\xC3", "\xE2", "\xE2\x82", "\xF0", "\xF0\x9F", "\xF0\x9F\x8C", "caf\xC3",
+};
+
+#define COUNT(array) (sizeof(array) / sizeof(array[0]))
+
+std::string jsonString(const char* content) {
+  return std::string("{\"name\":\"") + content + "\"}";
+}
+
+struct Station {
+  char name[24];
+};
+JSON_BINDING(Station, JSON_FIELD(Station, name))
+
+void setUp() {}
+void tearDown() {}
+
+void test_validator() {
+  for (size_t i = 0; i < COUNT(validSequences); i++) {
+    TEST_ASSERT_TRUE_MESSAGE(isValid(validSequences[i], strlen(validSequences[i])), validSequences[i]);
+  }
+  for (size_t i = 0; i < COUNT(invalidSequences); i++) {
+    TEST_ASSERT_FALSE(isValid(invalidSequences[i], strlen(invalidSequences[i])));
+  }
+  for (size_t i = 0; i < COUNT(truncatedSequences); i++) {
+    TEST_ASSERT_FALSE(isValid(truncatedSequences[i], strlen(truncatedSequences[i])));
+  }
+}
+
+/**
+ * The stream readers feed the validator one byte at a time, the buffers a run at a time: both must agree
+ * */
+void test_validator_in_pieces() {
+  for (size_t i = 0; i < COUNT(invalidSequences); i++) {
+    const char* s = invalidSequences[i];
+    size_t n = strlen(s);
+    for (size_t split = 0; split <= n; split++) {
+      Validator validator;
+      bool ok = validator.append(s, split) && validator.append(s + split, n - split);
+      TEST_ASSERT_FALSE(ok);
+    }
+    Validator bytes;
+    bool ok = true;
+    for (size_t j = 0; j < n && ok; j++) ok = bytes.append(s[j]);
+    TEST_ASSERT_FALSE(ok);
+  }
+  for (size_t i = 0; i < COUNT(validSequences); i++) {
+    const char* s = validSequences[i];
+    size_t n = strlen(s);
+    for (size_t split = 0; split <= n; split++) {
+      Validator validator;
+      TEST_ASSERT_TRUE(validator.append(s, split));
+      TEST_ASSERT_TRUE(validator.append(s + split, n - split));
+      TEST_ASSERT_TRUE(validator.complete());
+    }
+  }
+  Validator truncated;
+  TEST_ASSERT_TRUE(truncated.append("\xF0\x9F", 2));
+  TEST_ASSERT_FALSE(truncated.complete());
+}
+
+void test_deserialize_json() {
+  StaticJsonDocument<256> doc;
+  for (size_t i = 0; i < COUNT(validSequences); i++) {
+    std::string json = jsonString(validSequences[i]);
+    TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(doc, json).c_str());
+    TEST_ASSERT_EQUAL_STRING(validSequences[i], doc["name"]);
+  }
+
+  const char** sets[] = {invalidSequences, truncatedSequences};
+  size_t counts[] = {COUNT(invalidSequences), COUNT(truncatedSequences)};
+  for (size_t set = 0; set < 2; set++) {
+    for (size_t i = 0; i < counts[set]; i++) {
+      std::string json = jsonString(sets[set][i]);
+      // const char*, the bounded reader, std::string, std::istream, and char* parsed in place
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, json.c_str()).c_str());
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, json.c_str(), json.size()).c_str());
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, json).c_str());
+      std::istringstream stream(json);
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, stream).c_str());
+      std::string writable = json;
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, &writable[0]).c_str());
+    }
+  }
+}
+
+void test_invalid_key() {
+  StaticJsonDocument<256> doc;
+  TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, "{\"\xED\xA0\x80\":1}").c_str());
+  TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(doc, "{\"\xC3\":1}").c_str());
+}
+
+void test_truncated_at_end_of_input() {
+  StaticJsonDocument<256> doc;
+  // the input stops in the middle of the string, so more could come
+  TEST_ASSERT_EQUAL_STRING("IncompleteInput", deserializeJson(doc, "[\"caf\xC3").c_str());
+}
+
+void test_bound_struct() {
+  Station station = Station();
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeJson(station, jsonString("Z\xC3\xBCrich")).c_str());
+  TEST_ASSERT_EQUAL_STRING("Z\xC3\xBCrich", station.name);
+  for (size_t i = 0; i < COUNT(invalidSequences); i++) {
+    TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(station, jsonString(invalidSequences[i])).c_str());
+  }
+  for (size_t i = 0; i < COUNT(truncatedSequences); i++) {
+    TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeJson(station, jsonString(truncatedSequences[i])).c_str());
+  }
+}
+
+void test_deserialize_msgpack() {
+  StaticJsonDocument<256> doc;
+  const char** sets[] = {invalidSequences, truncatedSequences};
+  size_t counts[] = {COUNT(invalidSequences), COUNT(truncatedSequences)};
+  for (size_t set = 0; set < 2; set++) {
+    for (size_t i = 0; i < counts[set]; i++) {
+      std::string msgPack(1, char(0xA0 + strlen(sets[set][i]))); // fixstr
+      msgPack += sets[set][i];
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeMsgPack(doc, msgPack).c_str());
+      std::string writable = msgPack;
+      TEST_ASSERT_EQUAL_STRING("InvalidUtf8", deserializeMsgPack(doc, &writable[0], writable.size()).c_str());
+    }
+  }
+  std::string valid("\xA5\xE2\x82\xAC" "10", 6);
+  TEST_ASSERT_EQUAL_STRING("Ok", deserializeMsgPack(doc, valid).c_str());
+  TEST_ASSERT_EQUAL_STRING("\xE2\x82\xAC" "10", doc.as<const char*>());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_validator);
+  RUN_TEST(test_validator_in_pieces);
+  RUN_TEST(test_deserialize_json);
+  RUN_TEST(test_invalid_key);
+  RUN_TEST(test_truncated_at_end_of_input);
+  RUN_TEST(test_bound_struct);
+  RUN_TEST(test_deserialize_msgpack);
+  return UNITY_END();
+}
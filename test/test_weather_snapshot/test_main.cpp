@@ -0,0 +1,167 @@
+#include <WeatherSnapshot.h>
+#include <string.h>
+#include <unity.h>
+
+/**
+ * WeatherSnapshot.h: the reports must come back as they were written, and the view must refuse what isn't a complete
+ * snapshot of a version it knows.
+ * */
+
+const uint16_t recordCount = 40;
+
+WeatherReport reports[recordCount];
+uint8_t snapshot[weatherSnapshotHeaderSize + recordCount * weatherSnapshotRecordSize];
+
+/**
+ * Replaces the CRC after a test modified the header or the records on purpose
+ * */
+void resealSnapshot(uint8_t* data, size_t recordsSize) {
+  uint32_t crc = weatherSnapshotCrc(0, data, 12);
+  crc = weatherSnapshotCrc(crc, data + weatherSnapshotHeaderSize, recordsSize);
+  weatherSnapshotEncode32(data + 12, crc);
+}
+
+void setUp() {
+  for (uint16_t i = 0; i < recordCount; i++) {
+    WeatherReport report = WeatherReport();
+    report.dt = 1600000000UL + i * 3600UL;
+    report.wind.speed = 0.25f * i;
+    report.weatherCount = uint8_t(i % 7); // INFO: 0 to 6 conditions, the ones after the 4th aren't stored
+    for (uint8_t c = 0; c < report.storedWeatherCount(); c++) {
+      report.weather[c].id = c == 1 ? -1 : 200 + i + c;
+    }
+    reports[i] = report;
+  }
+  TEST_ASSERT_EQUAL_size_t(sizeof(snapshot), writeWeatherSnapshot(reports, recordCount, snapshot, sizeof(snapshot)));
+}
+
+void tearDown() {}
+
+void test_round_trip() {
+  WeatherSnapshotView view(snapshot, sizeof(snapshot));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_OK, view.check());
+  TEST_ASSERT_EQUAL_UINT(recordCount, view.count());
+  for (uint16_t i = 0; i < recordCount; i++) {
+    WeatherReport report = view.get(i);
+    TEST_ASSERT_EQUAL_MEMORY(&reports[i], &report, sizeof(report));
+  }
+}
+
+void test_layout() {
+  TEST_ASSERT_EQUAL_MEMORY("WXSN", snapshot, 4);
+  const uint8_t fields[] = {1, 0, weatherSnapshotRecordSize, 0, recordCount, 0, 0, 0};
+  TEST_ASSERT_EQUAL_MEMORY(fields, snapshot + 4, sizeof(fields));
+  // the second record: dt = 1600003600 = 0x5F5E1E10, little-endian
+  const uint8_t dt[] = {0x10, 0x1E, 0x5E, 0x5F};
+  TEST_ASSERT_EQUAL_MEMORY(dt, snapshot + weatherSnapshotHeaderSize + weatherSnapshotRecordSize, sizeof(dt));
+}
+
+void test_crc_is_ieee() {
+  const char* check = "123456789";
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926, weatherSnapshotCrc(0, (const uint8_t*)check, strlen(check)));
+  // in two calls, as the header and the records
+  uint32_t crc = weatherSnapshotCrc(0, (const uint8_t*)check, 4);
+  TEST_ASSERT_EQUAL_UINT32(0xCBF43926, weatherSnapshotCrc(crc, (const uint8_t*)check + 4, 5));
+}
+
+void test_buffer_too_small() {
+  uint8_t small[weatherSnapshotHeaderSize + weatherSnapshotRecordSize];
+  TEST_ASSERT_EQUAL_size_t(0, writeWeatherSnapshot(reports, 2, small, sizeof(small)));
+  TEST_ASSERT_EQUAL_size_t(sizeof(small), writeWeatherSnapshot(reports, 1, small, sizeof(small)));
+}
+
+void test_empty_snapshot() {
+  uint8_t empty[weatherSnapshotHeaderSize];
+  TEST_ASSERT_EQUAL_size_t(sizeof(empty), writeWeatherSnapshot(reports, 0, empty, sizeof(empty)));
+  WeatherSnapshotView view(empty, sizeof(empty));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_OK, view.check());
+  TEST_ASSERT_EQUAL_UINT(0, view.count());
+}
+
+void test_truncated() {
+  for (size_t size = 0; size < sizeof(snapshot); size++) {
+    WeatherSnapshotView view(snapshot, size);
+    TEST_ASSERT_EQUAL_INT(SNAPSHOT_TRUNCATED, view.check());
+    TEST_ASSERT_EQUAL_UINT(0, view.count());
+  }
+}
+
+void test_not_a_snapshot() {
+  const char* json = "{\"dt\":1600000000,\"wind\":{\"speed\":3.6}}";
+  WeatherSnapshotView view((const uint8_t*)json, strlen(json));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_NOT_A_SNAPSHOT, view.check());
+}
+
+void test_newer_version() {
+  weatherSnapshotEncode16(snapshot + 4, weatherSnapshotVersion + 1);
+  resealSnapshot(snapshot, sizeof(snapshot) - weatherSnapshotHeaderSize);
+  WeatherSnapshotView view(snapshot, sizeof(snapshot));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_UNSUPPORTED_VERSION, view.check());
+}
+
+void test_every_flipped_bit() {
+  for (size_t offset = 4; offset < sizeof(snapshot); offset++) {
+    if (offset == 4 || offset == 5) continue; // INFO: the version, checked before the CRC
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      snapshot[offset] ^= uint8_t(1 << bit);
+      WeatherSnapshotView view(snapshot, sizeof(snapshot));
+      TEST_ASSERT_TRUE(view.check() != SNAPSHOT_OK);
+      snapshot[offset] ^= uint8_t(1 << bit);
+    }
+  }
+}
+
+void test_larger_records() {
+  // a later writer appended 3 bytes to every record
+  const uint16_t recordSize = weatherSnapshotRecordSize + 3;
+  static uint8_t wider[weatherSnapshotHeaderSize + recordCount * recordSize];
+  memcpy(wider, snapshot, weatherSnapshotHeaderSize);
+  weatherSnapshotEncode16(wider + 6, recordSize);
+  for (uint16_t i = 0; i < recordCount; i++) {
+    uint8_t* record = wider + weatherSnapshotHeaderSize + i * recordSize;
+    memcpy(record, snapshot + weatherSnapshotHeaderSize + i * weatherSnapshotRecordSize, weatherSnapshotRecordSize);
+    memset(record + weatherSnapshotRecordSize, 0xAB, 3);
+  }
+  resealSnapshot(wider, sizeof(wider) - weatherSnapshotHeaderSize);
+
+  WeatherSnapshotView view(wider, sizeof(wider));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_OK, view.check());
+  for (uint16_t i = 0; i < recordCount; i++) {
+    WeatherReport report = view.get(i);
+    TEST_ASSERT_EQUAL_MEMORY(&reports[i], &report, sizeof(report));
+  }
+}
+
+void test_smaller_records() {
+  weatherSnapshotEncode16(snapshot + 6, weatherSnapshotRecordSize - 1);
+  resealSnapshot(snapshot, sizeof(snapshot) - weatherSnapshotHeaderSize);
+  WeatherSnapshotView view(snapshot, sizeof(snapshot));
+  TEST_ASSERT_EQUAL_INT(SNAPSHOT_CORRUPTED, view.check());
+}
+
+void test_get_out_of_range() {
+  WeatherSnapshotView view(snapshot, sizeof(snapshot));
+  WeatherReport empty = WeatherReport();
+  WeatherReport report = view.get(0); // INFO: before check()
+  TEST_ASSERT_EQUAL_MEMORY(&empty, &report, sizeof(report));
+  view.check();
+  report = view.get(recordCount);
+  TEST_ASSERT_EQUAL_MEMORY(&empty, &report, sizeof(report));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_layout);
+  RUN_TEST(test_crc_is_ieee);
+  RUN_TEST(test_buffer_too_small);
+  RUN_TEST(test_empty_snapshot);
+  RUN_TEST(test_truncated);
+  RUN_TEST(test_not_a_snapshot);
+  RUN_TEST(test_newer_version);
+  RUN_TEST(test_every_flipped_bit);
+  RUN_TEST(test_larger_records);
+  RUN_TEST(test_smaller_records);
+  RUN_TEST(test_get_out_of_range);
+  return UNITY_END();
+}
@@ -0,0 +1,121 @@
+/**
+ * Compares the two ways of reading the weather website's answer: the JsonDocument the firmware used before,
+ * read through key lookups, and the WeatherReport bound struct.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -I lib/Weather [-DARDUINOJSON_...] tools/bench/binding.cpp -o bench-binding
+ *   ./bench-binding [--rounds 7] [--iterations 20000] tools/bench/weather-answer.json
+ *
+ * The times are the best of the rounds, per answer. RAM is what each way keeps while the answer is in use.
+ * */
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+struct Options {
+  unsigned rounds = 7;
+  unsigned iterations = 20000;
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--iterations" && hasValue) {
+      options.iterations = strtoul(argv[++i], NULL, 10);
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0 && options.iterations > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of decode()
+ * */
+template <typename TDecode>
+double measure(const Options& options, TDecode decode) {
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < options.iterations; i++) {
+      decode();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / options.iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile long sink; // INFO: keeps the compiler from dropping the decoding
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--iterations N] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+
+  DynamicJsonDocument weatherDoc(15360); // as the firmware had it
+  double documentNs = measure(options, [&]() {
+    deserializeJson(weatherDoc, answer);
+    float wind = weatherDoc["wind"]["speed"];
+    unsigned long unixtime = weatherDoc["dt"];
+    long ids = 0;
+    for (JsonVariant state : weatherDoc["weather"].as<JsonArray>()) {
+      ids += state["id"].as<int>();
+    }
+    sink = long(wind) + long(unixtime) + ids;
+  });
+
+  WeatherReport report;
+  double structNs = measure(options, [&]() {
+    report = WeatherReport();
+    deserializeJson(report, answer);
+    long ids = 0;
+    for (uint8_t index = 0; index < report.storedWeatherCount(); index++) {
+      ids += report.weather[index].id;
+    }
+    sink = long(report.wind.speed) + long(report.dt) + ids;
+  });
+
+  DeserializationError error = deserializeJson(weatherDoc, answer);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", options.answer.c_str(), error.c_str());
+    return 1;
+  }
+  printf("%u bytes, best of %u rounds of %u answers\n\n", unsigned(answer.size()), options.rounds, options.iterations);
+  printf("%-28s %10s %14s %14s\n", "", "ns/answer", "RAM used", "RAM reserved");
+  printf("%-28s %10.0f %14u %14u\n", "JsonDocument + lookups", documentNs, unsigned(weatherDoc.memoryUsage()), unsigned(weatherDoc.capacity()));
+  printf("%-28s %10.0f %14u %14u\n", "WeatherReport (bound)", structNs, unsigned(sizeof(report)), unsigned(sizeof(report)));
+  printf("\nspeedup: %.2fx\n", documentNs / structNs);
+  return 0;
+}
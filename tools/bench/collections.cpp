@@ -0,0 +1,143 @@
+/**
+ * Times JsonArray::size() and serializeMsgPack() on wide arrays, which is where counting the elements by walking
+ * the slots showed. The "walk" column iterates the array, which is what size() cost for every array before packed
+ * collections were counted in O(1); the fragmented array, whose elements are interleaved with another one's, still
+ * pays it.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/collections.cpp -o bench-collections
+ *   ./bench-collections [--rounds 10] [--elements 1000,10000,100000]
+ *
+ * The times are the best of the rounds, per call.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> elements = {1000, 10000, 100000};
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--elements" && hasValue) {
+      options.elements.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.elements.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+  for (size_t n : options.elements) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return options.rounds > 0 && !options.elements.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the calls
+
+void printRow(const Options& options, const char* name, JsonArray array) {
+  size_t n = array.size();
+  std::vector<char> msgPack(measureMsgPack(array));
+
+  double sizeNs = measure(options, [&]() { sink = array.size(); });
+  double walkNs = measure(options, [&]() {
+    size_t count = 0;
+    for (JsonArray::iterator it = array.begin(); it != array.end(); ++it) {
+      count++;
+    }
+    sink = count;
+  });
+  double msgPackNs = measure(options, [&]() {
+    sink = serializeMsgPack(array, msgPack.data(), msgPack.size());
+  });
+  printf("%-12s %10u %12.1f %12.0f %18.0f\n", name, unsigned(n), sizeNs, walkNs, msgPackNs);
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--elements N,N...]\n", argv[0]);
+    return 2;
+  }
+
+  printf("best of %u rounds, ns per call\n\n", options.rounds);
+  printf("%-12s %10s %12s %12s %18s\n", "array", "elements", "size()", "walk", "serializeMsgPack");
+  for (size_t n : options.elements) {
+    std::string json = "[";
+    for (size_t i = 0; i < n; i++) {
+      json += std::to_string(i % 1000);
+      json += i + 1 < n ? "," : "]";
+    }
+
+    DynamicJsonDocument packed(JSON_ARRAY_SIZE(n) + 64);
+    DeserializationError error = deserializeJson(packed, json);
+    if (error) {
+      fprintf(stderr, "%u elements: %s\n", unsigned(n), error.c_str());
+      return 1;
+    }
+    printRow(options, "packed", packed.as<JsonArray>());
+
+    // INFO: the elements of the two arrays alternate in the pool
+    DynamicJsonDocument fragmented(2 * JSON_ARRAY_SIZE(n) + JSON_ARRAY_SIZE(2) + 64);
+    JsonArray first = fragmented.createNestedArray();
+    JsonArray second = fragmented.createNestedArray();
+    for (size_t i = 0; i < n; i++) {
+      first.add(int(i % 1000));
+      second.add(int(i % 1000));
+    }
+    if (first.size() != n) {
+      fprintf(stderr, "%u elements: the document is too small\n", unsigned(n));
+      return 1;
+    }
+    printRow(options, "fragmented", first);
+  }
+  return 0;
+}
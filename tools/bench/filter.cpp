@@ -0,0 +1,171 @@
+/**
+ * Times deserializeJson() and deserializeMsgPack() on arrays of weather answers, like a forecast, with the filter of
+ * the firmware (dt, wind.speed and weather[].id) and without, and shows the pool they take. Runs on the computer, with
+ * the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/filter.cpp -o bench-filter
+ *   ./bench-filter [--rounds 10] [--answers 1,10,40] tools/bench/weather-answer.json
+ *
+ * The inputs are in RAM, as const char*, so the strings are copied in both formats. The times are the best of the
+ * rounds, per document.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> answers = {1, 10, 40};
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--answers" && hasValue) {
+      options.answers.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.answers.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  for (size_t n : options.answers) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0 && !options.answers.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the parsing
+
+/**
+ * Parses the input with parse(doc), checks that it worked, and prints the time and the pool
+ * */
+template <typename TParse>
+bool printCell(const Options& options, JsonDocument& doc, TParse parse) {
+  DeserializationError error = parse(doc);
+  if (error) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return false;
+  }
+  size_t used = doc.memoryUsage();
+  double ns = measure(options, [&]() {
+    parse(doc);
+    sink = doc.memoryUsage();
+  });
+  printf(" %10.0f %8u", ns, unsigned(used));
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--answers N,N...] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+
+  StaticJsonDocument<256> filter;
+  deserializeJson(filter, "[{\"dt\":true,\"wind\":{\"speed\":true},\"weather\":[{\"id\":true}]}]");
+
+  printf("best of %u rounds, ns per document and bytes of pool\n\n", options.rounds);
+  printf("%8s %-8s %8s %10s %8s %10s %8s\n", "answers", "format", "bytes", "full", "pool", "filtered", "pool");
+  DynamicJsonDocument doc(1024 * 1024);
+  for (size_t n : options.answers) {
+    std::string json = "[";
+    for (size_t i = 0; i < n; i++) {
+      json += answer;
+      json += i + 1 < n ? "," : "]";
+    }
+    if (deserializeJson(doc, json)) {
+      fprintf(stderr, "%u answers don't parse\n", unsigned(n));
+      return 1;
+    }
+    std::string msgPack;
+    serializeMsgPack(doc, msgPack);
+
+    printf("%8u %-8s %8u", unsigned(n), "JSON", unsigned(json.size()));
+    const char* jsonInput = json.c_str();
+    if (!printCell(options, doc, [&](JsonDocument& d) { return deserializeJson(d, jsonInput); }) ||
+        !printCell(options, doc, [&](JsonDocument& d) {
+          return deserializeJson(d, jsonInput, DeserializationOption::Filter(filter));
+        })) {
+      return 1;
+    }
+    printf("\n%8s %-8s %8u", "", "MsgPack", unsigned(msgPack.size()));
+    const char* msgPackInput = msgPack.data();
+    size_t msgPackSize = msgPack.size();
+    if (!printCell(options, doc, [&](JsonDocument& d) { return deserializeMsgPack(d, msgPackInput, msgPackSize); }) ||
+        !printCell(options, doc, [&](JsonDocument& d) {
+          return deserializeMsgPack(d, msgPackInput, msgPackSize, DeserializationOption::Filter(filter));
+        })) {
+      return 1;
+    }
+    printf("\n");
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * Times index-heavy access to a forecast-like array of objects: reading a member of every element with operator[],
+ * and with the iterator. The "packed" array comes from deserializeJson(), which leaves the slots contiguous (see
+ * ARDUINOJSON_PACK_COLLECTIONS); the "linked" one is a copy of it, whose elements are interleaved with their members in
+ * the pool, so operator[] walks the list.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/indexing.cpp -o bench-indexing
+ *   ./bench-indexing [--rounds 10] [--elements 40,400,4000]
+ *
+ * The times are the best of the rounds, per pass over the whole array.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> elements = {40, 400, 4000};
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--elements" && hasValue) {
+      options.elements.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.elements.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+  for (size_t n : options.elements) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return options.rounds > 0 && !options.elements.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the calls
+
+void printRow(const Options& options, const char* name, JsonArrayConst array) {
+  size_t n = array.size();
+  double indexNs = measure(options, [&]() {
+    unsigned long sum = 0;
+    for (size_t i = 0; i < n; i++) {
+      sum += array[i]["dt"].as<unsigned long>();
+    }
+    sink = sum;
+  });
+  double iterateNs = measure(options, [&]() {
+    unsigned long sum = 0;
+    for (JsonArrayConst::iterator it = array.begin(); it != array.end(); ++it) {
+      sum += (*it)["dt"].as<unsigned long>();
+    }
+    sink = sum;
+  });
+  double lastNs = measure(options, [&]() { sink = array[n - 1]["dt"].as<unsigned long>(); });
+  printf("%-8s %10u %14.0f %14.0f %14.1f\n", name, unsigned(n), indexNs, iterateNs, lastNs);
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--elements N,N...]\n", argv[0]);
+    return 2;
+  }
+
+  printf("best of %u rounds, ns per pass\n\n", options.rounds);
+  printf("%-8s %10s %14s %14s %14s\n", "array", "elements", "operator[]", "iterator", "last element");
+  for (size_t n : options.elements) {
+    std::string json = "[";
+    for (size_t i = 0; i < n; i++) {
+      json += "{\"dt\":" + std::to_string(1600000000UL + i * 10800UL) + ",\"temp\":280.5,\"speed\":3.6}";
+      json += i + 1 < n ? "," : "]";
+    }
+
+    // INFO: the keys are copied, and pack() needs one free slot per element
+    DynamicJsonDocument packed(JSON_ARRAY_SIZE(n) + n * (JSON_OBJECT_SIZE(3) + 16) + JSON_ARRAY_SIZE(n) + 64);
+    DeserializationError error = deserializeJson(packed, json);
+    if (error) {
+      fprintf(stderr, "%u elements: %s\n", unsigned(n), error.c_str());
+      return 1;
+    }
+#if ARDUINOJSON_PACK_COLLECTIONS
+    if (!packed.data().asArray()->isPacked()) {
+      fprintf(stderr, "%u elements: the pool had no room to pack the array\n", unsigned(n));
+      return 1;
+    }
+#endif
+    printRow(options, "packed", packed.as<JsonArrayConst>());
+
+    DynamicJsonDocument linked(packed.capacity());
+    if (!linked.set(packed)) {
+      fprintf(stderr, "%u elements: the copy doesn't fit\n", unsigned(n));
+      return 1;
+    }
+    printRow(options, "linked", linked.as<JsonArrayConst>());
+  }
+  return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * Times the lookups of keys in objects of 5 to 100 members, and the parsing of these objects, to compare the hashes of
+ * the keys (ARDUINOJSON_HASH_KEYS=1) with the plain walk. Build it once per mode:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/keys.cpp -o bench-keys
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -DARDUINOJSON_HASH_KEYS=1 [-DARDUINOJSON_...] tools/bench/keys.cpp \
+ *     -o bench-keys-hashed
+ *   ./bench-keys [--rounds 10] [--keys 5,20,100]
+ *
+ * The keys look like those of a weather answer, with the same prefixes: "temp", "temp_min", "temp_max_2"... The
+ * "found" and "missing" times are per lookup, averaged over every key of the object, or over as many keys that aren't
+ * in it; the keys are in RAM, not literals, so strlen() runs. "parse" is per object.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> keys = {5, 20, 100};
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--keys" && hasValue) {
+      options.keys.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.keys.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+  for (size_t n : options.keys) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return options.rounds > 0 && !options.keys.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the lookups
+
+const char* names[] = {"temp", "temp_min", "temp_max", "feels_like", "pressure", "humidity", "sea_level", "grnd_level"};
+
+/**
+ * The i-th key: the names, then the names again with a suffix
+ * */
+std::string keyAt(size_t i) {
+  std::string key = names[i % 8];
+  if (i >= 8) {
+    key += "_" + std::to_string(i / 8);
+  }
+  return key;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--keys N,N...]\n", argv[0]);
+    return 2;
+  }
+
+  printf("ARDUINOJSON_HASH_KEYS %d; best of %u rounds, ns per lookup and per object\n\n", ARDUINOJSON_HASH_KEYS,
+         options.rounds);
+  printf("%8s %10s %10s %10s\n", "keys", "found", "missing", "parse");
+  for (size_t n : options.keys) {
+    std::vector<std::string> keys, missing;
+    std::string json = "{";
+    for (size_t i = 0; i < n; i++) {
+      keys.push_back(keyAt(i));
+      missing.push_back(keyAt(i) + "x");
+      json += std::string(i ? "," : "") + "\"" + keys.back() + "\":" + std::to_string(i);
+    }
+    json += "}";
+
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(n) + json.size());
+    DeserializationError error = deserializeJson(doc, json);
+    if (error) {
+      fprintf(stderr, "%u keys: %s\n", unsigned(n), error.c_str());
+      return 1;
+    }
+    JsonObjectConst object = doc.as<JsonObjectConst>();
+    for (size_t i = 0; i < n; i++) {
+      if (object[keys[i].c_str()] != int(i) || !object[missing[i].c_str()].isNull()) {
+        fprintf(stderr, "%u keys: \"%s\" isn't found\n", unsigned(n), keys[i].c_str());
+        return 1;
+      }
+    }
+
+    double foundNs = measure(options, [&]() {
+      int sum = 0;
+      for (size_t i = 0; i < n; i++) {
+        sum += object[keys[i].c_str()].as<int>();
+      }
+      sink = sum;
+    });
+    double missingNs = measure(options, [&]() {
+      size_t count = 0;
+      for (size_t i = 0; i < n; i++) {
+        count += object[missing[i].c_str()].isNull();
+      }
+      sink = count;
+    });
+    const char* input = json.c_str();
+    double parseNs = measure(options, [&]() {
+      deserializeJson(doc, input);
+      sink = doc.memoryUsage();
+    });
+    printf("%8u %10.1f %10.1f %10.0f\n", unsigned(n), foundNs / n, missingNs / n, parseNs);
+  }
+  return 0;
+}
@@ -0,0 +1,143 @@
+/**
+ * Measures the pool taken by the weather answer, alone and in arrays of answers, to compare the default slots with
+ * ARDUINOJSON_COMPACT_SLOTS. Build it once per mode:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/memory.cpp -o bench-memory
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -DARDUINOJSON_COMPACT_SLOTS=1 [-DARDUINOJSON_...] \
+ *     tools/bench/memory.cpp -o bench-memory-compact
+ *   ./bench-memory-compact [--rounds 10] [--answers 1,10,40] tools/bench/weather-answer.json
+ *
+ * The ESP8266 column counts the same slots at the size they have there (16 bytes, 12 compact), and the same strings;
+ * the documents are parsed from std::string, so both modes copy every string. The times are the best of the rounds,
+ * per document.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> answers = {1, 10, 40};
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--answers" && hasValue) {
+      options.answers.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.answers.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  for (size_t n : options.answers) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0 && !options.answers.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the parsing
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--answers N,N...] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+
+  const size_t esp8266SlotSize = ARDUINOJSON_COMPACT_SLOTS ? 12 : 16;
+  printf("%s slots, %u bytes here, %u on ESP8266; best of %u rounds\n\n",
+         ARDUINOJSON_COMPACT_SLOTS ? "compact" : "default", unsigned(sizeof(ARDUINOJSON_NAMESPACE::VariantSlot)),
+         unsigned(esp8266SlotSize), options.rounds);
+  printf("%8s %8s %10s %12s %12s %12s\n", "answers", "slots", "strings", "memoryUsage", "on ESP8266", "ns/document");
+  DynamicJsonDocument doc(1024 * 1024);
+  for (size_t n : options.answers) {
+    std::string json = "[";
+    for (size_t i = 0; i < n; i++) {
+      json += answer;
+      json += i + 1 < n ? "," : "]";
+    }
+    DeserializationError error = deserializeJson(doc, json);
+    if (error) {
+      fprintf(stderr, "%u answers: %s\n", unsigned(n), error.c_str());
+      return 1;
+    }
+    // INFO: the array itself takes no slot, it's the root, like a single answer
+    size_t slots = doc.memoryPool().variantsSize() / sizeof(ARDUINOJSON_NAMESPACE::VariantSlot);
+    size_t strings = doc.memoryPool().stringsSize();
+    double ns = measure(options, [&]() {
+      deserializeJson(doc, json);
+      sink = doc.memoryUsage();
+    });
+    printf("%8u %8u %10u %12u %12u %12.0f\n", unsigned(n), unsigned(slots), unsigned(strings), unsigned(doc.memoryUsage()),
+           unsigned(slots * esp8266SlotSize + strings), ns);
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * Times the ways of sending weather reports as MessagePack: filling a JsonDocument then serializeMsgPack(), and
+ * MsgPackWriter with a known count or in chunks. Runs on the computer, with the same ARDUINOJSON_* configuration as
+ * the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -I lib/Weather [-DARDUINOJSON_...] tools/bench/msgpack.cpp -o bench-msgpack
+ *   ./bench-msgpack [--rounds 10] [--items 1,10,50] [--chunk 256]
+ *
+ * The times are the best of the rounds, per batch of reports, written to a std::string.
+ * */
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> items = {1, 10, 50};
+  size_t chunk = 256;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--chunk" && hasValue) {
+      options.chunk = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--items" && hasValue) {
+      options.items.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.items.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else {
+      return false;
+    }
+  }
+  for (size_t n : options.items) {
+    if (n == 0) {
+      return false;
+    }
+  }
+  return options.rounds > 0 && options.chunk > 0 && !options.items.empty();
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the calls
+
+void fillDocument(JsonDocument& doc, const std::vector<WeatherReport>& reports) {
+  doc.clear();
+  for (const WeatherReport& report : reports) {
+    JsonObject item = doc.createNestedObject();
+    item["dt"] = report.dt;
+    item.createNestedObject("wind")["speed"] = report.wind.speed;
+    JsonArray weather = item.createNestedArray("weather");
+    for (uint8_t i = 0; i < report.storedWeatherCount(); i++) {
+      weather.createNestedObject()["id"] = report.weather[i].id;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--items N,N...] [--chunk BYTES]\n", argv[0]);
+    return 2;
+  }
+
+  printf("best of %u rounds, ns per batch; chunks of %u bytes\n\n", options.rounds, unsigned(options.chunk));
+  printf("%8s %8s %12s %12s %12s %8s\n", "reports", "bytes", "document", "counted", "chunked", "chunks");
+  std::vector<uint8_t> chunk(options.chunk);
+  for (size_t n : options.items) {
+    std::vector<WeatherReport> reports(n);
+    for (size_t i = 0; i < n; i++) {
+      reports[i].dt = 1600000000UL + i * 10800UL;
+      reports[i].wind.speed = 0.5f + i % 12;
+      reports[i].weather[0].id = i % 5 ? 800 : 500;
+      reports[i].weather[1].id = 701;
+      reports[i].weatherCount = i % 2 + 1;
+    }
+    // INFO: 32 bytes for the keys, copied with ARDUINOJSON_COMPACT_SLOTS
+    DynamicJsonDocument doc(
+        n * (JSON_OBJECT_SIZE(3) + JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(2) + 2 * JSON_OBJECT_SIZE(1) + 32));
+    fillDocument(doc, reports);
+    if (doc[n - 1]["weather"].isNull()) {
+      fprintf(stderr, "the document doesn't fit\n");
+      return 1;
+    }
+    std::string expected;
+    serializeMsgPack(doc, expected);
+    std::string output;
+    {
+      MsgPackWriter<std::string> writer(output);
+      writer.beginArray(n);
+      for (const WeatherReport& report : reports) {
+        writer.write(report);
+      }
+    }
+    if (output != expected) {
+      fprintf(stderr, "%u reports: the document and the writer disagree\n", unsigned(n));
+      return 1;
+    }
+
+    double documentNs = measure(options, [&]() {
+      output.clear();
+      fillDocument(doc, reports);
+      sink = serializeMsgPack(doc, output);
+    });
+    double countedNs = measure(options, [&]() {
+      output.clear();
+      MsgPackWriter<std::string> writer(output);
+      writer.beginArray(n);
+      for (const WeatherReport& report : reports) {
+        writer.write(report);
+      }
+      sink = writer.bytesWritten();
+    });
+    double chunkedNs = measure(options, [&]() {
+      output.clear();
+      MsgPackWriter<std::string> writer(output);
+      writer.beginArray(chunk.data(), chunk.size());
+      for (const WeatherReport& report : reports) {
+        writer.write(report);
+      }
+      writer.endArray();
+      sink = writer.bytesWritten();
+    });
+    // INFO: the chunks are the arrays at the top level of the output
+    std::istringstream input(output);
+    size_t chunks = 0;
+    while (input.peek() != EOF && !deserializeMsgPack(doc, input)) {
+      chunks++;
+    }
+    printf("%8u %8u %12.0f %12.0f %12.0f %8u\n", unsigned(n), unsigned(expected.size()), documentNs, countedNs,
+           chunkedNs, unsigned(chunks));
+  }
+  return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * Times the nested reads of a weather answer, like doc["wind"]["speed"], with the keys as literals, JsonKey constants,
+ * std::string and const char* that the compiler doesn't know. Runs on the computer, with the same ARDUINOJSON_*
+ * configuration as the firmware; build it with and without the hashes of the keys to compare:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_HASH_KEYS=1] tools/bench/nested.cpp -o bench-nested
+ *   ./bench-nested [--rounds 10] tools/bench/weather-answer.json
+ *
+ * Every pass reads 8 values, 2 levels deep; the times are the best of the rounds, per read.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+struct Options {
+  unsigned rounds = 10;
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile double sink; // INFO: keeps the compiler from dropping the reads
+
+const int reads = 8;
+
+/**
+ * The 8 reads, with the keys in the order of the literals: main.temp, main.pressure, main.humidity, wind.speed, wind.deg,
+ * sys.sunrise, sys.sunset, coord.lat
+ * */
+template <typename TKey>
+double readAll(JsonObjectConst doc, const TKey* k) {
+  return doc[k[0]][k[1]].template as<double>() + doc[k[0]][k[2]].template as<double>() +
+         doc[k[0]][k[3]].template as<double>() + doc[k[4]][k[5]].template as<double>() +
+         doc[k[4]][k[6]].template as<double>() + doc[k[7]][k[8]].template as<double>() +
+         doc[k[7]][k[9]].template as<double>() + doc[k[10]][k[11]].template as<double>();
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+  DynamicJsonDocument doc(4096);
+  DeserializationError error = deserializeJson(doc, answer);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", options.answer.c_str(), error.c_str());
+    return 1;
+  }
+  JsonObjectConst object = doc.as<JsonObjectConst>();
+
+  double literal = object["main"]["temp"].as<double>() + object["main"]["pressure"].as<double>() +
+                   object["main"]["humidity"].as<double>() + object["wind"]["speed"].as<double>() +
+                   object["wind"]["deg"].as<double>() + object["sys"]["sunrise"].as<double>() +
+                   object["sys"]["sunset"].as<double>() + object["coord"]["lat"].as<double>();
+  const JsonKey jsonKeys[] = {"main", "temp", "pressure", "humidity", "wind", "speed",
+                              "deg",  "sys",  "sunrise",  "sunset",   "coord", "lat"};
+  std::string strings[12];
+  char* runtime[12]; // INFO: copies, so strlen() can't be folded
+  std::string copies[12];
+  for (int i = 0; i < 12; i++) {
+    strings[i] = jsonKeys[i].c_str();
+    copies[i] = strings[i];
+    runtime[i] = &copies[i][0];
+  }
+  if (readAll(object, jsonKeys) != literal || readAll(object, strings) != literal ||
+      readAll(object, runtime) != literal || literal == 0) {
+    fprintf(stderr, "%s: the keys don't find the same values\n", options.answer.c_str());
+    return 1;
+  }
+
+  double literalNs = measure(options, [&]() {
+    sink = object["main"]["temp"].as<double>() + object["main"]["pressure"].as<double>() +
+           object["main"]["humidity"].as<double>() + object["wind"]["speed"].as<double>() +
+           object["wind"]["deg"].as<double>() + object["sys"]["sunrise"].as<double>() +
+           object["sys"]["sunset"].as<double>() + object["coord"]["lat"].as<double>();
+  });
+  double keyNs = measure(options, [&]() { sink = readAll(object, jsonKeys); });
+  double stringNs = measure(options, [&]() { sink = readAll(object, strings); });
+  double runtimeNs = measure(options, [&]() { sink = readAll(object, runtime); });
+
+  printf("ARDUINOJSON_HASH_KEYS %d; best of %u rounds, ns per read\n\n", ARDUINOJSON_HASH_KEYS, options.rounds);
+  printf("%10s %10s %12s %10s\n", "literal", "JsonKey", "std::string", "char*");
+  printf("%10.1f %10.1f %12.1f %10.1f\n", literalNs / reads, keyNs / reads, stringNs / reads, runtimeNs / reads);
+  return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * Times deserializeJson() on number-heavy arrays, like the timestamps, ids, temperatures and speeds of a forecast, to
+ * compare the correctly rounded float parsing with the old one (ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS=0). Build it once
+ * per mode:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/numbers.cpp -o bench-numbers
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -DARDUINOJSON_CORRECTLY_ROUNDED_FLOATS=0 [-DARDUINOJSON_...] \
+ *     tools/bench/numbers.cpp -o bench-numbers-old
+ *   ./bench-numbers [--rounds 10] [--count 1000]
+ *
+ * The times are the best of the rounds, per number; "istream" reads the same array from a std::istringstream, "strtod"
+ * parses the numbers with the C library, and "exact" counts the numbers that came out as strtod()'s.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <sstream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  unsigned count = 1000;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--count" && hasValue) {
+      options.count = strtoul(argv[++i], NULL, 10);
+    } else {
+      return false;
+    }
+  }
+  return options.rounds > 0 && options.count > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the parsing
+
+uint32_t seed = 1;
+
+uint32_t nextRandom() {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+/**
+ * The numbers, one string each, and the JSON array of them
+ * */
+struct Numbers {
+  std::vector<std::string> items;
+  std::string json;
+
+  void add(const char* item) {
+    items.push_back(item);
+    json += json.empty() ? "[" : ",";
+    json += item;
+  }
+};
+
+bool printRow(const Options& options, const char* name, Numbers& numbers) {
+  numbers.json += "]";
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(numbers.items.size()) + 64);
+  DeserializationError error = deserializeJson(doc, numbers.json);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", name, error.c_str());
+    return false;
+  }
+  size_t exact = 0;
+  for (size_t i = 0; i < numbers.items.size(); i++) {
+    JsonFloat expected = JsonFloat(strtod(numbers.items[i].c_str(), NULL));
+    if (sizeof(JsonFloat) < sizeof(double)) {
+      expected = JsonFloat(strtof(numbers.items[i].c_str(), NULL));
+    }
+    JsonFloat actual = doc[i].as<JsonFloat>();
+    exact += memcmp(&expected, &actual, sizeof(JsonFloat)) == 0;
+  }
+
+  double parseNs = measure(options, [&]() {
+    deserializeJson(doc, numbers.json);
+    sink = doc.memoryUsage();
+  });
+  double streamNs = measure(options, [&]() {
+    std::istringstream input(numbers.json);
+    deserializeJson(doc, input);
+    sink = doc.memoryUsage();
+  });
+  double strtodNs = measure(options, [&]() {
+    double sum = 0;
+    for (size_t i = 0; i < numbers.items.size(); i++) {
+      sum += strtod(numbers.items[i].c_str(), NULL);
+    }
+    sink = size_t(sum);
+  });
+  size_t n = numbers.items.size();
+  printf("%-23s %8u %12.1f %10.1f %10.1f %10u\n", name, unsigned(n), parseNs / n, streamNs / n, strtodNs / n,
+         unsigned(exact));
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--count N]\n", argv[0]);
+    return 2;
+  }
+
+  printf("ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS %d, %u-byte JsonFloat; best of %u rounds, ns per number\n\n",
+         ARDUINOJSON_CORRECTLY_ROUNDED_FLOATS, unsigned(sizeof(JsonFloat)), options.rounds);
+  printf("%-23s %8s %12s %10s %10s %10s\n", "numbers", "count", "deserialize", "istream", "strtod", "exact");
+
+  char buffer[32];
+  Numbers timestamps; // INFO: like "dt": 1600000000
+  Numbers ids;
+  Numbers offsets;
+  Numbers temperatures; // INFO: like "temp": 293.15, the fast path
+  Numbers speeds;
+  Numbers doubles; // INFO: 17 digits, like a double written by another program
+  Numbers tiny;
+  for (unsigned i = 0; i < options.count; i++) {
+    snprintf(buffer, sizeof(buffer), "%u", 1600000000u + i * 10800u);
+    timestamps.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%u", 200 + nextRandom() % 605);
+    ids.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%d", int(nextRandom() % 27) * 3600 - 43200);
+    offsets.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%u.%02u", 250 + nextRandom() % 70, nextRandom() % 100);
+    temperatures.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%u.%u", nextRandom() % 20, nextRandom() % 10);
+    speeds.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%.17g", (nextRandom() % 1000000) / 997.0 * 1.000000001);
+    doubles.add(buffer);
+    snprintf(buffer, sizeof(buffer), "%ue-%u", nextRandom() % 100000, 20 + nextRandom() % 200);
+    tiny.add(buffer);
+  }
+  return printRow(options, "timestamps (1600000000)", timestamps) && printRow(options, "ids (800)", ids) &&
+                 printRow(options, "offsets (-7200)", offsets) &&
+                 printRow(options, "temperatures (293.15)", temperatures) && printRow(options, "speeds (3.6)", speeds) &&
+                 printRow(options, "17-digit doubles", doubles) && printRow(options, "small exponents", tiny)
+             ? 0
+             : 1;
+}
@@ -0,0 +1,186 @@
+/**
+ * Times deserializeJson() and measures its call stack, on the weather answer and on nested arrays, to compare the
+ * recursive deserializer with ARDUINOJSON_ITERATIVE_DESERIALIZER. Build it once per mode:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/parse.cpp -o bench-parse-recursive
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -DARDUINOJSON_ITERATIVE_DESERIALIZER=1 [-DARDUINOJSON_...] \
+ *     tools/bench/parse.cpp -o bench-parse-iterative
+ *   ./bench-parse-iterative [--rounds 10] [--depths 10,50,200] tools/bench/weather-answer.json
+ *
+ * The times are the best of the rounds, per document. The stack is the distance between deserializeJson()'s caller
+ * and the deepest call to the reader.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  std::vector<size_t> depths = {10, 50, 200};
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--depths" && hasValue) {
+      options.depths.clear();
+      for (char* list = argv[++i]; *list;) {
+        options.depths.push_back(strtoul(list, &list, 10));
+        if (*list == ',') {
+          list++;
+        } else if (*list) {
+          return false;
+        }
+      }
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  for (size_t depth : options.depths) {
+    if (depth == 0 || depth > 255) { // INFO: the NestingLimit is 8-bit
+      return false;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+/**
+ * A reader that notes the lowest address of the stack it's called from
+ * */
+struct StackProbe {
+  const char* data;
+  size_t size;
+  size_t position = 0;
+  uintptr_t lowest;
+
+  StackProbe(const std::string& json) : data(json.data()), size(json.size()) {
+    char here;
+    lowest = uintptr_t(&here);
+  }
+
+  __attribute__((noinline)) int read() {
+    char here;
+    if (uintptr_t(&here) < lowest) {
+      lowest = uintptr_t(&here);
+    }
+    return position < size ? (unsigned char)data[position++] : -1;
+  }
+
+  size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    for (int c; n < length && (c = read()) >= 0; n++) {
+      buffer[n] = char(c);
+    }
+    return n;
+  }
+};
+
+__attribute__((noinline)) size_t measureStack(JsonDocument& doc, const std::string& json, uint8_t nestingLimit) {
+  StackProbe probe(json);
+  uintptr_t top = probe.lowest;
+  deserializeJson(doc, probe, DeserializationOption::NestingLimit(nestingLimit));
+  return size_t(top - probe.lowest);
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the parsing
+
+bool printRow(const Options& options, JsonDocument& doc, const char* name, const std::string& json, uint8_t nestingLimit) {
+  DeserializationError error = deserializeJson(doc, json, DeserializationOption::NestingLimit(nestingLimit));
+  if (error) {
+    fprintf(stderr, "%s: %s\n", name, error.c_str());
+    return false;
+  }
+  double ns = measure(options, [&]() {
+    deserializeJson(doc, json, DeserializationOption::NestingLimit(nestingLimit));
+    sink = doc.memoryUsage();
+  });
+  printf("%-16s %10u %12.0f %12u\n", name, unsigned(json.size()), ns, unsigned(measureStack(doc, json, nestingLimit)));
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--depths N,N...] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+
+  DynamicJsonDocument doc(65536);
+  printf("%s deserializer, ARDUINOJSON_DEFAULT_NESTING_LIMIT %u, best of %u rounds\n\n",
+         ARDUINOJSON_ITERATIVE_DESERIALIZER ? "iterative" : "recursive", unsigned(ARDUINOJSON_DEFAULT_NESTING_LIMIT),
+         options.rounds);
+  printf("%-16s %10s %12s %12s\n", "document", "bytes", "ns/document", "stack bytes");
+  if (!printRow(options, doc, "weather answer", answer, ARDUINOJSON_DEFAULT_NESTING_LIMIT)) {
+    return 1;
+  }
+  for (size_t depth : options.depths) {
+    std::string json(depth, '[');
+    json += "42";
+    json.append(depth, ']');
+    char name[32];
+    snprintf(name, sizeof(name), "%u nested", unsigned(depth));
+    if (!printRow(options, doc, name, json, uint8_t(depth))) {
+      return 1;
+    }
+  }
+  return 0;
+}
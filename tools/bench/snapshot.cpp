@@ -0,0 +1,125 @@
+/**
+ * Compares the ways of loading the last known weather at boot: a WeatherSnapshot, the same report as JSON read into
+ * the bound struct, and as MsgPack read into a JsonDocument.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -I lib/Weather [-DARDUINOJSON_...] tools/bench/snapshot.cpp -o bench-snapshot
+ *   ./bench-snapshot [--rounds 7] [--iterations 200000] tools/bench/weather-answer.json
+ *
+ * The answer is decoded once; the times are the best of the rounds, per load, checks included.
+ * */
+#include <ArduinoJson.h>
+#include <WeatherSnapshot.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+struct Options {
+  unsigned rounds = 7;
+  unsigned iterations = 200000;
+  std::string answer;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--iterations" && hasValue) {
+      options.iterations = strtoul(argv[++i], NULL, 10);
+    } else if (arg.compare(0, 2, "--") == 0 || !options.answer.empty()) {
+      return false;
+    } else {
+      options.answer = arg;
+    }
+  }
+  return !options.answer.empty() && options.rounds > 0 && options.iterations > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of load()
+ * */
+template <typename TLoad>
+double measure(const Options& options, TLoad load) {
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < options.iterations; i++) {
+      load();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / options.iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile long sink; // INFO: keeps the compiler from dropping the loading
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--iterations N] ANSWER\n", argv[0]);
+    return 2;
+  }
+  std::string answer;
+  if (!readFile(options.answer, answer)) {
+    fprintf(stderr, "%s: can't read the file\n", options.answer.c_str());
+    return 1;
+  }
+  WeatherReport saved = WeatherReport();
+  DeserializationError error = deserializeJson(saved, answer);
+  if (error) {
+    fprintf(stderr, "%s: %s\n", options.answer.c_str(), error.c_str());
+    return 1;
+  }
+
+  uint8_t snapshot[weatherSnapshotHeaderSize + weatherSnapshotRecordSize];
+  size_t snapshotSize = writeWeatherSnapshot(&saved, 1, snapshot, sizeof(snapshot));
+  std::string json;
+  serializeJson(saved, json);
+  StaticJsonDocument<256> doc;
+  deserializeJson(doc, json);
+  std::string msgPack;
+  serializeMsgPack(doc, msgPack);
+
+  double snapshotNs = measure(options, [&]() {
+    WeatherSnapshotView view(snapshot, snapshotSize);
+    WeatherReport report = view.check() == SNAPSHOT_OK ? view.get(0) : WeatherReport();
+    sink = long(report.dt) + report.weather[0].id;
+  });
+
+  double jsonNs = measure(options, [&]() {
+    WeatherReport report = WeatherReport();
+    deserializeJson(report, json);
+    sink = long(report.dt) + report.weather[0].id;
+  });
+
+  double msgPackNs = measure(options, [&]() {
+    deserializeMsgPack(doc, msgPack);
+    sink = doc["dt"].as<long>() + doc["weather"][0]["id"].as<int>();
+  });
+
+  printf("one report, best of %u rounds of %u loads\n\n", options.rounds, options.iterations);
+  printf("%-32s %8s %10s\n", "", "bytes", "ns/load");
+  printf("%-32s %8u %10.0f\n", "WeatherSnapshot (check + get)", unsigned(snapshotSize), snapshotNs);
+  printf("%-32s %8u %10.0f\n", "JSON into WeatherReport", unsigned(json.size()), jsonNs);
+  printf("%-32s %8u %10.0f\n", "MsgPack into a JsonDocument", unsigned(msgPack.size()), msgPackNs);
+  return 0;
+}
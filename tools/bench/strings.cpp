@@ -0,0 +1,192 @@
+/**
+ * Times serializeJson() and deserializeJson() on string-heavy documents, like the descriptions of a forecast, to
+ * compare the escape tables with the old lists (ARDUINOJSON_ESCAPE_TABLES=0, the AVR default), and the string runs of
+ * the readers in RAM with a std::istream, which reads one character at a time. Build it once per mode:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/strings.cpp -o bench-strings
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson -DARDUINOJSON_ESCAPE_TABLES=0 [-DARDUINOJSON_...] tools/bench/strings.cpp \
+ *     -o bench-strings-lists
+ *   ./bench-strings [--rounds 10] [--items 200]
+ *
+ * "plain" descriptions need no escaping, "escaped" ones have a few quotes, backslashes and newlines, "long" ones are
+ * 1 KB of base64, like an embedded icon. The times are the best of the rounds, per document; "calls" counts the calls
+ * to a writer that only copies the bytes. deserializeJson() reads a const char* ("copy"), a char* ("in place", less the
+ * memcpy() that restores the input) and a std::istringstream.
+ * */
+#include <ArduinoJson.h>
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  unsigned rounds = 10;
+  unsigned items = 200;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--items" && hasValue) {
+      options.items = strtoul(argv[++i], NULL, 10);
+    } else {
+      return false;
+    }
+  }
+  return options.rounds > 0 && options.items > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the calls
+
+/**
+ * Copies the bytes in a fixed buffer and counts the calls
+ * */
+struct RamWriter {
+  size_t calls = 0;
+  size_t size = 0;
+  uint8_t buffer[65536];
+
+  size_t write(uint8_t c) {
+    calls++;
+    if (size < sizeof(buffer)) {
+      buffer[size++] = c;
+    }
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    calls++;
+    for (size_t i = 0; i < n && size < sizeof(buffer); i++) {
+      buffer[size++] = s[i];
+    }
+    return n;
+  }
+};
+
+const char* plainDescriptions[] = {"light rain", "overcast clouds", "scattered clouds", "clear sky",
+                                   "moderate rain, wind from the south west", "Frankfurt am Main"};
+
+const char* escapedDescriptions[] = {"light \"rain\"", "overcast clouds\nlater \"broken\"", "C:\\weather\\icons\\04d",
+                                     "clear sky", "moderate rain,\twind from the south west", "\"Frankfurt am Main\""};
+
+bool printRow(const Options& options, const char* name, const char** descriptions, unsigned items) {
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(items) + items * JSON_OBJECT_SIZE(3));
+  for (unsigned i = 0; i < items; i++) {
+    JsonObject item = doc.createNestedObject();
+    item["main"] = descriptions[i % 3];
+    item["description"] = descriptions[3 + i % 3];
+    item["icon"] = i % 2 ? "04d" : "10n";
+  }
+  if (doc[items - 1]["icon"].isNull()) {
+    fprintf(stderr, "the document doesn't fit\n");
+    return false;
+  }
+  std::string json;
+  serializeJson(doc, json);
+  if (json.size() > sizeof(RamWriter::buffer)) {
+    fprintf(stderr, "%s: the output doesn't fit, try fewer --items\n", name);
+    return false;
+  }
+
+  std::string output;
+  double stringNs = measure(options, [&]() {
+    output.clear();
+    sink = serializeJson(doc, output);
+  });
+  static char buffer[sizeof(RamWriter::buffer) + 1];
+  double bufferNs = measure(options, [&]() { sink = serializeJson(doc, buffer, sizeof(buffer)); });
+  static RamWriter writer;
+  double writerNs = measure(options, [&]() {
+    writer.calls = 0;
+    writer.size = 0;
+    sink = serializeJson(doc, writer);
+  });
+  DynamicJsonDocument parsed(doc.capacity() + json.size());
+  double copyNs = measure(options, [&]() {
+    deserializeJson(parsed, json.c_str());
+    sink = parsed.memoryUsage();
+  });
+  std::vector<char> input(json.size() + 1);
+  double inPlaceNs = measure(options, [&]() {
+    memcpy(&input[0], json.c_str(), input.size()); // INFO: the parsing unescapes the input
+    deserializeJson(parsed, &input[0]);
+    sink = parsed.memoryUsage();
+  });
+  double copyOnlyNs = measure(options, [&]() {
+    memcpy(&input[0], json.c_str(), input.size());
+    sink = input[0];
+  });
+  double streamNs = measure(options, [&]() {
+    std::istringstream stream(json);
+    deserializeJson(parsed, stream);
+    sink = parsed.memoryUsage();
+  });
+  printf("%-8s %8u %12.0f %10.0f %10.0f %8u %10.0f %10.0f %10.0f\n", name, unsigned(json.size()), stringNs, bufferNs,
+         writerNs, unsigned(writer.calls), copyNs, inPlaceNs - copyOnlyNs, streamNs);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--items N]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<std::string> base64(6);
+  for (size_t i = 0; i < base64.size(); i++) {
+    for (size_t j = 0; j < 1024; j++) {
+      base64[i] += "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(i * 7 + j * 13) % 64];
+    }
+  }
+  const char* longDescriptions[] = {base64[0].c_str(), base64[1].c_str(), base64[2].c_str(),
+                                    base64[3].c_str(), base64[4].c_str(), base64[5].c_str()};
+
+  printf("ARDUINOJSON_ESCAPE_TABLES %d, %u items; best of %u rounds, ns per document\n\n", ARDUINOJSON_ESCAPE_TABLES,
+         options.items, options.rounds);
+  printf("%-8s %8s %12s %10s %10s %8s %10s %10s %10s\n", "strings", "bytes", "std::string", "char[]", "writer", "calls",
+         "copy", "in place", "istream");
+  // INFO: the long strings make fewer items, to fit the writer
+  return printRow(options, "plain", plainDescriptions, options.items) &&
+                 printRow(options, "escaped", escapedDescriptions, options.items) &&
+                 printRow(options, "long", longDescriptions, options.items < 16 ? options.items : 16)
+             ? 0
+             : 1;
+}
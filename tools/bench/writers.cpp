@@ -0,0 +1,236 @@
+/**
+ * Times serializeJson() and serializeMsgPack() on a forecast-like document, with and without the BufferingWriter,
+ * to tell which destinations gain from it (see ARDUINOJSON_BUFFER_PRINT and IsBufferedDestination):
+ *   ostringstream   std::ostream, buffered by default
+ *   Print           write() is only a virtual call and a copy, like a Print to RAM
+ *   slow Print      write() also costs --call-cost loop turns per call, like a HardwareSerial or a WiFiClient
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/bench/writers.cpp -o bench-writers
+ *   ./bench-writers [--rounds 10] [--items 50] [--call-cost 100]
+ *
+ * The times are the best of the rounds, per document.
+ * */
+#include <stddef.h>
+#include <stdint.h>
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* s, size_t n) = 0;
+};
+
+#define ARDUINOJSON_ENABLE_ARDUINO_PRINT 1
+#include <ArduinoJson.h>
+#include <chrono>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+struct Options {
+  unsigned rounds = 10;
+  unsigned items = 50;
+  unsigned callCost = 100;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--rounds" && hasValue) {
+      options.rounds = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--items" && hasValue) {
+      options.items = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--call-cost" && hasValue) {
+      options.callCost = strtoul(argv[++i], NULL, 10);
+    } else {
+      return false;
+    }
+  }
+  return options.rounds > 0 && options.items > 0;
+}
+
+/**
+ * Best time of the rounds, in nanoseconds per call of run(); the rounds repeat run() for at least 10 ms
+ * */
+template <typename TRun>
+double measure(const Options& options, TRun run) {
+  typedef std::chrono::steady_clock Clock;
+  size_t iterations = 1;
+  for (;;) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    if (Clock::now() - start >= std::chrono::milliseconds(10)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  double best = 0;
+  for (unsigned r = 0; r < options.rounds; r++) {
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+      run();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations;
+    if (r == 0 || ns < best) {
+      best = ns;
+    }
+  }
+  return best;
+}
+
+volatile size_t sink; // INFO: keeps the compiler from dropping the calls
+
+/**
+ * Copies the bytes in a fixed buffer and counts the calls; each call also spins callCost turns
+ * */
+class RamPrint : public Print {
+ public:
+  explicit RamPrint(unsigned callCost) : calls(0), _callCost(callCost), _size(0) {}
+
+  size_t write(uint8_t c) {
+    spin();
+    if (_size < sizeof(_buffer)) {
+      _buffer[_size++] = c;
+    }
+    return 1;
+  }
+
+  size_t write(const uint8_t* s, size_t n) {
+    spin();
+    for (size_t i = 0; i < n && _size < sizeof(_buffer); i++) {
+      _buffer[_size++] = s[i];
+    }
+    return n;
+  }
+
+  void clear() {
+    _size = 0;
+    calls = 0;
+  }
+
+  size_t calls;
+
+ private:
+  void spin() {
+    calls++;
+    for (volatile unsigned i = 0; i < _callCost; i++) {
+    }
+  }
+
+  unsigned _callCost;
+  size_t _size;
+  uint8_t _buffer[16384];
+};
+
+/**
+ * The same Print, opted in to the BufferingWriter
+ * */
+class BufferedRamPrint : public RamPrint {
+ public:
+  explicit BufferedRamPrint(unsigned callCost) : RamPrint(callCost) {}
+};
+
+namespace ARDUINOJSON_NAMESPACE {
+template <>
+struct IsBufferedDestination<BufferedRamPrint> : true_type {};
+}
+
+using ARDUINOJSON_NAMESPACE::JsonSerializer;
+using ARDUINOJSON_NAMESPACE::MsgPackSerializer;
+using ARDUINOJSON_NAMESPACE::Writer;
+
+/**
+ * serializeJson() and serializeMsgPack() without the BufferingWriter, whatever IsBufferedDestination says
+ * */
+template <template <typename> class TSerializer, typename TDestination>
+size_t serializeDirect(const JsonDocument& doc, TDestination& destination) {
+  return ARDUINOJSON_NAMESPACE::doSerialize<TSerializer>(doc, Writer<TDestination>(destination));
+}
+
+void printRow(const char* destination, const char* format, double directNs, double bufferedNs, size_t directCalls,
+              size_t bufferedCalls) {
+  printf("%-15s %-8s %10.0f %10.0f", destination, format, directNs, bufferedNs);
+  if (directCalls) {
+    printf(" %8u -> %u", unsigned(directCalls), unsigned(bufferedCalls));
+  }
+  printf("\n");
+}
+
+void printPrintRows(const Options& options, const char* name, unsigned callCost, const JsonDocument& doc) {
+  RamPrint direct(callCost);
+  BufferedRamPrint buffered(callCost);
+
+  double directNs = measure(options, [&]() {
+    direct.clear();
+    sink = serializeJson(doc, direct);
+  });
+  double bufferedNs = measure(options, [&]() {
+    buffered.clear();
+    sink = serializeJson(doc, buffered);
+  });
+  printRow(name, "JSON", directNs, bufferedNs, direct.calls, buffered.calls);
+
+  directNs = measure(options, [&]() {
+    direct.clear();
+    sink = serializeMsgPack(doc, direct);
+  });
+  bufferedNs = measure(options, [&]() {
+    buffered.clear();
+    sink = serializeMsgPack(doc, buffered);
+  });
+  printRow("", "MsgPack", directNs, bufferedNs, direct.calls, buffered.calls);
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--rounds N] [--items N] [--call-cost N]\n", argv[0]);
+    return 2;
+  }
+
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(options.items) + options.items * JSON_OBJECT_SIZE(4));
+  for (unsigned i = 0; i < options.items; i++) {
+    JsonObject item = doc.createNestedObject();
+    item["dt"] = 1600000000UL + i * 10800UL;
+    item["temp"] = 280.5 + i * 0.25;
+    item["main"] = i % 3 ? "Clouds" : "Rain";
+    item["speed"] = 3.6;
+  }
+  if (doc[options.items - 1]["speed"].isNull()) {
+    fprintf(stderr, "the document doesn't fit\n");
+    return 1;
+  }
+
+  printf("%u bytes of JSON, %u of MsgPack; best of %u rounds, ns per document\n\n", unsigned(measureJson(doc)),
+         unsigned(measureMsgPack(doc)), options.rounds);
+  printf("%-15s %-8s %10s %10s  %s\n", "destination", "format", "direct", "buffered", "write() calls");
+
+  std::ostringstream os;
+  double directNs = measure(options, [&]() {
+    os.str(std::string());
+    sink = serializeDirect<JsonSerializer>(doc, os);
+  });
+  double bufferedNs = measure(options, [&]() {
+    os.str(std::string());
+    sink = serializeJson(doc, os);
+  });
+  printRow("ostringstream", "JSON", directNs, bufferedNs, 0, 0);
+  directNs = measure(options, [&]() {
+    os.str(std::string());
+    sink = serializeDirect<MsgPackSerializer>(doc, os);
+  });
+  bufferedNs = measure(options, [&]() {
+    os.str(std::string());
+    sink = serializeMsgPack(doc, os);
+  });
+  printRow("", "MsgPack", directNs, bufferedNs, 0, 0);
+
+  printPrintRows(options, "Print", 0, doc);
+  printPrintRows(options, "slow Print", options.callCost, doc);
+  return 0;
+}
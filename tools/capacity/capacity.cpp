@@ -0,0 +1,124 @@
+/**
+ * Computes the JsonDocument capacity needed for sample answers of the weather website.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -I lib/ArduinoJson [-DARDUINOJSON_...] tools/capacity/capacity.cpp -o capacity
+ *   ./capacity [--filter tools/capacity/weather-filter.json] [--margin 10] [--slot-size 16 --alignment 4] answer1.json answer2.json ...
+ *
+ * --slot-size and --alignment give the sizes of the target when they differ from the computer's
+ * (ESP8266: 16 and 4, or 12 and 4 with ARDUINOJSON_COMPACT_SLOTS).
+ * */
+#include <ArduinoJson.h>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+struct Options {
+  std::string filter;
+  size_t margin = 10;
+  size_t slotSize = sizeof(ARDUINOJSON_NAMESPACE::VariantSlot);
+  size_t alignment = sizeof(void*);
+  std::vector<std::string> samples;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+size_t alignUp(size_t bytes, size_t alignment) {
+  return (bytes + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Same as JsonCapacityReport::capacity(), with the sizes of the target
+ * */
+size_t targetCapacity(const JsonCapacityReport& report, const Options& options) {
+  return report.variants * options.slotSize + alignUp(report.strings, options.alignment) + report.transient;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--filter" && hasValue) {
+      options.filter = argv[++i];
+    } else if (arg == "--margin" && hasValue) {
+      options.margin = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--slot-size" && hasValue) {
+      options.slotSize = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--alignment" && hasValue) {
+      options.alignment = strtoul(argv[++i], NULL, 10);
+    } else if (arg.compare(0, 2, "--") == 0) {
+      return false;
+    } else {
+      options.samples.push_back(arg);
+    }
+  }
+  return !options.samples.empty() && options.slotSize > 0 && options.alignment > 0;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--filter FILE] [--margin PERCENT] [--slot-size BYTES] [--alignment BYTES] SAMPLE...\n", argv[0]);
+    return 2;
+  }
+
+  DynamicJsonDocument filter(4096);
+  if (!options.filter.empty()) {
+    std::string content;
+    if (!readFile(options.filter, content)) {
+      fprintf(stderr, "%s: can't read the file\n", options.filter.c_str());
+      return 1;
+    }
+    DeserializationError error = deserializeJson(filter, content);
+    if (error) {
+      fprintf(stderr, "%s: %s\n", options.filter.c_str(), error.c_str());
+      return 1;
+    }
+  } else {
+    filter.set(true);
+  }
+
+  printf("configuration: sizeof(VariantSlot)=%u ARDUINOJSON_COMPACT_SLOTS=%d ARDUINOJSON_USE_DOUBLE=%d ARDUINOJSON_USE_LONG_LONG=%d\n",
+         unsigned(sizeof(ARDUINOJSON_NAMESPACE::VariantSlot)), ARDUINOJSON_COMPACT_SLOTS, ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_USE_LONG_LONG);
+  printf("target: slot=%u alignment=%u\n\n", unsigned(options.slotSize), unsigned(options.alignment));
+  printf("%-32s %8s %8s %8s %9s %9s %9s\n", "sample", "variants", "strings", "padding", "transient", "computer", "target");
+
+  size_t largest = 0;
+  for (size_t i = 0; i < options.samples.size(); i++) {
+    const std::string& path = options.samples[i];
+    std::string content;
+    if (!readFile(path, content)) {
+      fprintf(stderr, "%s: can't read the file\n", path.c_str());
+      return 1;
+    }
+    JsonCapacityReport report = measureJsonCapacity(content, DeserializationOption::Filter(filter));
+    if (report.error) {
+      fprintf(stderr, "%s: %s\n", path.c_str(), report.error.c_str());
+      return 1;
+    }
+    size_t target = targetCapacity(report, options);
+    printf("%-32s %8u %8u %8u %9u %9u %9u\n", path.c_str(), unsigned(report.variants), unsigned(report.strings),
+           unsigned(report.padding), unsigned(report.transient), unsigned(report.capacity()), unsigned(target));
+    if (target > largest) {
+      largest = target;
+    }
+  }
+
+  // INFO: the margin covers answers larger than the samples, e.g. more weather states
+  size_t recommended = alignUp(largest + largest * options.margin / 100, options.alignment);
+  printf("\nlargest: %u bytes\n", unsigned(largest));
+  printf("recommended: StaticJsonDocument<%u> (+%u%%)\n", unsigned(recommended), unsigned(options.margin));
+  return 0;
+}
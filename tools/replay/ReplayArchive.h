@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * Splits a JSON Lines archive of answers and parses its lines on several threads, for tools/replay and test/test_replay.
+ * */
+#include <ArduinoJson.h>
+#include <WeatherReport.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Line {
+  const char* json;
+  size_t length;
+  size_t number; // in the archive, from 1
+};
+
+struct Parsed {
+  WeatherReport report;
+  DeserializationError error;
+};
+
+/**
+ * Splits the archive at the newlines, without copying; blank lines are skipped.
+ * */
+inline std::vector<Line> splitLines(const std::string& content) {
+  std::vector<Line> lines;
+  size_t number = 0;
+  size_t begin = 0;
+  while (begin < content.size()) {
+    size_t end = content.find('\n', begin);
+    if (end == std::string::npos) {
+      end = content.size();
+    }
+    number++;
+    if (content.find_first_not_of(" \t\r", begin) < end) {
+      Line line = {content.data() + begin, end - begin, number};
+      lines.push_back(line);
+    }
+    begin = end + 1;
+  }
+  return lines;
+}
+
+inline void parseLine(const Line& line, Parsed& parsed) {
+  parsed.report = WeatherReport(); // INFO: same as the firmware, fields missing from the answer must not keep the previous line's values
+  parsed.error = deserializeJson(parsed.report, line.json, line.length);
+}
+
+/**
+ * Parses the lines on several threads. The threads take the chunks in order from a shared counter,
+ * and each line has its own slot in results, so the threads share nothing else.
+ * onChunk() runs on the calling thread, for each chunk in order, as soon as the chunk and the ones before are parsed.
+ * */
+template <typename TCallback>
+void parseLines(const std::vector<Line>& lines, std::vector<Parsed>& results, unsigned threads, size_t chunk,
+                TCallback onChunk) {
+  results.resize(lines.size());
+  size_t chunks = (lines.size() + chunk - 1) / chunk;
+  std::atomic<size_t> next(0);
+  std::vector<char> done(chunks, 0);
+  std::mutex mutex;
+  std::condition_variable parsed;
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; t++) {
+    workers.push_back(std::thread([&]() {
+      for (size_t c = next++; c < chunks; c = next++) {
+        size_t end = std::min(lines.size(), (c + 1) * chunk);
+        for (size_t i = c * chunk; i < end; i++) {
+          parseLine(lines[i], results[i]);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        done[c] = 1;
+        parsed.notify_all();
+      }
+    }));
+  }
+
+  for (size_t c = 0; c < chunks; c++) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      parsed.wait(lock, [&]() { return done[c] != 0; });
+    }
+    onChunk(c * chunk, std::min(lines.size(), (c + 1) * chunk));
+  }
+  for (size_t t = 0; t < workers.size(); t++) {
+    workers[t].join();
+  }
+}
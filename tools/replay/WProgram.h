@@ -0,0 +1,7 @@
+#pragma once
+
+/**
+ * Stands in for the Arduino core when TimeLib is built on the computer, for tools/replay.
+ * TimeLib only needs millis(), for now() and setTime(), which the replay doesn't call.
+ * */
+unsigned long millis();
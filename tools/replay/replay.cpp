@@ -0,0 +1,179 @@
+/**
+ * Replays archived answers of the weather website through the firmware's pump logic.
+ * The archive is JSON Lines: one answer per line, as the website sent it.
+ * Runs on the computer, with the same ARDUINOJSON_* configuration as the firmware:
+ *
+ *   g++ -std=c++11 -O2 -pthread -I tools/replay -I lib/ArduinoJson -I lib/TimeArduino -I lib/Weather [-DARDUINOJSON_...] \
+ *     tools/replay/replay.cpp lib/TimeArduino/Time.cpp -o replay
+ *   ./replay [-j THREADS] [--chunk LINES] archive.jsonl > decisions.csv
+ *   ./replay --bench [--repeat 5] archive.jsonl
+ *
+ * The lines are parsed on THREADS threads, a chunk of lines at a time, and decided in the order of the archive,
+ * so the output doesn't depend on THREADS.
+ * --bench parses the archive with 1, 2, 4, 8 and 16 threads, and prints the throughput of each, and its ratio to one
+ * thread. How that ratio grows with the cores hasn't been measured: so far the tool only ran on a single-core computer,
+ * where the extra threads only add their overhead.
+ * */
+#include "ReplayArchive.h"
+#include <ArduinoJson.h>
+#include <WeatherDecision.h>
+#include <WeatherReport.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+unsigned long millis() {
+  return 0; // INFO: only now() uses it, and the replay takes the time from the answers
+}
+
+struct Options {
+  unsigned threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+  size_t chunk = 256;
+  bool bench = false;
+  unsigned repeat = 5;
+  std::string archive;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path.c_str(), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "-j" && hasValue) {
+      options.threads = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--chunk" && hasValue) {
+      options.chunk = strtoul(argv[++i], NULL, 10);
+    } else if (arg == "--bench") {
+      options.bench = true;
+    } else if (arg == "--repeat" && hasValue) {
+      options.repeat = strtoul(argv[++i], NULL, 10);
+    } else if (arg.compare(0, 1, "-") == 0 || !options.archive.empty()) {
+      return false;
+    } else {
+      options.archive = arg;
+    }
+  }
+  return !options.archive.empty() && options.threads > 0 && options.chunk > 0 && options.repeat > 0;
+}
+
+/**
+ * Prints one CSV row per answer; the answers that fail to parse go to stderr, like the firmware's "Parsing Error".
+ * */
+int replay(const std::vector<Line>& lines, const Options& options, const FlashDocument& config) {
+  std::vector<Parsed> results;
+  size_t pumpOn = 0;
+  size_t failed = 0;
+  printf("line,dt,month,hour,wind,goodTime,goodWind,goodWeather,pump\n");
+  parseLines(lines, results, options.threads, options.chunk, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      const Parsed& parsed = results[i];
+      if (parsed.error) {
+        fprintf(stderr, "%s:%u: %s\n", options.archive.c_str(), unsigned(lines[i].number), parsed.error.c_str());
+        failed++;
+        continue;
+      }
+      WeatherDecision decision = weatherDecide(parsed.report, config); // INFO: on this thread only, TimeLib isn't thread-safe
+      if (decision.pumpOn()) {
+        pumpOn++;
+      }
+      printf("%u,%lu,%d,%d,%g,%d,%d,%d,%s\n", unsigned(lines[i].number), parsed.report.dt, decision.month, decision.hour,
+             parsed.report.wind.speed, decision.goodTime, decision.goodWind, decision.goodWeather, decision.pumpOn() ? "on" : "off");
+    }
+  });
+  fprintf(stderr, "%u answers, %u failed, pump on for %u\n", unsigned(lines.size()), unsigned(failed), unsigned(pumpOn));
+  return failed ? 1 : 0;
+}
+
+bool sameResult(const Parsed& a, const Parsed& b) {
+  if (a.error != b.error || a.report.dt != b.report.dt || a.report.wind.speed != b.report.wind.speed ||
+      a.report.weatherCount != b.report.weatherCount) {
+    return false;
+  }
+  for (uint8_t index = 0; index < a.report.storedWeatherCount(); index++) {
+    if (a.report.weather[index].id != b.report.weather[index].id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Times the parsing alone, as the decisions are sequential anyway; the best of --repeat runs counts.
+ * */
+int bench(const std::vector<Line>& lines, const Options& options, size_t bytes) {
+  static const unsigned threadCounts[] = {1, 2, 4, 8, 16};
+  std::vector<Parsed> reference;
+  double baseline = 0;
+  printf("%u answers, %u bytes, %u hardware threads, chunks of %u lines\n\n", unsigned(lines.size()), unsigned(bytes),
+         std::thread::hardware_concurrency(), unsigned(options.chunk));
+  printf("%7s %10s %12s %8s\n", "threads", "ms", "answers/s", "speedup");
+  for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+    double best = 0;
+    std::vector<Parsed> results;
+    for (unsigned r = 0; r < options.repeat; r++) {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      parseLines(lines, results, threadCounts[t], options.chunk, [](size_t, size_t) {});
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (r == 0 || seconds < best) {
+        best = seconds;
+      }
+    }
+    if (t == 0) {
+      reference.swap(results);
+      baseline = best;
+    } else {
+      for (size_t i = 0; i < lines.size(); i++) {
+        if (!sameResult(results[i], reference[i])) { // INFO: a mismatch means the threads share state they shouldn't
+          fprintf(stderr, "%s:%u: differs with %u threads\n", options.archive.c_str(), unsigned(lines[i].number), threadCounts[t]);
+          return 1;
+        }
+      }
+    }
+    printf("%7u %10.2f %12.0f %7.2fx\n", threadCounts[t], best * 1000, lines.size() / best, baseline / best);
+  }
+  if (std::thread::hardware_concurrency() < 2) {
+    printf("\nonly one hardware thread: the speedups measure the overhead of the threads, not their scaling\n");
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [-j THREADS] [--chunk LINES] [--bench [--repeat N]] ARCHIVE\n", argv[0]);
+    return 2;
+  }
+
+  WeatherConfig config;
+  DeserializationError error = deserializeJson(config, weatherConfigJson);
+  if (error) {
+    fprintf(stderr, "configuration: %s\n", error.c_str());
+    return 1;
+  }
+
+  std::string content;
+  if (!readFile(options.archive, content)) {
+    fprintf(stderr, "%s: can't read the file\n", options.archive.c_str());
+    return 1;
+  }
+  std::vector<Line> lines = splitLines(content);
+  if (options.bench) {
+    return bench(lines, options, content.size());
+  }
+  return replay(lines, options, config);
+}